@@ -1,15 +1,17 @@
 #include "ai_engine.h"
-#include "../src/uci.h"
-#include "../src/bitboard.h"
-#include "../src/position.h"
-#include "../src/tune.h"
+#include "ai_native.h"
 #include <thread>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
-#include <iostream>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <atomic>
+#include <map>
 #include <glib.h>
 
 #ifdef _WIN32
@@ -21,8 +23,6 @@
 
 static bool debug_mode = false;
 
-using namespace Stockfish;
-
 static void log_ram_usage(const char* context) {
 #ifdef _WIN32
     PROCESS_MEMORY_COUNTERS_EX pmc;
@@ -45,9 +45,18 @@ struct EngineHandle {
     std::queue<std::string> output_queue;
     std::mutex output_mutex;
     std::condition_variable output_cv;
+
+    // Push delivery: a line callback replaces the queue; a main-context
+    // watch is woken when lines are queued
+    std::mutex callback_mutex; // Held while the line callback runs
+    AiEngineLineCallback line_cb = nullptr;
+    void* line_cb_data = nullptr;
+    GSource* watch = nullptr;
     
-    // Internal specific
+    // Internal specific: each handle owns its engine (threads, TT), so any
+    // number can run side by side
     std::thread internal_thread;
+    AiNativeEngine* native = nullptr;
     
     // External specific
     GPid pid;
@@ -56,87 +65,234 @@ struct EngineHandle {
     GIOChannel* out_channel;
     std::thread reader_thread;
     
-    // NEW: Cached settings to avoid redundant UCI commands
-    int last_skill_level = -1;
+    // Every option sent through ai_engine_set_option, by lower-case name, so
+    // only changes go to the engine. Used from one caller thread at a time.
+    std::map<std::string, std::string> options;
+    bool options_pending = false; // Sent since the last readyok
+
+    // Last command from ai_engine_set_position; cleared when anything else
+    // sets the position
+    std::string position;
     bool uci_initialized = false;
 };
 
-// Internal streambufs
-class EngineInputBuf : public std::streambuf {
-public:
-    EngineInputBuf(EngineHandle* h) : handle(h) {}
-protected:
-    int underflow() override {
-        std::unique_lock<std::mutex> lock(handle->input_mutex);
-        handle->input_cv.wait(lock, [this] { return !handle->input_queue.empty() || !handle->running; });
-
-        if (!handle->running && handle->input_queue.empty()) {
-            return traits_type::eof();
-        }
-
-        current_line = handle->input_queue.front() + "\n";
-        handle->input_queue.pop();
-        
-        setg(&current_line[0], &current_line[0], &current_line[0] + current_line.size());
-        return traits_type::to_int_type(*gptr());
-    }
-private:
+// Pool entry: one warm engine per (engine path, slot)
+struct EnginePoolEntry {
+    std::string path; // "" for the internal engine
+    int slot;
     EngineHandle* handle;
-    std::string current_line;
 };
 
-class EngineOutputBuf : public std::streambuf {
-public:
-    EngineOutputBuf(EngineHandle* h) : handle(h) {}
-protected:
-    int overflow(int c) override {
-        if (c == traits_type::eof()) return traits_type::not_eof(c);
-
-        if (c == '\n') {
-            std::lock_guard<std::mutex> lock(handle->output_mutex);
-            handle->output_queue.push(current_line);
-            current_line.clear();
-            handle->output_cv.notify_all();
-        } else {
-            std::lock_guard<std::mutex> lock(buf_mutex);
-            current_line += (char)c;
+struct EnginePool {
+    std::mutex mutex;
+    std::vector<EnginePoolEntry> entries;
+};
+
+static void push_output(EngineHandle* handle, std::string line) {
+    {
+        std::lock_guard<std::mutex> cb_lock(handle->callback_mutex);
+        if (handle->line_cb) {
+            handle->line_cb(line.c_str(), handle->line_cb_data);
+            return;
         }
-        return c;
     }
-private:
+
+    GMainContext* wake = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(handle->output_mutex);
+        handle->output_queue.push(std::move(line));
+        if (handle->watch) wake = g_main_context_ref(g_source_get_context(handle->watch));
+    }
+    handle->output_cv.notify_all();
+    if (wake) {
+        g_main_context_wakeup(wake);
+        g_main_context_unref(wake);
+    }
+}
+
+// Pops the next line, waiting up to timeout_ms (negative: until the handle
+// shuts down). Returns false on timeout.
+static bool pop_output(EngineHandle* handle, int timeout_ms, std::string* out) {
+    std::unique_lock<std::mutex> lock(handle->output_mutex);
+    auto ready = [handle] { return !handle->output_queue.empty() || !handle->running; };
+    if (timeout_ms < 0) {
+        handle->output_cv.wait(lock, ready);
+    } else if (timeout_ms > 0) {
+        handle->output_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+    }
+    if (handle->output_queue.empty()) return false;
+    *out = std::move(handle->output_queue.front());
+    handle->output_queue.pop();
+    return true;
+}
+
+static char* dup_line(const std::string& line) {
+    #ifdef _WIN32
+    return _strdup(line.c_str());
+    #else
+    return strdup(line.c_str());
+    #endif
+}
+
+// GSource that hands queued lines to a callback on its main context
+typedef struct {
+    GSource source;
     EngineHandle* handle;
-    std::string current_line;
-    std::mutex buf_mutex;
-};
+} EngineWatchSource;
 
-static void internal_engine_main(EngineHandle* handle) {
-    // Initialize Stockfish internals (once per process, but safe to call multiple times if we guarded)
-    static std::once_flag sf_init_flag;
-    std::call_once(sf_init_flag, [](){
-        Bitboards::init();
-        Position::init();
-    });
+static gboolean watch_ready(GSource* source) {
+    EngineHandle* handle = ((EngineWatchSource*)source)->handle;
+    std::lock_guard<std::mutex> lock(handle->output_mutex);
+    return !handle->output_queue.empty();
+}
+
+static gboolean watch_prepare(GSource* source, gint* timeout) {
+    *timeout = -1; // Woken by push_output, never by a timer
+    return watch_ready(source);
+}
+
+static gboolean watch_check(GSource* source) {
+    return watch_ready(source);
+}
 
+static gboolean watch_dispatch(GSource* source, GSourceFunc callback, gpointer user_data) {
+    EngineHandle* handle = ((EngineWatchSource*)source)->handle;
+    AiEngineLineCallback cb = (AiEngineLineCallback)(void*)callback;
+    std::string line;
+    while (pop_output(handle, 0, &line)) {
+        if (cb) cb(line.c_str(), user_data);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs watch_funcs = {watch_prepare, watch_check, watch_dispatch, nullptr, nullptr, nullptr};
+
+// Engine callbacks: same text UCIEngine writes to stdout, queued per handle
+static void internal_on_info(const AiSearchInfo* info, void* user_data) {
+    EngineHandle* handle = (EngineHandle*)user_data;
+    char buf[256];
+
+    // No moves at the root: UCIEngine prints only depth and score
+    if (info->pv[0] == '\0') {
+        snprintf(buf, sizeof(buf), "info depth %d score %s %d", info->depth, info->is_mate ? "mate" : "cp", info->score);
+        push_output(handle, buf);
+        return;
+    }
+
+    int n = snprintf(buf, sizeof(buf), "info depth %d seldepth %d multipv %d score %s %d",
+                     info->depth, info->sel_depth, info->multipv, info->is_mate ? "mate" : "cp", info->score);
+    if (info->has_wdl && n > 0 && (size_t)n < sizeof(buf)) {
+        n += snprintf(buf + n, sizeof(buf) - n, " wdl %d %d %d", info->wdl[0], info->wdl[1], info->wdl[2]);
+    }
+    if (info->bound != AI_BOUND_EXACT && n > 0 && (size_t)n < sizeof(buf)) {
+        n += snprintf(buf + n, sizeof(buf) - n, " %s", info->bound == AI_BOUND_LOWER ? "lowerbound" : "upperbound");
+    }
+    if (n > 0 && (size_t)n < sizeof(buf)) {
+        snprintf(buf + n, sizeof(buf) - n, " nodes %llu nps %llu hashfull %d tbhits %llu time %lld pv",
+                 (unsigned long long)info->nodes, (unsigned long long)info->nps, info->hashfull,
+                 (unsigned long long)info->tb_hits, (long long)info->time_ms);
+    }
+    push_output(handle, std::string(buf) + " " + info->pv);
+}
+
+static void internal_on_bestmove(const char* bestmove, const char* ponder, void* user_data) {
+    EngineHandle* handle = (EngineHandle*)user_data;
+    std::string line = std::string("bestmove ") + bestmove;
+    if (ponder[0]) line += std::string(" ponder ") + ponder;
+    push_output(handle, line);
+}
+
+// position [startpos | fen <fen>] [moves <m1> ...]
+static void internal_position(EngineHandle* handle, std::istringstream& is) {
+    std::string token, fen;
+    is >> token;
+    if (token == "fen") {
+        while (is >> token && token != "moves") fen += (fen.empty() ? "" : " ") + token;
+    } else if (token == "startpos") {
+        is >> token; // "moves"
+    } else {
+        return;
+    }
+
+    std::vector<std::string> moves;
+    while (is >> token) moves.push_back(token);
+    std::vector<const char*> ptrs;
+    ptrs.reserve(moves.size());
+    for (const std::string& m : moves) ptrs.push_back(m.c_str());
+
+    ai_native_set_position(handle->native, fen.empty() ? nullptr : fen.c_str(),
+                           ptrs.data(), (int)ptrs.size());
+}
+
+static void internal_go(EngineHandle* handle, std::istringstream& is) {
+    AiSearchLimits limits;
+    memset(&limits, 0, sizeof(limits));
+    std::string token;
+    while (is >> token) {
+        if (token == "wtime") is >> limits.wtime_ms;
+        else if (token == "btime") is >> limits.btime_ms;
+        else if (token == "winc") is >> limits.winc_ms;
+        else if (token == "binc") is >> limits.binc_ms;
+        else if (token == "movestogo") is >> limits.moves_to_go;
+        else if (token == "depth") is >> limits.depth;
+        else if (token == "nodes") is >> limits.nodes;
+        else if (token == "movetime") is >> limits.move_time_ms;
+        else if (token == "mate") is >> limits.mate;
+        else if (token == "infinite") limits.infinite = true;
+    }
+    ai_native_go(handle->native, &limits);
+}
+
+// setoption name <name> value <value> (both may contain spaces)
+static void internal_setoption(EngineHandle* handle, std::istringstream& is) {
+    std::string token, name, value;
+    is >> token; // "name"
+    while (is >> token && token != "value") name += (name.empty() ? "" : " ") + token;
+    while (is >> token) value += (value.empty() ? "" : " ") + token;
+
+    if (!ai_native_set_option(handle->native, name.c_str(), value.c_str())) {
+        push_output(handle, "No such option: " + name);
+    }
+}
+
+// Runs the UCI commands queued for this handle against its own engine.
+// Nothing here touches std::cin/std::cout.
+static void internal_engine_main(EngineHandle* handle) {
     if (debug_mode) fprintf(stderr, "[AI Engine Internal] Starting internal engine loop...\n");
 
-    EngineInputBuf input_buf(handle);
-    EngineOutputBuf output_buf(handle);
-    
-    // Redirect cin and cout (thread-local redirection would be better, but SF uses global cin/cout)
-    // Note: This bridge assumes only one internal engine is active at a time, or that SF doesn't mind sharing.
-    // Actually, SF UCI loop is quite self-contained if we redirect these.
-    std::streambuf* old_cin = std::cin.rdbuf(&input_buf);
-    std::streambuf* old_cout = std::cout.rdbuf(&output_buf);
+    handle->native = ai_native_create();
+    ai_native_set_callbacks(handle->native, internal_on_info, internal_on_bestmove, handle);
+
+    while (true) {
+        std::string line;
+        {
+            std::unique_lock<std::mutex> lock(handle->input_mutex);
+            handle->input_cv.wait(lock, [handle] { return !handle->input_queue.empty() || !handle->running; });
+            if (handle->input_queue.empty()) break;
+            line = std::move(handle->input_queue.front());
+            handle->input_queue.pop();
+        }
 
-    {
-        char* argv[] = {(char*)"stockfish", nullptr};
-        UCIEngine uci(1, argv);
-        Tune::init(uci.engine_options());
-        uci.loop();
+        std::istringstream is(line);
+        std::string cmd;
+        is >> cmd;
+        if (cmd == "quit") break;
+        else if (cmd == "stop") ai_native_stop(handle->native);
+        else if (cmd == "uci") {
+            push_output(handle, "id name Stockfish");
+            push_output(handle, "id author the Stockfish developers (see AUTHORS file)");
+            push_output(handle, "uciok");
+        }
+        else if (cmd == "isready") push_output(handle, "readyok");
+        else if (cmd == "setoption") internal_setoption(handle, is);
+        else if (cmd == "ucinewgame") ai_native_new_game(handle->native);
+        else if (cmd == "position") internal_position(handle, is);
+        else if (cmd == "go") internal_go(handle, is);
+        else if (!cmd.empty() && debug_mode) fprintf(stderr, "[AI Engine Internal] Ignored: %s\n", line.c_str());
     }
 
-    std::cin.rdbuf(old_cin);
-    std::cout.rdbuf(old_cout);
+    ai_native_free(handle->native);
+    handle->native = nullptr;
 }
 
 // External reader thread
@@ -152,10 +308,8 @@ static void external_reader_thread(EngineHandle* handle) {
         if (status == G_IO_STATUS_NORMAL && bytes_read > 0) {
             for (gsize i = 0; i < bytes_read; i++) {
                 if (buffer[i] == '\n') {
-                    std::lock_guard<std::mutex> lock(handle->output_mutex);
-                    handle->output_queue.push(current_line);
+                    push_output(handle, current_line);
                     current_line.clear();
-                    handle->output_cv.notify_all();
                 } else if (buffer[i] != '\r') {
                     current_line += buffer[i];
                 }
@@ -222,9 +376,15 @@ void ai_engine_cleanup(EngineHandle* handle) {
 
     if (debug_mode) fprintf(stderr, "[AI Engine] cleanup called (Internal=%d)\n", handle->is_internal);
 
+    ai_engine_remove_watch(handle);
     ai_engine_send_command(handle, "quit");
     handle->running = false;
     handle->input_cv.notify_all();
+    {
+        // Wake blocked receivers; they see running == false
+        std::lock_guard<std::mutex> lock(handle->output_mutex);
+        handle->output_cv.notify_all();
+    }
 
     if (handle->is_internal) {
         if (handle->internal_thread.joinable()) {
@@ -256,6 +416,10 @@ void ai_engine_send_command(EngineHandle* handle, const char* command) {
 
     if (debug_mode) printf("[AI Engine] Sending command: %s\n", command);
 
+    if (strncmp(command, "position", 8) == 0 || strncmp(command, "ucinewgame", 10) == 0) {
+        handle->position.clear();
+    }
+
     if (handle->is_internal) {
         std::lock_guard<std::mutex> lock(handle->input_mutex);
         handle->input_queue.push(std::string(command));
@@ -270,18 +434,74 @@ void ai_engine_send_command(EngineHandle* handle, const char* command) {
     }
 }
 
+void ai_engine_set_position(EngineHandle* handle, const char* root_fen, const char* moves_uci) {
+    if (!handle) return;
+
+    // UCI has no "moves since last time": the whole line goes out. A long
+    // game easily passes any fixed buffer, so this one grows.
+    std::string cmd = root_fen ? std::string("position fen ") + root_fen : std::string("position startpos");
+    if (moves_uci && moves_uci[0]) cmd += std::string(" moves ") + moves_uci;
+
+    if (cmd == handle->position) return;
+
+    if (debug_mode && !handle->position.empty() && cmd.compare(0, handle->position.size(), handle->position) == 0) {
+        printf("[AI Engine] Position extends the last one by: %s\n", cmd.c_str() + handle->position.size());
+    }
+
+    ai_engine_send_command(handle, cmd.c_str());
+    handle->position = std::move(cmd);
+}
+
 char* ai_engine_try_get_response(EngineHandle* handle) {
     if (!handle) return nullptr;
-    
-    std::lock_guard<std::mutex> lock(handle->output_mutex);
-    if (handle->output_queue.empty()) return nullptr;
+    std::string line;
+    return pop_output(handle, 0, &line) ? dup_line(line) : nullptr;
+}
 
-    std::string res = handle->output_queue.front();
-    handle->output_queue.pop();
-    
-    #ifdef _WIN32
-    return _strdup(res.c_str());
-    #endif
+char* ai_engine_get_response_timeout(EngineHandle* handle, int timeout_ms) {
+    if (!handle) return nullptr;
+    std::string line;
+    return pop_output(handle, timeout_ms, &line) ? dup_line(line) : nullptr;
+}
+
+void ai_engine_set_line_callback(EngineHandle* handle, AiEngineLineCallback callback, void* user_data) {
+    if (!handle) return;
+    std::lock_guard<std::mutex> cb_lock(handle->callback_mutex);
+    handle->line_cb = callback;
+    handle->line_cb_data = user_data;
+}
+
+unsigned int ai_engine_add_watch(EngineHandle* handle, GMainContext* context,
+                                 AiEngineLineCallback callback, void* user_data) {
+    if (!handle || !callback) return 0;
+    ai_engine_remove_watch(handle);
+
+    GSource* source = g_source_new(&watch_funcs, sizeof(EngineWatchSource));
+    ((EngineWatchSource*)source)->handle = handle;
+    g_source_set_callback(source, (GSourceFunc)(void*)callback, user_data, nullptr);
+    g_source_set_name(source, "ai-engine-output");
+    guint id = g_source_attach(source, context);
+    {
+        std::lock_guard<std::mutex> lock(handle->output_mutex);
+        handle->watch = source;
+    }
+    // Lines queued before the watch existed
+    g_main_context_wakeup(g_source_get_context(source));
+    return id;
+}
+
+void ai_engine_remove_watch(EngineHandle* handle) {
+    if (!handle) return;
+    GSource* source;
+    {
+        std::lock_guard<std::mutex> lock(handle->output_mutex);
+        source = handle->watch;
+        handle->watch = nullptr;
+    }
+    if (source) {
+        g_source_destroy(source);
+        g_source_unref(source);
+    }
 }
 
 void ai_engine_free_response(char* response) {
@@ -291,22 +511,24 @@ void ai_engine_free_response(char* response) {
 char* ai_engine_wait_for_bestmove(EngineHandle* handle) {
     if (!handle) return nullptr;
     
-    while (handle->running) {
-        char* line = ai_engine_try_get_response(handle);
-        if (line) {
-            if (strncmp(line, "bestmove", 8) == 0) {
-                return line;
-            }
-            ai_engine_free_response(line);
-            continue; // Optimization: Don't sleep if we have data (drain queue fast)
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::string line;
+    while (pop_output(handle, -1, &line)) {
+        if (line.compare(0, 8, "bestmove") == 0) return dup_line(line);
     }
     return nullptr;
 }
 
 void ai_engine_set_option(EngineHandle* handle, const char* name, const char* value) {
     if (!handle || !name || !value) return;
+
+    // UCI option names are case-insensitive
+    std::string key(name);
+    for (char& c : key) c = (char)tolower((unsigned char)c);
+    auto it = handle->options.find(key);
+    if (it != handle->options.end() && it->second == value) return;
+    handle->options[key] = value;
+    handle->options_pending = true;
+
     char cmd[512];
     snprintf(cmd, sizeof(cmd), "setoption name %s value %s", name, value);
     ai_engine_send_command(handle, cmd);
@@ -321,19 +543,7 @@ bool ai_engine_test_binary(const char* binary_path) {
     ai_engine_send_command(h, "uci");
     
     // Wait for uciok with timeout
-    bool success = false;
-    for (int i = 0; i < 200; i++) { // 2 seconds timeout
-        char* res = ai_engine_try_get_response(h);
-        if (res) {
-            if (strncmp(res, "uciok", 5) == 0) {
-                success = true;
-                ai_engine_free_response(res);
-                break;
-            }
-            ai_engine_free_response(res);
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
+    bool success = ai_engine_wait_for_token(h, "uciok", 2000);
 
     ai_engine_cleanup(h);
     return success;
@@ -363,18 +573,15 @@ int ai_engine_elo_to_skill(int elo) {
 bool ai_engine_wait_for_token(EngineHandle* handle, const char* token, int timeout_ms) {
     if (!handle || !token) return false;
     
-    int elapsed = 0;
-    while (elapsed < timeout_ms) {
-        char* line = ai_engine_try_get_response(handle);
-        if (line) {
-            bool match = (strncmp(line, token, strlen(token)) == 0);
-            ai_engine_free_response(line);
-            if (match) return true;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        elapsed += 10;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    size_t len = strlen(token);
+    std::string line;
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) return false;
+        if (!pop_output(handle, (int)left.count(), &line)) return false;
+        if (line.compare(0, len, token) == 0) return true;
     }
-    return false;
 }
 
 AiDifficultyParams ai_get_difficulty_params(int elo) {
@@ -414,27 +621,31 @@ void ai_engine_ensure_uci(EngineHandle* handle) {
     }
 }
 
+bool ai_engine_sync_options(EngineHandle* handle, int timeout_ms) {
+    if (!handle) return false;
+    if (!handle->options_pending) return true;
+
+    // Options that load files or resize the hash finish before readyok
+    ai_engine_send_command(handle, "isready");
+    bool ok = ai_engine_wait_for_token(handle, "readyok", timeout_ms);
+    handle->options_pending = false;
+    return ok;
+}
+
 void ai_engine_set_skill_level(EngineHandle* handle, int skill) {
     if (!handle) return;
     
     // Clamp skill level
     skill = (skill < 0) ? 0 : (skill > 20) ? 20 : skill;
     
-    // Skip if already set to this level
-    if (handle->last_skill_level == skill) return;
-    
     char skill_str[16];
     snprintf(skill_str, sizeof(skill_str), "%d", skill);
     
-    if (debug_mode) fprintf(stderr, "[AI Engine] Setting Skill Level to %s (was %d)\n", skill_str, handle->last_skill_level);
+    if (debug_mode) fprintf(stderr, "[AI Engine] Setting Skill Level to %s\n", skill_str);
     
+    // Only sent (and waited for) when it changed
     ai_engine_set_option(handle, "Skill Level", skill_str);
-    
-    // We should send isready/readyok to ensure the engine processes the option
-    ai_engine_send_command(handle, "isready");
-    ai_engine_wait_for_token(handle, "readyok", 1000);
-    
-    handle->last_skill_level = skill;
+    ai_engine_sync_options(handle, 1000);
 }
 
 void ai_engine_set_elo(EngineHandle* handle, int elo) {
@@ -454,12 +665,43 @@ void ai_engine_set_elo(EngineHandle* handle, int elo) {
 
     // Fallback method (Skill Level)
     // We map ELO to Skill Level just in case the engine doesn't support UCI_Elo
-    int skill = ai_engine_elo_to_skill(elo);
-    ai_engine_set_skill_level(handle, skill);
+    char skill_str[16];
+    snprintf(skill_str, sizeof(skill_str), "%d", ai_engine_elo_to_skill(elo));
+    ai_engine_set_option(handle, "Skill Level", skill_str);
 
-    // Ensure options are processed
-    ai_engine_send_command(handle, "isready");
-    ai_engine_wait_for_token(handle, "readyok", 1000);
+    // Ensure options are processed (no round trip if nothing changed)
+    ai_engine_sync_options(handle, 1000);
+}
+
+EnginePool* ai_engine_pool_new(void) {
+    return new EnginePool();
+}
+
+void ai_engine_pool_free(EnginePool* pool) {
+    if (!pool) return;
+    for (EnginePoolEntry& e : pool->entries) ai_engine_cleanup(e.handle);
+    delete pool;
+}
+
+EngineHandle* ai_engine_pool_get(EnginePool* pool, const char* binary_path, int slot) {
+    if (!pool) return nullptr;
+    std::string path = binary_path ? binary_path : "";
+
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    for (const EnginePoolEntry& e : pool->entries) {
+        if (e.slot == slot && e.path == path) return e.handle;
+    }
+
+    EngineHandle* handle = path.empty() ? ai_engine_init_internal() : ai_engine_init_external(path.c_str());
+    if (handle) pool->entries.push_back({path, slot, handle});
+    if (debug_mode) fprintf(stderr, "[AI Engine] Pool: new engine for slot %d (%s)\n", slot, path.empty() ? "internal" : path.c_str());
+    return handle;
+}
+
+void ai_engine_pool_stop_all(EnginePool* pool) {
+    if (!pool) return;
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    for (const EnginePoolEntry& e : pool->entries) ai_engine_send_command(e.handle, "stop");
 }
 
 } // extern "C"
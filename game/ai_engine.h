@@ -12,6 +12,16 @@ typedef struct {
 // Opaque handle for an engine instance
 typedef struct EngineHandle EngineHandle;
 
+// Set of engines kept running between moves and games
+typedef struct EnginePool EnginePool;
+
+// Same declaration as GLib's, so this header does not need glib.h
+typedef struct _GMainContext GMainContext;
+
+// Receives one engine output line (without the newline). The string is only
+// valid during the call.
+typedef void (*AiEngineLineCallback)(const char* line, void* user_data);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,17 +46,55 @@ void ai_engine_cleanup(EngineHandle* handle);
  */
 void ai_engine_send_command(EngineHandle* handle, const char* command);
 
+/**
+ * Sends "position startpos|fen <root_fen> moves <moves_uci>" for a game line:
+ * root_fen is the game's start (NULL for the standard start position) and
+ * moves_uci every move since, space separated (NULL or "" for none).
+ * Nothing is sent if the engine already has exactly that line. The internal
+ * engine only plays the moves added since the last call, and either engine
+ * sees the earlier positions for repetitions.
+ */
+void ai_engine_set_position(EngineHandle* handle, const char* root_fen, const char* moves_uci);
+
 /**
  * Non-blocking check for a response from the engine.
  * Returns a string that must be freed with ai_engine_free_response, or NULL.
  */
 char* ai_engine_try_get_response(EngineHandle* handle);
 
+/**
+ * Blocking wait for the next response, woken as soon as the engine writes a
+ * line. timeout_ms < 0 waits until a line arrives or the engine shuts down;
+ * 0 is the same as ai_engine_try_get_response.
+ * Returns a string to free with ai_engine_free_response, or NULL on timeout.
+ */
+char* ai_engine_get_response_timeout(EngineHandle* handle, int timeout_ms);
+
 /**
  * Frees a response string returned by ai_engine_try_get_response.
  */
 void ai_engine_free_response(char* response);
 
+/**
+ * Delivers every output line to callback on the engine's own thread instead
+ * of queueing it. NULL restores queueing. Once this returns no call to the
+ * previous callback is still running; do not call it from inside a callback.
+ */
+void ai_engine_set_line_callback(EngineHandle* handle, AiEngineLineCallback callback, void* user_data);
+
+/**
+ * Dispatches queued output lines to callback from context (NULL: the default
+ * main context), so GUI code can react without a polling timer or thread.
+ * One watch per handle; adding another replaces it. Returns the source id.
+ */
+unsigned int ai_engine_add_watch(EngineHandle* handle, GMainContext* context,
+                                 AiEngineLineCallback callback, void* user_data);
+
+/**
+ * Removes the watch added by ai_engine_add_watch, if any.
+ */
+void ai_engine_remove_watch(EngineHandle* handle);
+
 /**
  * Blocking wait for the 'bestmove' response after a 'go' command.
  */
@@ -59,10 +107,17 @@ char* ai_engine_wait_for_bestmove(EngineHandle* handle);
 bool ai_engine_test_binary(const char* binary_path);
 
 /**
- * Sends a 'setoption name <name> value <value>' command.
+ * Sends a 'setoption name <name> value <value>' command, unless the handle
+ * already has that value. Not thread-safe: one caller thread per handle.
  */
 void ai_engine_set_option(EngineHandle* handle, const char* name, const char* value);
 
+/**
+ * Waits for readyok if any option was sent since the last sync; returns at
+ * once otherwise. Returns false if the engine did not answer in time.
+ */
+bool ai_engine_sync_options(EngineHandle* handle, int timeout_ms);
+
 /**
  * Waits for a specific UCI response token (e.g., "readyok", "uciok").
  * Returns true if token received within timeout, false otherwise.
@@ -81,7 +136,7 @@ void ai_engine_ensure_uci(EngineHandle* handle);
 
 /**
  * Sets the Skill Level option (0-20).
- * Uses caching to avoid redundant UCI commands.
+ * Uses the option cache to avoid redundant UCI commands.
  */
 void ai_engine_set_skill_level(EngineHandle* handle, int skill);
 
@@ -96,6 +151,29 @@ AiDifficultyParams ai_get_difficulty_params(int elo);
  */
 void ai_engine_set_elo(EngineHandle* handle, int elo);
 
+/**
+ * Creates an empty engine pool.
+ */
+EnginePool* ai_engine_pool_new(void);
+
+/**
+ * Shuts down and frees every engine in the pool.
+ */
+void ai_engine_pool_free(EnginePool* pool);
+
+/**
+ * Returns the pool's engine for binary_path (NULL: the internal engine) and
+ * slot, starting it on first use. The engine stays up, with its TT and
+ * option cache, until the pool is freed, so later requests skip UCI setup.
+ * Use a different slot per player to give each side its own engine.
+ */
+EngineHandle* ai_engine_pool_get(EnginePool* pool, const char* binary_path, int slot);
+
+/**
+ * Sends 'stop' to every engine in the pool.
+ */
+void ai_engine_pool_stop_all(EnginePool* pool);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,203 @@
+#include "ai_native.h"
+#include "../src/bitboard.h"
+#include "../src/engine.h"
+#include "../src/misc.h"
+#include "../src/position.h"
+#include "../src/score.h"
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Stockfish;
+
+static const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+struct AiNativeEngine {
+    Engine engine;
+
+    // Read by the search thread; only changed while no search runs
+    AiInfoCallback on_info = nullptr;
+    AiBestmoveCallback on_bestmove = nullptr;
+    void* user_data = nullptr;
+
+    std::string pv; // NUL-terminated copy handed to on_info
+};
+
+// Same scale the UCI "score" field uses
+static void fill_score(const Score& s, AiSearchInfo* out) {
+    constexpr int TB_CP = 20000;
+    if (s.is<Score::Mate>()) {
+        int plies = s.get<Score::Mate>().plies;
+        out->is_mate = true;
+        out->score = (plies > 0 ? plies + 1 : plies) / 2;
+    } else if (s.is<Score::Tablebase>()) {
+        Score::Tablebase tb = s.get<Score::Tablebase>();
+        out->score = tb.win ? TB_CP - tb.plies : -TB_CP - tb.plies;
+    } else {
+        out->score = s.get<Score::InternalUnits>().value;
+    }
+}
+
+// "w d l" as written by the search
+static bool parse_wdl(std::string_view text, int wdl[3]) {
+    size_t i = 0;
+    for (int k = 0; k < 3; k++) {
+        while (i < text.size() && text[i] == ' ') i++;
+        if (i >= text.size() || text[i] < '0' || text[i] > '9') return false;
+        int v = 0;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9') v = v * 10 + (text[i++] - '0');
+        wdl[k] = v;
+    }
+    return true;
+}
+
+static void on_update_full(AiNativeEngine* h, const Engine::InfoFull& info) {
+    if (!h->on_info) return;
+
+    AiSearchInfo out;
+    memset(&out, 0, sizeof(out));
+    out.depth = info.depth;
+    out.sel_depth = info.selDepth;
+    out.multipv = (int)info.multiPV;
+    fill_score(info.score, &out);
+    out.bound = info.bound == "lowerbound" ? AI_BOUND_LOWER
+              : info.bound == "upperbound" ? AI_BOUND_UPPER
+                                           : AI_BOUND_EXACT;
+    out.has_wdl = parse_wdl(info.wdl, out.wdl);
+    out.nodes = info.nodes;
+    out.nps = info.nps;
+    out.tb_hits = info.tbHits;
+    out.time_ms = (int64_t)info.timeMs;
+    out.hashfull = info.hashfull;
+
+    h->pv.assign(info.pv.data(), info.pv.size());
+    out.pv = h->pv.c_str();
+    h->on_info(&out, h->user_data);
+}
+
+// Mate or stalemate at the root: only depth and score
+static void on_update_no_moves(AiNativeEngine* h, const Engine::InfoShort& info) {
+    if (!h->on_info) return;
+
+    AiSearchInfo out;
+    memset(&out, 0, sizeof(out));
+    out.depth = info.depth;
+    out.multipv = 1;
+    fill_score(info.score, &out);
+    out.pv = "";
+    h->on_info(&out, h->user_data);
+}
+
+static void on_bestmove(AiNativeEngine* h, std::string_view bestmove, std::string_view ponder) {
+    if (!h->on_bestmove) return;
+
+    // UCI moves are at most 5 characters; "(none)" is 6
+    char best[16], reply[16];
+    snprintf(best, sizeof(best), "%.*s", (int)bestmove.size(), bestmove.data());
+    snprintf(reply, sizeof(reply), "%.*s", (int)ponder.size(), ponder.data());
+    h->on_bestmove(best, reply, h->user_data);
+}
+
+extern "C" {
+
+void ai_native_init(void) {
+    static std::once_flag sf_init_flag;
+    std::call_once(sf_init_flag, []() {
+        Bitboards::init();
+        Position::init();
+    });
+}
+
+AiNativeEngine* ai_native_create(void) {
+    ai_native_init();
+
+    AiNativeEngine* h = new AiNativeEngine();
+    h->engine.set_on_update_full([h](const Engine::InfoFull& i) { on_update_full(h, i); });
+    h->engine.set_on_update_no_moves([h](const Engine::InfoShort& i) { on_update_no_moves(h, i); });
+    h->engine.set_on_iter([](const Engine::InfoIter&) {});
+    h->engine.set_on_bestmove([h](std::string_view bm, std::string_view p) { on_bestmove(h, bm, p); });
+    h->engine.set_on_verify_networks([](std::string_view) {});
+    return h;
+}
+
+void ai_native_free(AiNativeEngine* engine) {
+    if (!engine) return;
+    engine->engine.stop();
+    engine->engine.wait_for_search_finished();
+    delete engine;
+}
+
+void ai_native_set_callbacks(AiNativeEngine* engine, AiInfoCallback on_info,
+                             AiBestmoveCallback on_bestmove, void* user_data) {
+    if (!engine) return;
+    engine->engine.wait_for_search_finished();
+    engine->on_info = on_info;
+    engine->on_bestmove = on_bestmove;
+    engine->user_data = user_data;
+}
+
+bool ai_native_set_option(AiNativeEngine* engine, const char* name, const char* value) {
+    if (!engine || !name || !value) return false;
+
+    OptionsMap& options = engine->engine.get_options();
+    if (!options.count(name)) return false;
+
+    // Option handlers resize the hash or thread pool; never under a search
+    engine->engine.wait_for_search_finished();
+    std::istringstream is(std::string("name ") + name + " value " + value);
+    options.setoption(is);
+    return true;
+}
+
+void ai_native_set_position(AiNativeEngine* engine, const char* fen,
+                            const char* const* moves, int move_count) {
+    if (!engine) return;
+
+    std::vector<std::string> list;
+    if (moves && move_count > 0) {
+        list.reserve((size_t)move_count);
+        for (int i = 0; i < move_count; i++) {
+            if (moves[i]) list.emplace_back(moves[i]);
+        }
+    }
+
+    engine->engine.wait_for_search_finished();
+    engine->engine.set_position(fen ? fen : START_FEN, list);
+}
+
+void ai_native_go(AiNativeEngine* engine, const AiSearchLimits* limits) {
+    if (!engine) return;
+
+    Search::LimitsType sl;
+    sl.startTime = now();
+    if (limits) {
+        sl.depth = limits->depth;
+        sl.movetime = limits->move_time_ms;
+        sl.time[WHITE] = limits->wtime_ms;
+        sl.time[BLACK] = limits->btime_ms;
+        sl.inc[WHITE] = limits->winc_ms;
+        sl.inc[BLACK] = limits->binc_ms;
+        sl.movestogo = limits->moves_to_go;
+        sl.nodes = limits->nodes;
+        sl.mate = limits->mate;
+        sl.infinite = limits->infinite ? 1 : 0;
+    }
+    engine->engine.go(sl);
+}
+
+void ai_native_stop(AiNativeEngine* engine) {
+    if (engine) engine->engine.stop();
+}
+
+void ai_native_wait(AiNativeEngine* engine) {
+    if (engine) engine->engine.wait_for_search_finished();
+}
+
+void ai_native_new_game(AiNativeEngine* engine) {
+    if (engine) engine->engine.search_clear();
+}
+
+} // extern "C"
@@ -0,0 +1,125 @@
+#ifndef AI_NATIVE_H
+#define AI_NATIVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Direct in-process access to the bundled Stockfish. Unlike the internal
+// EngineHandle in ai_engine.h there is no UCI text in between: positions go
+// in as a FEN plus a move list, search limits as a struct, and results come
+// back through callbacks with the fields already split out.
+
+// Opaque handle for one Stockfish::Engine
+typedef struct AiNativeEngine AiNativeEngine;
+
+typedef enum {
+    AI_BOUND_EXACT = 0,
+    AI_BOUND_LOWER,
+    AI_BOUND_UPPER
+} AiScoreBound;
+
+// One line of search output (UCI "info ... pv ...")
+typedef struct {
+    int depth;
+    int sel_depth;
+    int multipv;           // 1-based line number
+    bool is_mate;
+    int score;             // Centipawns, or moves to mate (negative: getting mated)
+    AiScoreBound bound;
+    bool has_wdl;          // Only when UCI_ShowWDL is on
+    int wdl[3];            // Win/draw/loss, per mille
+    uint64_t nodes;
+    uint64_t nps;
+    uint64_t tb_hits;
+    int64_t time_ms;
+    int hashfull;          // Per mille
+    const char* pv;        // UCI moves, space separated; "" for a root with no moves
+} AiSearchInfo;
+
+// Search limits; zero fields are unset. With nothing set the search runs to
+// full depth (same as a bare "go").
+typedef struct {
+    int depth;
+    int move_time_ms;
+    int64_t wtime_ms;
+    int64_t btime_ms;
+    int64_t winc_ms;
+    int64_t binc_ms;
+    int moves_to_go;
+    uint64_t nodes;
+    int mate;
+    bool infinite;
+} AiSearchLimits;
+
+// Callbacks run on the engine's search thread. Pointers are only valid for
+// the duration of the call.
+typedef void (*AiInfoCallback)(const AiSearchInfo* info, void* user_data);
+// bestmove is "(none)" when the root has no legal move; ponder may be "".
+typedef void (*AiBestmoveCallback)(const char* bestmove, const char* ponder, void* user_data);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initializes Stockfish's static tables. Safe to call repeatedly and from
+ * several threads; ai_native_create() calls it.
+ */
+void ai_native_init(void);
+
+/**
+ * Creates an engine with default options and the embedded network.
+ */
+AiNativeEngine* ai_native_create(void);
+
+/**
+ * Stops any running search and frees the engine.
+ */
+void ai_native_free(AiNativeEngine* engine);
+
+/**
+ * Sets the callbacks used by later searches. Must not be called while a
+ * search is running.
+ */
+void ai_native_set_callbacks(AiNativeEngine* engine, AiInfoCallback on_info,
+                             AiBestmoveCallback on_bestmove, void* user_data);
+
+/**
+ * Sets a UCI option by name. Returns false if the engine has no such option.
+ * Waits for a running search to finish first.
+ */
+bool ai_native_set_option(AiNativeEngine* engine, const char* name, const char* value);
+
+/**
+ * Sets the position to search: fen (NULL for the start position) followed
+ * by move_count UCI moves. Moves after the first illegal one are ignored.
+ */
+void ai_native_set_position(AiNativeEngine* engine, const char* fen,
+                            const char* const* moves, int move_count);
+
+/**
+ * Starts searching the current position. Non-blocking; the bestmove
+ * callback fires once when the search ends.
+ */
+void ai_native_go(AiNativeEngine* engine, const AiSearchLimits* limits);
+
+/**
+ * Asks a running search to stop. Non-blocking.
+ */
+void ai_native_stop(AiNativeEngine* engine);
+
+/**
+ * Blocks until the current search (if any) has finished.
+ */
+void ai_native_wait(AiNativeEngine* engine);
+
+/**
+ * Clears the hash table and search history ("ucinewgame").
+ */
+void ai_native_new_game(AiNativeEngine* engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AI_NATIVE_H
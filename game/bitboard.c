@@ -0,0 +1,84 @@
+#include "bitboard.h"
+#include <stdbool.h>
+
+Bitboard bb_knight_attacks[64];
+Bitboard bb_king_attacks[64];
+Bitboard bb_pawn_attacks[2][64];
+Bitboard bb_rays[DIR_COUNT][64];
+Bitboard bb_between[64][64];
+
+static int initialized = 0;
+
+static const int ray_steps[DIR_COUNT][2] = {
+    {-1, 0},  // DIR_N
+    {1, 0},   // DIR_S
+    {0, 1},   // DIR_E
+    {0, -1},  // DIR_W
+    {-1, 1},  // DIR_NE
+    {-1, -1}, // DIR_NW
+    {1, 1},   // DIR_SE
+    {1, -1}   // DIR_SW
+};
+
+static bool is_valid_pos(int r, int c) {
+    return (r >= 0 && r < 8 && c >= 0 && c < 8);
+}
+
+// Build a mask from a list of (dr, dc) offsets applied once
+static Bitboard step_mask(int r, int c, const int offsets[][2], int count) {
+    Bitboard mask = BB_EMPTY;
+    for (int i = 0; i < count; i++) {
+        int nr = r + offsets[i][0];
+        int nc = c + offsets[i][1];
+        if (is_valid_pos(nr, nc)) mask |= BB_SQUARE(nr * 8 + nc);
+    }
+    return mask;
+}
+
+void bitboard_init(void) {
+    if (initialized) return;
+
+    const int knightOffsets[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+                                     {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+    const int kingOffsets[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
+                                   {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    // White pawns move towards row 0, Black pawns towards row 7
+    const int whitePawnOffsets[2][2] = {{-1, -1}, {-1, 1}};
+    const int blackPawnOffsets[2][2] = {{1, -1}, {1, 1}};
+
+    for (int sq = 0; sq < 64; sq++) {
+        int r = sq / 8;
+        int c = sq % 8;
+
+        bb_knight_attacks[sq] = step_mask(r, c, knightOffsets, 8);
+        bb_king_attacks[sq] = step_mask(r, c, kingOffsets, 8);
+        bb_pawn_attacks[PLAYER_WHITE][sq] = step_mask(r, c, whitePawnOffsets, 2);
+        bb_pawn_attacks[PLAYER_BLACK][sq] = step_mask(r, c, blackPawnOffsets, 2);
+
+        for (int d = 0; d < DIR_COUNT; d++) {
+            Bitboard ray = BB_EMPTY;
+            int nr = r + ray_steps[d][0];
+            int nc = c + ray_steps[d][1];
+            while (is_valid_pos(nr, nc)) {
+                ray |= BB_SQUARE(nr * 8 + nc);
+                nr += ray_steps[d][0];
+                nc += ray_steps[d][1];
+            }
+            bb_rays[d][sq] = ray;
+        }
+    }
+    
+    // Between masks: for b on a ray from a, the ray up to (not including) b
+    for (int a = 0; a < 64; a++) {
+        for (int d = 0; d < DIR_COUNT; d++) {
+            Bitboard ray = bb_rays[d][a];
+            Bitboard rest = ray;
+            while (rest) {
+                int b = bb_pop_lsb(&rest);
+                bb_between[a][b] = ray & ~bb_rays[d][b] & ~BB_SQUARE(b);
+            }
+        }
+    }
+
+    initialized = 1;
+}
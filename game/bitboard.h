@@ -0,0 +1,91 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+#include "types.h"
+
+// 64-bit square set. Bit i corresponds to square i using the same
+// encoding as Move.from_sq/to_sq: sq = row * 8 + col, row 0 = Rank 8.
+typedef uint64_t Bitboard;
+
+#define BB_EMPTY 0ULL
+#define BB_SQUARE(sq) (1ULL << (sq))
+
+// Row masks (row 0 = Rank 8, row 7 = Rank 1)
+#define BB_ROW_0 0x00000000000000FFULL
+#define BB_ROW_1 0x000000000000FF00ULL
+#define BB_ROW_3 0x00000000FF000000ULL
+#define BB_ROW_4 0x000000FF00000000ULL
+#define BB_ROW_6 0x00FF000000000000ULL
+#define BB_ROW_7 0xFF00000000000000ULL
+
+// Light squares (a8 and h1 are light)
+#define BB_LIGHT_SQUARES 0xAA55AA55AA55AA55ULL
+
+// Ray directions (index into bb_rays)
+typedef enum {
+    DIR_N = 0,   // row - 1
+    DIR_S,       // row + 1
+    DIR_E,       // col + 1
+    DIR_W,       // col - 1
+    DIR_NE,
+    DIR_NW,
+    DIR_SE,
+    DIR_SW,
+    DIR_COUNT
+} RayDirection;
+
+// Precomputed attack tables (filled by bitboard_init)
+extern Bitboard bb_knight_attacks[64];
+extern Bitboard bb_king_attacks[64];
+extern Bitboard bb_pawn_attacks[2][64];  // [Player][sq]: squares a pawn on sq attacks
+extern Bitboard bb_rays[DIR_COUNT][64];  // Empty-board ray from sq (exclusive)
+extern Bitboard bb_between[64][64];      // Squares strictly between a and b if aligned, else empty
+
+// Initialize attack tables (idempotent)
+void bitboard_init(void);
+
+static inline int bb_lsb(Bitboard b) {
+    return __builtin_ctzll(b);
+}
+
+static inline int bb_msb(Bitboard b) {
+    return 63 - __builtin_clzll(b);
+}
+
+static inline int bb_pop_lsb(Bitboard* b) {
+    int sq = __builtin_ctzll(*b);
+    *b &= *b - 1;
+    return sq;
+}
+
+static inline int bb_popcount(Bitboard b) {
+    return __builtin_popcountll(b);
+}
+
+// Ray attack stopping at (and including) the first blocker.
+// S/E/SE/SW walk towards higher indices, so the nearest blocker is the LSB;
+// the remaining directions walk towards lower indices and use the MSB.
+static inline Bitboard bb_ray_attacks(RayDirection dir, int sq, Bitboard occ) {
+    Bitboard ray = bb_rays[dir][sq];
+    Bitboard blockers = ray & occ;
+    if (blockers) {
+        int first = (dir == DIR_S || dir == DIR_E || dir == DIR_SE || dir == DIR_SW)
+                        ? bb_lsb(blockers)
+                        : bb_msb(blockers);
+        ray ^= bb_rays[dir][first];
+    }
+    return ray;
+}
+
+static inline Bitboard bb_rook_attacks(int sq, Bitboard occ) {
+    return bb_ray_attacks(DIR_N, sq, occ) | bb_ray_attacks(DIR_S, sq, occ) |
+           bb_ray_attacks(DIR_E, sq, occ) | bb_ray_attacks(DIR_W, sq, occ);
+}
+
+static inline Bitboard bb_bishop_attacks(int sq, Bitboard occ) {
+    return bb_ray_attacks(DIR_NE, sq, occ) | bb_ray_attacks(DIR_NW, sq, occ) |
+           bb_ray_attacks(DIR_SE, sq, occ) | bb_ray_attacks(DIR_SW, sq, occ);
+}
+
+#endif // BITBOARD_H
@@ -0,0 +1,279 @@
+#include "epd_pool.h"
+#include "game_import.h"
+#include "gamelogic.h"
+#include "move.h"
+#include "platform.h"
+#include "position_check.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EPD_MAX_FEN 128
+#define EPD_MAX_OPERAND 256
+// Arena bytes a line may need beyond its own length: " 0 1" clocks, six
+// terminators and the UCI best move
+#define EPD_LINE_SLACK 24
+
+typedef struct {
+    uint64_t hash;
+    int index;
+} EpdHashSlot;
+
+struct EpdPool {
+    atomic_int refs;
+    char* arena;            // Offset 0 is ""
+    size_t arenaSize;
+    EpdEntry* entries;
+    int count;
+    int skipped;
+    EpdHashSlot* byHash;    // Sorted by hash, then index
+};
+
+// A run of line text (not NUL-terminated)
+typedef struct {
+    const char* text;
+    size_t length;
+} EpdSpan;
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static uint32_t arena_add(EpdPool* pool, size_t capacity, const char* text, size_t length) {
+    if (length == 0 || pool->arenaSize + length + 1 > capacity) return 0;
+    uint32_t off = (uint32_t)pool->arenaSize;
+    memcpy(pool->arena + off, text, length);
+    pool->arena[off + length] = '\0';
+    pool->arenaSize += length + 1;
+    return off;
+}
+
+// Operands run to the next ';' outside quotes. A quoted operand loses its quotes.
+static const char* read_operand(const char* p, const char* end, EpdSpan* out) {
+    while (p < end && is_space(*p)) p++;
+    const char* start = p;
+    bool quoted = false;
+    while (p < end && (quoted || *p != ';')) {
+        if (*p == '"') quoted = !quoted;
+        p++;
+    }
+    const char* stop = p;
+    while (stop > start && is_space(stop[-1])) stop--;
+    if (stop - start >= 2 && *start == '"' && stop[-1] == '"') {
+        start++;
+        stop--;
+    }
+    out->text = start;
+    out->length = (size_t)(stop - start);
+    return p < end ? p + 1 : end;
+}
+
+static int span_int(EpdSpan s, int fallback) {
+    char buf[16];
+    if (s.length == 0 || s.length >= sizeof(buf)) return fallback;
+    memcpy(buf, s.text, s.length);
+    buf[s.length] = '\0';
+    char* stop;
+    long v = strtol(buf, &stop, 10);
+    return (stop != buf && v >= 0 && v < 100000) ? (int)v : fallback;
+}
+
+// Parse one line into the pool. Returns false if the line is not a usable position.
+static bool parse_line(EpdPool* pool, size_t capacity, GameLogic* logic, const char* p, const char* end) {
+    // Placement, side, castling, en passant
+    char fen[EPD_MAX_FEN];
+    size_t fenLen = 0;
+    for (int field = 0; field < 4; field++) {
+        while (p < end && is_space(*p)) p++;
+        const char* start = p;
+        while (p < end && !is_space(*p)) p++;
+        size_t len = (size_t)(p - start);
+        if (len == 0 || fenLen + len + 1 >= sizeof(fen)) return false;
+        if (field) fen[fenLen++] = ' ';
+        memcpy(fen + fenLen, start, len);
+        fenLen += len;
+    }
+
+    EpdSpan bm = {0}, am = {0}, id = {0}, c0 = {0}, hmvc = {0}, fmvn = {0};
+    while (p < end) {
+        while (p < end && is_space(*p)) p++;
+        const char* op = p;
+        while (p < end && !is_space(*p) && *p != ';') p++;
+        size_t opLen = (size_t)(p - op);
+        if (opLen == 0) {
+            if (p < end) p++; // Stray ';'
+            continue;
+        }
+        EpdSpan operand;
+        p = read_operand(p, end, &operand);
+        if (opLen == 2 && memcmp(op, "bm", 2) == 0) bm = operand;
+        else if (opLen == 2 && memcmp(op, "am", 2) == 0) am = operand;
+        else if (opLen == 2 && memcmp(op, "id", 2) == 0) id = operand;
+        else if (opLen == 2 && memcmp(op, "c0", 2) == 0) c0 = operand;
+        else if (opLen == 4 && memcmp(op, "hmvc", 4) == 0) hmvc = operand;
+        else if (opLen == 4 && memcmp(op, "fmvn", 4) == 0) fmvn = operand;
+    }
+
+    int written = snprintf(fen + fenLen, sizeof(fen) - fenLen, " %d %d", span_int(hmvc, 0), span_int(fmvn, 1));
+    if (written < 0 || (size_t)written >= sizeof(fen) - fenLen) return false;
+    fenLen += (size_t)written;
+
+    // Reject bad positions before GameLogic sees them
+    if (position_check_fen(fen, fenLen).error != POSITION_OK) return false;
+    gamelogic_load_fen(logic, fen);
+
+    EpdEntry e;
+    memset(&e, 0, sizeof(e));
+    e.hash = logic->currentHash;
+    e.turn = (uint8_t)logic->turn;
+    e.bestMove = PACKED_MOVE_NONE;
+    e.fen = arena_add(pool, capacity, fen, fenLen);
+    e.bm = arena_add(pool, capacity, bm.text, bm.length);
+    e.am = arena_add(pool, capacity, am.text, am.length);
+    e.id = arena_add(pool, capacity, id.text, id.length);
+    e.c0 = arena_add(pool, capacity, c0.text, c0.length);
+    if (e.fen == 0) return false;
+
+    if (bm.length > 0) {
+        // Only the first of several best moves is resolved
+        char first[EPD_MAX_OPERAND];
+        size_t len = 0;
+        while (len < bm.length && len + 1 < sizeof(first) && !is_space(bm.text[len])) {
+            first[len] = bm.text[len];
+            len++;
+        }
+        first[len] = '\0';
+        e.bestMove = game_import_resolve_san(logic, first);
+        if (e.bestMove != PACKED_MOVE_NONE) {
+            char uci[8];
+            packed_move_to_uci(e.bestMove, uci);
+            e.bestUci = arena_add(pool, capacity, uci, strlen(uci));
+        }
+    }
+
+    pool->entries[pool->count++] = e;
+    return true;
+}
+
+static int compare_slots(const void* a, const void* b) {
+    const EpdHashSlot* x = (const EpdHashSlot*)a;
+    const EpdHashSlot* y = (const EpdHashSlot*)b;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return x->index - y->index;
+}
+
+EpdPool* epd_pool_load_string(const char* text, size_t length) {
+    if (!text && length > 0) return NULL;
+
+    size_t lines = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '\n') lines++;
+    }
+    size_t capacity = 1 + length + lines * EPD_LINE_SLACK;
+    if (capacity > UINT32_MAX || lines > (size_t)INT32_MAX) return NULL;
+
+    EpdPool* pool = (EpdPool*)calloc(1, sizeof(EpdPool));
+    GameLogic* logic = gamelogic_create();
+    if (!pool || !logic) {
+        free(pool);
+        gamelogic_free(logic);
+        return NULL;
+    }
+    atomic_init(&pool->refs, 1);
+    logic->isSimulation = true; // Positions are only looked at, never played out
+    pool->arena = (char*)malloc(capacity);
+    pool->entries = (EpdEntry*)malloc(lines * sizeof(EpdEntry));
+    if (!pool->arena || !pool->entries) {
+        gamelogic_free(logic);
+        epd_pool_release(pool);
+        return NULL;
+    }
+    pool->arena[0] = '\0';
+    pool->arenaSize = 1;
+
+    const char* p = text;
+    const char* end = text + length;
+    while (p < end) {
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        const char* lineEnd = nl ? nl : end;
+        const char* start = p;
+        while (start < lineEnd && is_space(*start)) start++;
+        if (start < lineEnd && *start != '#') {
+            if (!parse_line(pool, capacity, logic, start, lineEnd)) pool->skipped++;
+        }
+        p = nl ? nl + 1 : end;
+    }
+    gamelogic_free(logic);
+
+    // Give back what the worst-case sizing did not use
+    char* arena = (char*)realloc(pool->arena, pool->arenaSize);
+    if (arena) pool->arena = arena;
+    if (pool->count > 0) {
+        EpdEntry* entries = (EpdEntry*)realloc(pool->entries, (size_t)pool->count * sizeof(EpdEntry));
+        if (entries) pool->entries = entries;
+
+        pool->byHash = (EpdHashSlot*)malloc((size_t)pool->count * sizeof(EpdHashSlot));
+        if (!pool->byHash) {
+            epd_pool_release(pool);
+            return NULL;
+        }
+        for (int i = 0; i < pool->count; i++) {
+            pool->byHash[i].hash = pool->entries[i].hash;
+            pool->byHash[i].index = i;
+        }
+        qsort(pool->byHash, (size_t)pool->count, sizeof(EpdHashSlot), compare_slots);
+    }
+    return pool;
+}
+
+EpdPool* epd_pool_load(const char* path) {
+    if (!path) return NULL;
+    MappedFile mf;
+    if (!platform_map_file(path, &mf)) return NULL;
+    EpdPool* pool = epd_pool_load_string(mf.data, mf.size);
+    platform_unmap_file(&mf);
+    return pool;
+}
+
+EpdPool* epd_pool_retain(EpdPool* pool) {
+    if (pool) atomic_fetch_add(&pool->refs, 1);
+    return pool;
+}
+
+void epd_pool_release(EpdPool* pool) {
+    if (!pool || atomic_fetch_sub(&pool->refs, 1) != 1) return;
+    free(pool->arena);
+    free(pool->entries);
+    free(pool->byHash);
+    free(pool);
+}
+
+int epd_pool_count(const EpdPool* pool) {
+    return pool ? pool->count : 0;
+}
+
+int epd_pool_skipped(const EpdPool* pool) {
+    return pool ? pool->skipped : 0;
+}
+
+const EpdEntry* epd_pool_entry(const EpdPool* pool, int index) {
+    if (!pool || index < 0 || index >= pool->count) return NULL;
+    return &pool->entries[index];
+}
+
+const char* epd_pool_string(const EpdPool* pool, uint32_t offset) {
+    if (!pool || offset >= pool->arenaSize) return "";
+    return pool->arena + offset;
+}
+
+int epd_pool_find(const EpdPool* pool, uint64_t hash) {
+    if (!pool || pool->count == 0) return -1;
+    int lo = 0, hi = pool->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (pool->byHash[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < pool->count && pool->byHash[lo].hash == hash) ? pool->byHash[lo].index : -1;
+}
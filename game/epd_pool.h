@@ -0,0 +1,50 @@
+#ifndef EPD_POOL_H
+#define EPD_POOL_H
+
+#include "types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Read-only position suites loaded from EPD files (opening books, test
+// suites, puzzle packs). A file is read once; every string of every entry
+// lives in one arena and entries refer to it by offset. A loaded pool never
+// changes, so the puzzle UI, CvC openings and analysis jobs can share it
+// across threads; each holder keeps a reference.
+
+// One EPD line. String fields are arena offsets (0 = absent, reads as "").
+typedef struct {
+    uint32_t fen;           // Full FEN; clocks from hmvc/fmvn, else "0 1"
+    uint32_t bm;            // Best move(s) in SAN, space separated
+    uint32_t am;            // Avoid move(s)
+    uint32_t id;
+    uint32_t c0;            // Comment, quotes stripped
+    uint32_t bestUci;       // First bm as UCI, 0 if it does not resolve
+    uint64_t hash;          // Zobrist hash of the position
+    PackedMove bestMove;    // First bm, PACKED_MOVE_NONE if absent or illegal
+    uint8_t turn;           // Player to move
+} EpdEntry;
+
+typedef struct EpdPool EpdPool;
+
+// Load a file or an in-memory buffer. Lines that are empty, start with '#'
+// or hold an invalid position are skipped. Returns NULL if the file cannot
+// be read or memory runs out; the caller owns one reference.
+EpdPool* epd_pool_load(const char* path);
+EpdPool* epd_pool_load_string(const char* text, size_t length);
+
+// Reference counting (thread-safe). The pool is freed with its last reference.
+EpdPool* epd_pool_retain(EpdPool* pool);
+void epd_pool_release(EpdPool* pool);
+
+int epd_pool_count(const EpdPool* pool);
+// Lines dropped while loading
+int epd_pool_skipped(const EpdPool* pool);
+const EpdEntry* epd_pool_entry(const EpdPool* pool, int index);
+// Text of a string field; "" for offset 0
+const char* epd_pool_string(const EpdPool* pool, uint32_t offset);
+
+// Index of the first entry whose position has this hash, or -1
+int epd_pool_find(const EpdPool* pool, uint64_t hash);
+
+#endif // EPD_POOL_H
@@ -4,6 +4,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "move.h"
+#include "platform.h"
+#include <pthread.h>
 
 // Helper to check if a string looks like a standard UCI move (e.g., "e2e4", "a7a8q")
 // static bool is_looks_like_uci(const char* token) - Removed unused
@@ -85,9 +87,18 @@ static void skip_comment_semicolon(const char** cursor) {
     }
 }
 
+// Tree being filled while importing (NULL when only the main line is wanted)
+typedef struct {
+    GameTree* tree;
+    int32_t node;   // Node for the position the logic is in
+} TreeBuilder;
+
 // Get next game token (Move or Result)
+// With a tree builder, comments are attached to the current node and
+// variation brackets come back as "(" and ")" tokens instead of being skipped.
 // Returns true if token found, false if end of stream
-static bool get_next_token(const char** cursor, char* buffer, size_t buf_size, GameImportResult* res) {
+static bool get_next_token(const char** cursor, char* buffer, size_t buf_size, GameImportResult* res,
+                           TreeBuilder* builder) {
     if (!cursor || !*cursor) return false;
     
     while (**cursor) {
@@ -103,15 +114,28 @@ static bool get_next_token(const char** cursor, char* buffer, size_t buf_size, G
         }
         }
         if (c == '{') {
+            const char* start = *cursor + 1;
             skip_comment_curly(cursor);
+            if (builder) {
+                const char* end = (*cursor)[-1] == '}' ? *cursor - 1 : *cursor;
+                game_tree_append_comment(builder->tree, builder->node, start, (size_t)(end - start));
+            }
             continue;
         }
-        if (c == '(') {
-            skip_comment_paren(cursor);
+        if (c == '(' || c == ')') {
+            if (builder) {
+                (*cursor)++;
+                snprintf(buffer, buf_size, "%c", c);
+                return true;
+            }
+            if (c == '(') skip_comment_paren(cursor);
+            else (*cursor)++; // Stray close bracket
             continue;
         }
         if (c == ';') {
+            const char* start = *cursor + 1;
             skip_comment_semicolon(cursor);
+            if (builder) game_tree_append_comment(builder->tree, builder->node, start, (size_t)(*cursor - start));
             continue;
         }
         
@@ -124,7 +148,7 @@ static bool get_next_token(const char** cursor, char* buffer, size_t buf_size, G
         
         // Read until whitespace or delimiter
         while (**cursor && !isspace((unsigned char)**cursor) && 
-               **cursor != '[' && **cursor != '{' && **cursor != '(' && **cursor != ';') {
+               **cursor != '[' && **cursor != '{' && **cursor != '(' && **cursor != ')' && **cursor != ';') {
              (*cursor)++;
              len++;
         }
@@ -181,214 +205,875 @@ static bool get_next_token(const char** cursor, char* buffer, size_t buf_size, G
     return false;
 }
 
-// Helper to get SAN for a candidate move (without simple checks/mates)
-static char get_import_piece_char(PieceType type) {
-    switch (type) {
-        case PIECE_KNIGHT: return 'N';
-        case PIECE_BISHOP: return 'B';
-        case PIECE_ROOK:   return 'R';
-        case PIECE_QUEEN:  return 'Q';
-        case PIECE_KING:   return 'K';
-        default:           return '\0'; 
+// --- Move token decoding ---
+
+// Defined in gamelogic.c
+extern bool gamelogic_simulate_packed_and_check_safety(GameLogic* logic, PackedMove pm, Player p);
+
+// A SAN token broken into its parts
+typedef struct {
+    PieceType piece;      // PIECE_PAWN for pawn moves
+    int fromFile;         // Disambiguation column, -1 if absent
+    int fromRow;          // Disambiguation row, -1 if absent
+    int to;               // Target square
+    PieceType promotion;  // NO_PROMOTION if absent
+    int castle;           // 0 = none, 1 = kingside, 2 = queenside
+} SanMove;
+
+static int san_piece_type(char c) {
+    switch (c) {
+        case 'K': return PIECE_KING;
+        case 'Q': return PIECE_QUEEN;
+        case 'R': return PIECE_ROOK;
+        case 'B': return PIECE_BISHOP;
+        case 'N': return PIECE_KNIGHT;
+        default:  return -1;
     }
 }
 
-static void get_candidate_san(Move* move, Move** all_moves, int count, char* buffer, size_t size) {
-    char temp[32] = {0};
-    int p = 0;
+static bool is_file_char(char c) { return c >= 'a' && c <= 'h'; }
+static bool is_rank_char(char c) { return c >= '1' && c <= '8'; }
+
+// Parse "Nbd2", "exd6", "e8=Q", "O-O-O+" and the like without looking at the board.
+// Check marks, annotations (!?) and a trailing "e.p." are ignored.
+static bool san_parse(const char* token, SanMove* san) {
+    char buf[16];
+    size_t len = strlen(token);
+    if (len == 0 || len >= sizeof(buf)) return false;
+    memcpy(buf, token, len + 1);
     
-    if (move->isCastling) {
-        int c2 = move->to_sq % 8;
-        int c1 = move->from_sq % 8;
-        p = snprintf(temp, sizeof(temp), (c2 > c1) ? "O-O" : "O-O-O");
-    } else {
-        char pc = get_import_piece_char(move->movedPieceType);
-        if (pc != '\0') {
-            temp[p++] = pc;
-            
-            // Disambiguation
-            bool ambiguity = false;
-            bool same_file = false;
-            bool same_rank = false;
-            
-            for (int i = 0; i < count; i++) {
-                Move* other = all_moves[i];
-                if (other->to_sq == move->to_sq && 
-                    other->movedPieceType == move->movedPieceType && 
-                    other->from_sq != move->from_sq) {
-                    ambiguity = true;
-                    if ((other->from_sq % 8) == (move->from_sq % 8)) same_file = true;
-                    if ((other->from_sq / 8) == (move->from_sq / 8)) same_rank = true;
-                }
-            }
-            
-            if (ambiguity) {
-                if (!same_file) {
-                    temp[p++] = (char)('a' + (move->from_sq % 8));
-                } else if (!same_rank) {
-                    temp[p++] = (char)('8' - (move->from_sq / 8));
-                } else {
-                    temp[p++] = (char)('a' + (move->from_sq % 8));
-                    temp[p++] = (char)('8' - (move->from_sq / 8));
-                }
-            }
-            
-            // Caption
-            if (move->capturedPieceType != NO_PIECE) {
-                temp[p++] = 'x';
+    if (len > 4 && strcmp(buf + len - 4, "e.p.") == 0) buf[len -= 4] = '\0';
+    while (len > 0 && strchr("+#!?", buf[len - 1])) buf[--len] = '\0';
+    if (len == 0) return false;
+    
+    san->piece = PIECE_PAWN;
+    san->fromFile = -1;
+    san->fromRow = -1;
+    san->to = -1;
+    san->promotion = NO_PROMOTION;
+    san->castle = 0;
+    
+    if (strcmp(buf, "O-O") == 0 || strcmp(buf, "0-0") == 0) {
+        san->castle = 1;
+        return true;
+    }
+    if (strcmp(buf, "O-O-O") == 0 || strcmp(buf, "0-0-0") == 0) {
+        san->castle = 2;
+        return true;
+    }
+    
+    const char* p = buf;
+    const char* end = buf + len;
+    int type = san_piece_type(*p);
+    if (type >= 0) {
+        san->piece = (PieceType)type;
+        p++;
+    }
+    
+    // Promotion suffix: "=Q" or a bare "Q" after the target
+    if (san->piece == PIECE_PAWN && end - p >= 3) {
+        int promo = san_piece_type(end[-1]);
+        if (promo >= 0 && promo != PIECE_KING && promo != PIECE_PAWN) {
+            san->promotion = (PieceType)promo;
+            end--;
+            if (end[-1] == '=') end--;
+        }
+    }
+    
+    // Target square is the last two characters left
+    if (end - p < 2 || !is_file_char(end[-2]) || !is_rank_char(end[-1])) return false;
+    san->to = ('8' - end[-1]) * 8 + (end[-2] - 'a');
+    end -= 2;
+    
+    // Whatever precedes it: optional file, optional rank, optional capture mark
+    if (p < end && (end[-1] == 'x' || end[-1] == ':')) end--;
+    if (p < end && is_file_char(*p)) san->fromFile = *p++ - 'a';
+    if (p < end && is_rank_char(*p)) san->fromRow = '8' - *p++;
+    return p == end;
+}
+
+// Resolve a parsed SAN move against the position: find the pieces of the
+// named type that reach the target, narrow by disambiguation, keep the legal ones
+static PackedMove san_resolve(GameLogic* logic, const SanMove* san) {
+    Player us = logic->turn;
+    Bitboard own = logic->colorBB[us];
+    Bitboard occupied = own | logic->colorBB[us == PLAYER_WHITE ? PLAYER_BLACK : PLAYER_WHITE];
+    
+    if (san->castle) {
+        // The king's castling moves, in whichever encoding the generator uses
+        Bitboard king = logic->pieceBB[PIECE_KING] & own;
+        if (!king) return PACKED_MOVE_NONE;
+        int from = bb_lsb(king);
+        MoveBuffer moves;
+        int count = gamelogic_generate_piece_moves(logic, from / 8, from % 8, &moves);
+        for (int i = 0; i < count; i++) {
+            PackedMove m = moves.moves[i];
+            if (PACKED_TYPE(m) != MOVE_TYPE_CASTLING) continue;
+            bool kingside = PACKED_TO(m) % 8 > from % 8;
+            if (kingside == (san->castle == 1)) return m;
+        }
+        return PACKED_MOVE_NONE;
+    }
+    
+    int to = san->to;
+    if (own & BB_SQUARE(to)) return PACKED_MOVE_NONE;
+    
+    Bitboard pieces = logic->pieceBB[san->piece] & own;
+    Bitboard candidates;
+    int moveType = MOVE_TYPE_NORMAL;
+    
+    if (san->piece == PIECE_PAWN) {
+        int forward = (us == PLAYER_WHITE) ? -8 : 8;
+        int epTarget = (logic->enPassantCol >= 0) ? (us == PLAYER_WHITE ? 16 : 40) + logic->enPassantCol : -1;
+        if (san->fromFile >= 0 && san->fromFile != to % 8) {
+            // Capture: our pawns stand where an enemy pawn on `to` would attack
+            candidates = bb_pawn_attacks[us == PLAYER_WHITE ? PLAYER_BLACK : PLAYER_WHITE][to] & pieces;
+            if (!(occupied & BB_SQUARE(to))) {
+                if (to != epTarget) return PACKED_MOVE_NONE;
+                moveType = MOVE_TYPE_EN_PASSANT;
             }
         } else {
-            // Pawn
-            if (move->capturedPieceType != NO_PIECE) {
-                temp[p++] = (char)('a' + (move->from_sq % 8));
-                temp[p++] = 'x';
+            // Push: one step, or two from the start row over an empty square
+            if (occupied & BB_SQUARE(to)) return PACKED_MOVE_NONE;
+            int one = to - forward;
+            int startRow = (us == PLAYER_WHITE) ? 6 : 1;
+            candidates = BB_EMPTY;
+            if (one >= 0 && one < 64) {
+                if (pieces & BB_SQUARE(one)) {
+                    candidates = BB_SQUARE(one);
+                } else if (!(occupied & BB_SQUARE(one))) {
+                    int two = one - forward;
+                    if (two >= 0 && two < 64 && two / 8 == startRow) candidates = pieces & BB_SQUARE(two);
+                }
             }
         }
+        if (to / 8 == 0 || to / 8 == 7) {
+            moveType = MOVE_TYPE_PROMOTION;
+        } else if (san->promotion != NO_PROMOTION) {
+            return PACKED_MOVE_NONE;
+        }
+    } else {
+        switch (san->piece) {
+            case PIECE_KNIGHT: candidates = bb_knight_attacks[to]; break;
+            case PIECE_BISHOP: candidates = bb_bishop_attacks(to, occupied); break;
+            case PIECE_ROOK:   candidates = bb_rook_attacks(to, occupied); break;
+            case PIECE_QUEEN:  candidates = bb_rook_attacks(to, occupied) | bb_bishop_attacks(to, occupied); break;
+            default:           candidates = bb_king_attacks[to]; break;
+        }
+        candidates &= pieces;
+    }
+    
+    PackedMove found = PACKED_MOVE_NONE;
+    while (candidates) {
+        int from = bb_pop_lsb(&candidates);
+        if (san->fromFile >= 0 && from % 8 != san->fromFile) continue;
+        if (san->fromRow >= 0 && from / 8 != san->fromRow) continue;
         
-        // Destination
-        temp[p++] = (char)('a' + (move->to_sq % 8));
-        temp[p++] = (char)('8' - (move->to_sq / 8));
-        
-        // Promotion
-        if (move->promotionPiece != NO_PROMOTION) {
-            temp[p++] = '=';
-            temp[p++] = get_import_piece_char(move->promotionPiece);
+        PackedMove pm;
+        if (moveType == MOVE_TYPE_PROMOTION) {
+            // A missing piece letter promotes to a queen, as make_move does
+            pm = PACKED_PROMOTION(from, to, san->promotion != NO_PROMOTION ? san->promotion : PIECE_QUEEN);
+        } else {
+            pm = PACKED_MOVE(from, to, moveType);
         }
+        if (!gamelogic_simulate_packed_and_check_safety(logic, pm, us)) continue;
+        if (found != PACKED_MOVE_NONE) return PACKED_MOVE_NONE; // Ambiguous
+        found = pm;
     }
-    temp[p] = '\0';
-    snprintf(buffer, size, "%s", temp);
+    return found;
 }
 
-GameImportResult game_import_from_string(GameLogic* logic, const char* input) {
-    GameImportResult res;
-    memset(&res, 0, sizeof(res));
-    res.success = true; // Optimistic
-    snprintf(res.start_fen, sizeof(res.start_fen), "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+// One SAN token against the current position. Used by the EPD loader (epd_pool.c).
+PackedMove game_import_resolve_san(GameLogic* logic, const char* token) {
+    SanMove san;
+    return san_parse(token, &san) ? san_resolve(logic, &san) : PACKED_MOVE_NONE;
+}
+
+// "e2e4" / "e7e8q": look the move up among the legal moves of that piece.
+// Also used by the PGN writer (pgn_export.c).
+PackedMove game_import_resolve_uci(GameLogic* logic, const char* token) {
+    size_t len = strlen(token);
+    if (len < 4 || len > 5 || !is_file_char(token[0]) || !is_rank_char(token[1]) ||
+        !is_file_char(token[2]) || !is_rank_char(token[3])) {
+        return PACKED_MOVE_NONE;
+    }
+    int from = ('8' - token[1]) * 8 + (token[0] - 'a');
+    int to = ('8' - token[3]) * 8 + (token[2] - 'a');
+    PieceType promo = NO_PROMOTION;
+    if (len == 5) {
+        int t = san_piece_type((char)toupper((unsigned char)token[4]));
+        if (t < 0 || t == PIECE_KING || t == PIECE_PAWN) return PACKED_MOVE_NONE;
+        promo = (PieceType)t;
+    }
+    
+    MoveBuffer moves;
+    int count = gamelogic_generate_piece_moves(logic, from / 8, from % 8, &moves);
+    for (int i = 0; i < count; i++) {
+        PackedMove m = moves.moves[i];
+        if (PACKED_TO(m) != to) continue;
+        if (PACKED_TYPE(m) == MOVE_TYPE_PROMOTION && PACKED_PROMOTION_PIECE(m) != (promo != NO_PROMOTION ? promo : PIECE_QUEEN)) {
+            continue;
+        }
+        return m;
+    }
+    return PACKED_MOVE_NONE;
+}
+
+// Make room for at least `need` bytes in loaded_uci (doubling)
+static bool reserve_uci(GameImportResult* res, size_t need) {
+    if (need <= res->loaded_uci_capacity) return true;
+    size_t cap = res->loaded_uci_capacity ? res->loaded_uci_capacity : 256;
+    while (cap < need) cap *= 2;
+    char* grown = (char*)realloc(res->loaded_uci, cap);
+    if (!grown) return false;
+    res->loaded_uci = grown;
+    res->loaded_uci_capacity = cap;
+    return true;
+}
+
+static bool append_uci(GameImportResult* res, size_t* len, const char* uci) {
+    if (!reserve_uci(res, *len + strlen(uci) + 2)) return false; // Separator + NUL
+    *len += (size_t)snprintf(res->loaded_uci + *len, res->loaded_uci_capacity - *len, *len ? " %s" : "%s", uci);
+    return true;
+}
+
+// Clear everything but the loaded_uci allocation, which is reused
+static void reset_result(GameImportResult* res) {
+    char* uci = res->loaded_uci;
+    size_t capacity = res->loaded_uci_capacity;
+    memset(res, 0, sizeof(*res));
+    res->loaded_uci = uci;
+    res->loaded_uci_capacity = capacity;
+    if (uci) uci[0] = '\0';
+    res->success = true; // Optimistic
+    snprintf(res->start_fen, sizeof(res->start_fen), "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+}
+
+// NAG for a move suffix ("!" = $1 ... "?!" = $6), 0 if none
+static uint8_t suffix_nag(const char* token) {
+    static const char* suffixes[] = {"!!", "??", "!?", "?!", "!", "?"};
+    static const uint8_t nags[] = {3, 4, 5, 6, 1, 2};
+    size_t len = strlen(token);
+    for (int i = 0; i < 6; i++) {
+        size_t n = strlen(suffixes[i]);
+        if (len > n && strcmp(token + len - n, suffixes[i]) == 0) return nags[i];
+    }
+    return 0;
+}
+
+static bool play_packed(GameLogic* logic, PackedMove pm) {
+    Move move;
+    move_unpack(&move, pm, logic->turn);
+    return gamelogic_perform_move(logic, &move);
+}
+
+// Side line being read: where to resume and how many plies to take back
+typedef struct {
+    int32_t resume;     // Main-line node the variation replaces
+    int played;
+} VariationFrame;
+
+#define MAX_VARIATION_DEPTH 32
+
+static void import_game(GameLogic* logic, const char* input, GameImportResult* res, GameTree* tree) {
+    reset_result(res);
     
     if (!logic || !input) {
-        res.success = false;
-        snprintf(res.error_message, sizeof(res.error_message), "Internal error: Null logic or input.");
-        return res;
+        res->success = false;
+        snprintf(res->error_message, sizeof(res->error_message), "Internal error: Null logic or input.");
+        return;
     }
+    if (!reserve_uci(res, 1)) {
+        res->success = false;
+        snprintf(res->error_message, sizeof(res->error_message), "Out of memory.");
+        return;
+    }
+    res->loaded_uci[0] = '\0';
     
     // 1. Reset Logic
     gamelogic_reset(logic);
     
+    TreeBuilder builder = {tree, GAME_TREE_ROOT};
+    TreeBuilder* tb = NULL;
+    if (tree) {
+        game_tree_clear(tree);
+        tb = &builder;
+    }
+    VariationFrame frames[MAX_VARIATION_DEPTH];
+    int depth = 0;
+    
+    // Game-over and status checks run once at the end, not after every ply
+    bool wasSimulation = logic->isSimulation;
+    logic->isSimulation = true;
+    
     // 2. Scan Input
     const char* cursor = input;
     char token[128];
-    char uci_accum[4096] = ""; // To reconstruct UCI string
+    size_t uci_len = 0; // To reconstruct UCI string
     
-    while (get_next_token(&cursor, token, sizeof(token), &res)) {
+    while (get_next_token(&cursor, token, sizeof(token), res, tb)) {
         // Check for Game End markers
         if (strcmp(token, "1-0") == 0 || strcmp(token, "0-1") == 0 || strcmp(token, "1/2-1/2") == 0 || strcmp(token, "*") == 0) {
-            snprintf(res.result, sizeof(res.result), "%s", token);
+            snprintf(res->result, sizeof(res->result), "%s", token);
             break; // Valid end of game
         }
         
-        // It should be a move. Try to match it.
-        int count = 0;
-        Move** legal_moves = gamelogic_get_all_legal_moves(logic, logic->turn, &count);
+        // Numeric annotation glyphs ($1, $14, ...)
+        if (token[0] == '$') {
+            if (tb) game_tree_add_nag(tree, builder.node, (uint8_t)atoi(token + 1));
+            continue;
+        }
         
-        Move* matched_move = NULL;
-        // bool ambig_found = false; // Unused
+        // Side lines (tree mode only): "(" takes back the last move and plays
+        // the alternative, ")" returns to the main line
+        if (tb && strcmp(token, "(") == 0) {
+            if (builder.node == GAME_TREE_ROOT || depth == MAX_VARIATION_DEPTH) {
+                res->success = false;
+                snprintf(res->error_message, sizeof(res->error_message), "Misplaced variation at ply %d", res->moves_count + 1);
+                break;
+            }
+            frames[depth++] = (VariationFrame){builder.node, 0};
+            gamelogic_undo_move(logic);
+            builder.node = tree->nodes[builder.node].parent;
+            continue;
+        }
+        if (tb && strcmp(token, ")") == 0) {
+            if (depth == 0) continue; // Stray bracket
+            VariationFrame* f = &frames[--depth];
+            for (int i = 0; i < f->played; i++) gamelogic_undo_move(logic);
+            play_packed(logic, tree->nodes[f->resume].move);
+            builder.node = f->resume;
+            continue;
+        }
         
-        // Strategy 1: Exact SAN match (with logic's generator)
-        // Strategy 2: UCI match
+        // It should be a move: UCI first (never valid SAN), then SAN
+        PackedMove matched_move = game_import_resolve_uci(logic, token);
+        SanMove san;
+        if (matched_move == PACKED_MOVE_NONE && san_parse(token, &san)) {
+            matched_move = san_resolve(logic, &san);
+        }
         
-
-
-        for (int i = 0; i < count; i++) {
-            Move* m = legal_moves[i];
-            
-            // Check SAN
-            char san[32];
-            // Use local candidate generation instead of gamelogic's history-dependent one
-            get_candidate_san(m, legal_moves, count, san, sizeof(san));
-            
-            // Clean SAN (remove check/mate markers from logic output for comparison if input lacks them, or vice versa)
-            // But gamelogic_get_move_san produces "Nf3", "O-O", "e4", "Qxd5+" etc.
-            // PGN input might have "e4", "Nf3", "Qxd5", "Qxd5+" etc.
-            
-            // For robust comparison, we can strip Check signs (+, #) from both for comparison?
-            // Or just try direct.
-            
-            bool match = false;
-            
-            // 1. Direct String Compare
-            if (strcmp(token, san) == 0) match = true;
+        if (matched_move != PACKED_MOVE_NONE) {
+            // Add to UCI accumulator (main line only)
+            if (depth == 0) {
+                char uci[8];
+                packed_move_to_uci(matched_move, uci);
+                if (!append_uci(res, &uci_len, uci)) {
+                    res->success = false;
+                    snprintf(res->error_message, sizeof(res->error_message), "Out of memory at ply %d", res->moves_count + 1);
+                    break;
+                }
+            }
             
-            // 2. Fail-soft: input "Nf3" vs "Nf3+" (logic)
-            if (!match) {
-                 size_t tok_len = strlen(token);
-                 size_t san_len = strlen(san);
-                 // Check token subset of san (if sanitize)
-                 // Just check if san starts with token AND the rest is just +/#
-                 if (strncmp(token, san, tok_len) == 0) {
-                     // check remainder
-                     bool only_suffix = true;
-                     for (size_t k = tok_len; k < san_len; k++) {
-                         if (san[k] != '+' && san[k] != '#') only_suffix = false;
-                     }
-                     if (only_suffix) match = true;
-                 }
-                 // Check SAN subset of token (input "Nf3??")
-                 if (!match && strncmp(san, token, san_len) == 0) {
-                      match = true; // Allow loose
-                 }
+            if (!play_packed(logic, matched_move)) {
+                res->success = false;
+                snprintf(res->error_message, sizeof(res->error_message), "Failed to perform move '%s' (System Error)", token);
+                break;
             }
             
-            // 3. UCI Match
-            char uci[8];
-            move_to_uci(m, uci); // e2e4
-            if (!match && strcmp(token, uci) == 0) match = true;
+            if (depth == 0) res->moves_count++;
+            else frames[depth - 1].played++;
             
-            if (match) {
-                if (matched_move == NULL) {
-                    matched_move = move_copy(m);
-                } else {
-                    // Ambiguity? e.g. two knights can move but input is just "N".
-                    // Strict SAN rules say this is invalid PGN, but we simply pick the first valid one if ambiguous 
-                    // or treat as error? PGN standard requires disambiguation. 
-                    // Let's stick to "First Legal Match" logic for robustness, 
-                    // unless we want to be strict.
+            if (tb) {
+                int32_t node = game_tree_add_move(tree, builder.node, matched_move);
+                if (node == GAME_TREE_NONE) {
+                    res->success = false;
+                    snprintf(res->error_message, sizeof(res->error_message), "Out of memory at ply %d", res->moves_count);
+                    break;
                 }
+                builder.node = node;
+                game_tree_add_nag(tree, node, suffix_nag(token));
             }
+        } else {
+            res->success = false;
+            if (depth > 0) {
+                snprintf(res->error_message, sizeof(res->error_message), "Unrecognized or illegal move in variation: '%s' after ply %d", token, res->moves_count);
+            } else {
+                snprintf(res->error_message, sizeof(res->error_message), "Unrecognized or illegal move: '%s' at ply %d", token, res->moves_count+1);
+            }
+            break;
         }
+    }
+    
+    // Leave the logic on the main line even if a variation was left open
+    while (depth > 0) {
+        VariationFrame* f = &frames[--depth];
+        for (int i = 0; i < f->played; i++) gamelogic_undo_move(logic);
+        play_packed(logic, tree->nodes[f->resume].move);
+    }
+    
+    logic->isSimulation = wasSimulation;
+    gamelogic_update_game_state(logic);
+    
+    // Only a fully parsed game exposes its moves
+    if (!res->success) res->loaded_uci[0] = '\0';
+}
+
+GameImportResult game_import_from_string(GameLogic* logic, const char* input) {
+    GameImportResult res;
+    memset(&res, 0, sizeof(res));
+    import_game(logic, input, &res, NULL);
+    return res;
+}
+
+GameImportResult game_import_from_string_with_tree(GameLogic* logic, const char* input, GameTree* tree) {
+    GameImportResult res;
+    memset(&res, 0, sizeof(res));
+    import_game(logic, input, &res, tree);
+    return res;
+}
+
+void game_import_result_free(GameImportResult* res) {
+    if (!res) return;
+    free(res->loaded_uci);
+    res->loaded_uci = NULL;
+    res->loaded_uci_capacity = 0;
+}
+
+// --- Streaming multi-game reader ---
+
+#define PGN_READ_CHUNK 65536
+
+// Text of the game being read; reused (never shrunk) across games
+typedef struct {
+    char* data;
+    size_t len;
+    size_t capacity;
+} GameText;
+
+static bool game_text_push(GameText* text, char c) {
+    if (text->len + 1 >= text->capacity) { // Keep room for the terminator
+        size_t cap = text->capacity ? text->capacity * 2 : 4096;
+        char* grown = (char*)realloc(text->data, cap);
+        if (!grown) return false;
+        text->data = grown;
+        text->capacity = cap;
+    }
+    text->data[text->len++] = c;
+    return true;
+}
+
+// Game boundaries, shared by the streaming and parallel readers: a '[' at
+// the start of a line (outside a {comment}) once movetext has begun
+typedef struct {
+    bool at_line_start;
+    bool in_movetext;      // Current game has started its moves
+    bool in_comment;       // Inside {...}, where '[' may start a line (e.g. [%clk])
+    bool in_line_comment;
+} PgnSplitter;
+
+static void pgn_splitter_init(PgnSplitter* split) {
+    memset(split, 0, sizeof(*split));
+    split->at_line_start = true;
+}
+
+// Feed one character. Returns true if it opens the next game, i.e. the
+// text before it is a complete game.
+static bool pgn_splitter_feed(PgnSplitter* split, char c) {
+    bool blank = (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    bool boundary = false;
+    
+    if (split->at_line_start && !blank && !split->in_comment) {
+        if (c == '[') {
+            boundary = split->in_movetext;
+            split->in_movetext = false;
+        } else {
+            split->in_movetext = true;
+        }
+    }
+    
+    if (c == '\n') {
+        split->at_line_start = true;
+        split->in_line_comment = false;
+    } else if (!blank) {
+        split->at_line_start = false;
+    }
+    if (!split->in_line_comment) {
+        if (c == '{') split->in_comment = true;
+        else if (c == '}') split->in_comment = false;
+        else if (c == ';' && !split->in_comment) split->in_line_comment = true;
+    }
+    return boundary;
+}
+
+// Import the buffered game (if it holds anything) and hand it to the callback
+static bool flush_game(GameLogic* logic, GameText* text, GameImportResult* res,
+                       GameImportCallback callback, void* user_data, GameImportStats* stats) {
+    bool keep_going = true;
+    size_t i = 0;
+    while (i < text->len && isspace((unsigned char)text->data[i])) i++;
+    
+    if (i < text->len) {
+        text->data[text->len] = '\0';
+        import_game(logic, text->data + i, res, NULL);
+        int index = stats->games++;
+        if (res->success) stats->imported++;
+        else stats->failed++;
+        if (callback) keep_going = callback(res, index, user_data);
+    }
+    text->len = 0;
+    return keep_going;
+}
+
+int game_import_pgn_stream(GameLogic* logic, FILE* stream, GameImportCallback callback, void* user_data,
+                           GameImportStats* stats) {
+    GameImportStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (!logic || !stream) return 0;
+    
+    char* chunk = (char*)malloc(PGN_READ_CHUNK);
+    if (!chunk) {
+        stats->io_error = true;
+        return 0;
+    }
+    
+    GameText text = {0};
+    GameImportResult res;
+    memset(&res, 0, sizeof(res));
+    
+    bool keep_going = true;
+    bool first_chunk = true;
+    PgnSplitter split;
+    pgn_splitter_init(&split);
+    size_t n;
+    
+    while (keep_going && (n = fread(chunk, 1, PGN_READ_CHUNK, stream)) > 0) {
+        size_t i = 0;
+        if (first_chunk && n >= 3 && memcmp(chunk, "\xEF\xBB\xBF", 3) == 0) i = 3; // UTF-8 BOM
+        first_chunk = false;
         
-        // Clean up legal moves
-        gamelogic_free_moves_array(legal_moves, count);
-        
-        if (matched_move) {
-            // Add to UCI accumulator
-            char uci[8];
-            move_to_uci(matched_move, uci);
-            size_t current_len = strlen(uci_accum);
-            if (current_len > 0) {
-                snprintf(uci_accum + current_len, sizeof(uci_accum) - current_len, " %s", uci);
-            } else {
-                snprintf(uci_accum, sizeof(uci_accum), "%s", uci);
+        for (; i < n && keep_going; i++) {
+            char c = chunk[i];
+            if (pgn_splitter_feed(&split, c)) {
+                keep_going = flush_game(logic, &text, &res, callback, user_data, stats);
+                if (!keep_going) break;
             }
-            
-            if (!gamelogic_perform_move(logic, matched_move)) {
-                res.success = false;
-                snprintf(res.error_message, sizeof(res.error_message), "Failed to perform move '%s' (System Error)", token);
-                move_free(matched_move);
-                break;
+            if (!game_text_push(&text, c)) {
+                stats->io_error = true;
+                keep_going = false;
             }
-            
-            res.moves_count++;
-            move_free(matched_move);
+        }
+    }
+    
+    if (ferror(stream)) stats->io_error = true;
+    if (keep_going) flush_game(logic, &text, &res, callback, user_data, stats);
+    
+    free(chunk);
+    free(text.data);
+    game_import_result_free(&res);
+    return stats->games;
+}
+
+int game_import_pgn_file(GameLogic* logic, const char* path, GameImportCallback callback, void* user_data,
+                         GameImportStats* stats) {
+    if (stats) memset(stats, 0, sizeof(*stats));
+    if (!path) return -1;
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    int games = game_import_pgn_stream(logic, f, callback, user_data, stats);
+    fclose(f);
+    return games;
+}
+
+// --- Parallel reader ---
+
+#define IMPORT_BATCH_GAMES 32        // Games a worker claims at a time
+#define IMPORT_SLOTS_PER_WORKER 4    // Batches in flight per worker (bounds memory)
+
+// Byte range of one game in the mapped file
+typedef struct {
+    size_t offset;
+    size_t length;
+} GameSpan;
+
+// Results of one batch, waiting to be merged in order
+typedef struct {
+    int batch;      // Batch index held, -1 if free
+    int count;
+    bool done;
+    GameImportResult results[IMPORT_BATCH_GAMES];
+} ImportSlot;
+
+typedef struct ParallelImport ParallelImport;
+
+typedef struct {
+    ParallelImport* job;
+    GameLogic* logic;               // Private to this worker
+    GameImportWorkerStats stats;
+} ImportWorker;
+
+struct ParallelImport {
+    const char* data;
+    size_t size;
+    
+    pthread_mutex_t lock;
+    pthread_cond_t changed;         // Any of the fields below moved
+    
+    GameSpan* spans;                // Filled by the splitter, grows by doubling
+    int spanCount;
+    int spanCapacity;
+    bool splitDone;
+    bool outOfMemory;
+    
+    int nextBatch;                  // Next batch a worker may claim
+    int mergedBatches;              // Batches handed to the callback so far
+    bool stop;
+    
+    ImportSlot* slots;
+    int slotCount;
+};
+
+// Publish locally found spans to the workers
+static bool publish_spans(ParallelImport* job, const GameSpan* found, int count) {
+    pthread_mutex_lock(&job->lock);
+    bool ok = true;
+    if (job->spanCount + count > job->spanCapacity) {
+        int cap = job->spanCapacity ? job->spanCapacity : 1024;
+        while (cap < job->spanCount + count) cap *= 2;
+        GameSpan* grown = (GameSpan*)realloc(job->spans, (size_t)cap * sizeof(GameSpan));
+        if (grown) {
+            job->spans = grown;
+            job->spanCapacity = cap;
         } else {
-            res.success = false;
-            snprintf(res.error_message, sizeof(res.error_message), "Unrecognized or illegal move: '%s' at ply %d", token, res.moves_count+1);
-            break;
+            job->outOfMemory = true;
+            job->stop = true;
+            ok = false;
+        }
+    }
+    if (ok) {
+        memcpy(job->spans + job->spanCount, found, (size_t)count * sizeof(GameSpan));
+        job->spanCount += count;
+        ok = !job->stop;
+    }
+    pthread_cond_broadcast(&job->changed);
+    pthread_mutex_unlock(&job->lock);
+    return ok;
+}
+
+// Splitter: walk the mapping once and cut it into games
+static void* split_games(void* arg) {
+    ParallelImport* job = (ParallelImport*)arg;
+    GameSpan found[IMPORT_BATCH_GAMES];
+    int pending = 0;
+    bool keep_going = true;
+    
+    size_t i = 0;
+    if (job->size >= 3 && memcmp(job->data, "\xEF\xBB\xBF", 3) == 0) i = 3; // UTF-8 BOM
+    size_t start = i;
+    bool has_text = false;
+    PgnSplitter split;
+    pgn_splitter_init(&split);
+    
+    for (; i <= job->size && keep_going; i++) {
+        bool end = (i == job->size);
+        if (end || pgn_splitter_feed(&split, job->data[i])) {
+            if (has_text) {
+                found[pending++] = (GameSpan){start, i - start};
+                if (pending == IMPORT_BATCH_GAMES) {
+                    keep_going = publish_spans(job, found, pending);
+                    pending = 0;
+                }
+            }
+            start = i;
+            has_text = false;
         }
+        if (!end && !isspace((unsigned char)job->data[i])) has_text = true;
     }
+    if (keep_going && pending > 0) publish_spans(job, found, pending);
     
-    if (res.success) {
-        snprintf(res.loaded_uci, sizeof(res.loaded_uci), "%s", uci_accum);
+    pthread_mutex_lock(&job->lock);
+    job->splitDone = true;
+    pthread_cond_broadcast(&job->changed);
+    pthread_mutex_unlock(&job->lock);
+    return NULL;
+}
+
+// Worker: claim whole batches in order, import them into a free slot
+static void* import_games(void* arg) {
+    ImportWorker* worker = (ImportWorker*)arg;
+    ParallelImport* job = worker->job;
+    GameSpan batch[IMPORT_BATCH_GAMES];
+    GameText text = {0};
+    
+    pthread_mutex_lock(&job->lock);
+    for (;;) {
+        int b = job->nextBatch;
+        int begin = b * IMPORT_BATCH_GAMES;
+        // Wait for a full batch (or the tail) and for its slot to be merged
+        while (!job->stop && !(job->splitDone && begin >= job->spanCount) &&
+               ((job->spanCount < begin + IMPORT_BATCH_GAMES && !job->splitDone) ||
+                b >= job->mergedBatches + job->slotCount)) {
+            pthread_cond_wait(&job->changed, &job->lock);
+            b = job->nextBatch;
+            begin = b * IMPORT_BATCH_GAMES;
+        }
+        if (job->stop || begin >= job->spanCount) break;
+        
+        job->nextBatch++;
+        ImportSlot* slot = &job->slots[b % job->slotCount];
+        slot->batch = b;
+        slot->done = false;
+        slot->count = job->spanCount - begin;
+        if (slot->count > IMPORT_BATCH_GAMES) slot->count = IMPORT_BATCH_GAMES;
+        memcpy(batch, job->spans + begin, (size_t)slot->count * sizeof(GameSpan));
+        pthread_mutex_unlock(&job->lock);
+        
+        int64_t started = get_monotonic_time_ms();
+        bool ok = true;
+        for (int i = 0; i < slot->count; i++) {
+            GameImportResult* res = &slot->results[i];
+            // import_game wants a terminated string; the mapping has none
+            text.len = 0;
+            for (size_t k = 0; k < batch[i].length && ok; k++) {
+                ok = game_text_push(&text, job->data[batch[i].offset + k]);
+            }
+            if (!ok) break;
+            text.data[text.len] = '\0';
+            import_game(worker->logic, text.data, res, NULL);
+            worker->stats.games++;
+            if (res->success) worker->stats.imported++;
+            else worker->stats.failed++;
+        }
+        worker->stats.busy_ms += get_monotonic_time_ms() - started;
+        
+        pthread_mutex_lock(&job->lock);
+        if (!ok) {
+            job->outOfMemory = true;
+            job->stop = true;
+        }
+        slot->done = true;
+        pthread_cond_broadcast(&job->changed);
     }
+    pthread_mutex_unlock(&job->lock);
     
-    return res;
+    free(text.data);
+    return NULL;
+}
+
+static double games_per_second(int games, int64_t ms) {
+    return ms > 0 ? games * 1000.0 / (double)ms : 0.0;
+}
+
+// Caller's thread: hand finished batches to the callback in file order
+static void merge_batches(ParallelImport* job, GameImportCallback callback, void* user_data,
+                          GameImportParallelStats* stats) {
+    for (int b = 0;; b++) {
+        ImportSlot* slot = &job->slots[b % job->slotCount];
+        pthread_mutex_lock(&job->lock);
+        while (!job->stop && !(slot->batch == b && slot->done) &&
+               !(job->splitDone && b * IMPORT_BATCH_GAMES >= job->spanCount)) {
+            pthread_cond_wait(&job->changed, &job->lock);
+        }
+        bool finished = job->stop || !(slot->batch == b && slot->done);
+        pthread_mutex_unlock(&job->lock);
+        if (finished) return;
+        
+        bool keep_going = true;
+        for (int i = 0; i < slot->count && keep_going; i++) {
+            const GameImportResult* res = &slot->results[i];
+            stats->total.games++;
+            if (res->success) stats->total.imported++;
+            else stats->total.failed++;
+            if (callback) keep_going = callback(res, b * IMPORT_BATCH_GAMES + i, user_data);
+        }
+        
+        pthread_mutex_lock(&job->lock);
+        job->mergedBatches++;
+        if (!keep_going) job->stop = true;
+        pthread_cond_broadcast(&job->changed);
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+int game_import_pgn_file_parallel(const char* path, int threads, GameImportCallback callback, void* user_data,
+                                  GameImportParallelStats* stats) {
+    GameImportParallelStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (!path) return -1;
+    
+    MappedFile mf;
+    if (!platform_map_file(path, &mf)) return -1;
+    int64_t started = get_monotonic_time_ms();
+    
+    if (threads <= 0) threads = platform_cpu_count();
+    if (threads > GAME_IMPORT_MAX_WORKERS) threads = GAME_IMPORT_MAX_WORKERS;
+    
+    ParallelImport job;
+    memset(&job, 0, sizeof(job));
+    job.data = mf.data;
+    job.size = mf.size;
+    job.slotCount = threads * IMPORT_SLOTS_PER_WORKER;
+    job.slots = (ImportSlot*)calloc((size_t)job.slotCount, sizeof(ImportSlot));
+    ImportWorker* workers = (ImportWorker*)calloc((size_t)threads, sizeof(ImportWorker));
+    pthread_t* handles = (pthread_t*)calloc((size_t)threads, sizeof(pthread_t));
+    if (!job.slots || !workers || !handles) {
+        free(job.slots);
+        free(workers);
+        free(handles);
+        platform_unmap_file(&mf);
+        stats->total.io_error = true;
+        return 0;
+    }
+    for (int s = 0; s < job.slotCount; s++) job.slots[s].batch = -1;
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.changed, NULL);
+    bitboard_init(); // Fill the attack tables before any worker reads them
+    
+    // Workers that cannot get a GameLogic or a thread are simply not used
+    int running = 0;
+    for (int t = 0; t < threads; t++) {
+        ImportWorker* w = &workers[running];
+        w->job = &job;
+        w->logic = gamelogic_create();
+        if (!w->logic) continue;
+        if (pthread_create(&handles[running], NULL, import_games, w) != 0) {
+            gamelogic_free(w->logic);
+            w->logic = NULL;
+            continue;
+        }
+        running++;
+    }
+    
+    pthread_t splitter;
+    bool splitterThread = running > 0 && pthread_create(&splitter, NULL, split_games, &job) == 0;
+    if (running == 0) {
+        job.stop = true;
+        job.outOfMemory = true;
+    } else if (!splitterThread) {
+        split_games(&job); // Spans are unbounded, so splitting up front cannot block
+    }
+    
+    merge_batches(&job, callback, user_data, stats);
+    
+    // Stop whatever is still running (callback asked to stop, or an error)
+    pthread_mutex_lock(&job.lock);
+    job.stop = true;
+    pthread_cond_broadcast(&job.changed);
+    pthread_mutex_unlock(&job.lock);
+    if (splitterThread) pthread_join(splitter, NULL);
+    for (int t = 0; t < running; t++) {
+        pthread_join(handles[t], NULL);
+        gamelogic_free(workers[t].logic);
+        workers[t].stats.games_per_second = games_per_second(workers[t].stats.games, workers[t].stats.busy_ms);
+        stats->worker[t] = workers[t].stats;
+    }
+    
+    stats->workers = running;
+    stats->total.io_error = job.outOfMemory;
+    stats->elapsed_ms = get_monotonic_time_ms() - started;
+    stats->games_per_second = games_per_second(stats->total.games, stats->elapsed_ms);
+    
+    for (int s = 0; s < job.slotCount; s++) {
+        for (int i = 0; i < IMPORT_BATCH_GAMES; i++) game_import_result_free(&job.slots[s].results[i]);
+    }
+    pthread_cond_destroy(&job.changed);
+    pthread_mutex_destroy(&job.lock);
+    free(job.slots);
+    free(job.spans);
+    free(workers);
+    free(handles);
+    platform_unmap_file(&mf);
+    return stats->total.games;
 }
@@ -2,14 +2,18 @@
 #define GAME_IMPORT_H
 
 #include "gamelogic.h"
+#include "game_tree.h"
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 
 // Result of an import operation
 typedef struct {
     bool success;
     char error_message[256];
     int moves_count;
-    char loaded_uci[4096]; // Space-separated UCI moves of the loaded game
+    char* loaded_uci;      // Space-separated UCI moves of the loaded game (heap, grows as needed)
+    size_t loaded_uci_capacity;
     char start_fen[256];   // Detected or default start FEN
     char result[16];       // "1-0", "0-1", "1/2-1/2", "*" or empty
     
@@ -32,4 +36,86 @@ typedef struct {
  */
 GameImportResult game_import_from_string(GameLogic* logic, const char* input);
 
+/**
+ * Same as game_import_from_string, but also keeps what the plain import
+ * skips: side lines "( ... )", {comments}, ;comments and NAGs ($n and
+ * suffixes such as "!?") go into tree. The result still describes the main
+ * line only.
+ *
+ * @param tree An initialized GameTree (see game_tree_init); it is cleared first.
+ */
+GameImportResult game_import_from_string_with_tree(GameLogic* logic, const char* input, GameTree* tree);
+
+// Release the heap parts of a result returned by game_import_from_string
+void game_import_result_free(GameImportResult* res);
+
+// Called once per game read from a stream. The result (including loaded_uci)
+// is only valid during the call. Return false to stop reading.
+typedef bool (*GameImportCallback)(const GameImportResult* game, int index, void* user_data);
+
+typedef struct {
+    int games;      // Games found in the stream
+    int imported;   // Games that parsed successfully
+    int failed;     // Games with an illegal or unrecognized move
+    bool io_error;  // Reading stopped on a file error
+} GameImportStats;
+
+/**
+ * Reads a multi-game PGN stream and imports one game at a time.
+ * Games are split on tag sections: a '[' at the start of a line (outside a
+ * {comment}) after movetext begins the next game. Input is read through a
+ * fixed chunk buffer and each game's text buffer is reused, so memory stays
+ * bounded by the longest single game, not by the file.
+ *
+ * @param logic    Scratch GameLogic, reset for every game.
+ * @param stats    Optional totals (may be NULL).
+ * @return Number of games passed to the callback.
+ */
+int game_import_pgn_stream(GameLogic* logic, FILE* stream, GameImportCallback callback, void* user_data,
+                           GameImportStats* stats);
+
+// Same as game_import_pgn_stream for a file path. Returns -1 if it cannot be opened.
+int game_import_pgn_file(GameLogic* logic, const char* path, GameImportCallback callback, void* user_data,
+                         GameImportStats* stats);
+
+// One UCI move ("e2e4", "e7e8q") against logic's current position, or
+// PACKED_MOVE_NONE if it is malformed or not legal there
+PackedMove game_import_resolve_uci(GameLogic* logic, const char* token);
+// Same for one SAN move ("Nf3", "exd8=Q+"); also PACKED_MOVE_NONE if ambiguous
+PackedMove game_import_resolve_san(GameLogic* logic, const char* token);
+
+// Upper bound on worker threads for the parallel reader
+#define GAME_IMPORT_MAX_WORKERS 64
+
+typedef struct {
+    int games;                  // Games this worker parsed
+    int imported;
+    int failed;
+    int64_t busy_ms;            // Time spent parsing (excludes waiting)
+    double games_per_second;    // games / busy time
+} GameImportWorkerStats;
+
+typedef struct {
+    GameImportStats total;      // io_error is set if memory ran out
+    int workers;                // Worker threads actually started
+    GameImportWorkerStats worker[GAME_IMPORT_MAX_WORKERS];
+    int64_t elapsed_ms;         // Wall time, mapping to last callback
+    double games_per_second;    // Overall throughput
+} GameImportParallelStats;
+
+/**
+ * Imports a multi-game PGN file on several threads.
+ * The file is memory-mapped; a splitter thread cuts it into games using the
+ * same boundary rule as game_import_pgn_stream, and workers (each with a
+ * private GameLogic) import them in batches. Results are handed to the
+ * callback on the calling thread, in file order, with the same indices the
+ * streaming reader would use, so the callback needs no locking.
+ *
+ * @param threads  Worker count; <= 0 uses every core.
+ * @param stats    Optional totals and per-worker figures (may be NULL).
+ * @return Number of games passed to the callback, or -1 if the file cannot be mapped.
+ */
+int game_import_pgn_file_parallel(const char* path, int threads, GameImportCallback callback, void* user_data,
+                                  GameImportParallelStats* stats);
+
 #endif // GAME_IMPORT_H
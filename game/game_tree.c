@@ -0,0 +1,273 @@
+#include "game_tree.h"
+#include "move.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_NODES 64
+#define INITIAL_POOL 256
+#define INITIAL_INTERN 64   // Power of two
+
+// FNV-1a
+static uint32_t hash_text(const char* text, size_t length) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void reset_root(GameTree* tree) {
+    tree->nodes[0] = (GameTreeNode){PACKED_MOVE_NONE, 0, {0, 0}, GAME_TREE_NONE, GAME_TREE_NONE, GAME_TREE_NONE, 0};
+    tree->nodeCount = 1;
+    tree->pool[0] = '\0';
+    tree->poolSize = 1;
+    tree->internCount = 0;
+    if (tree->internTable) memset(tree->internTable, 0, tree->internCapacity * sizeof(uint32_t));
+}
+
+bool game_tree_init(GameTree* tree) {
+    memset(tree, 0, sizeof(*tree));
+    tree->nodes = (GameTreeNode*)malloc(INITIAL_NODES * sizeof(GameTreeNode));
+    tree->pool = (char*)malloc(INITIAL_POOL);
+    tree->internTable = (uint32_t*)calloc(INITIAL_INTERN, sizeof(uint32_t));
+    if (!tree->nodes || !tree->pool || !tree->internTable) {
+        game_tree_free(tree);
+        return false;
+    }
+    tree->nodeCapacity = INITIAL_NODES;
+    tree->poolCapacity = INITIAL_POOL;
+    tree->internCapacity = INITIAL_INTERN;
+    reset_root(tree);
+    return true;
+}
+
+void game_tree_free(GameTree* tree) {
+    if (!tree) return;
+    free(tree->nodes);
+    free(tree->pool);
+    free(tree->internTable);
+    memset(tree, 0, sizeof(*tree));
+}
+
+void game_tree_clear(GameTree* tree) {
+    if (!tree || !tree->nodes) return;
+    if (!tree->internTable) {
+        // Compacted trees get their intern table back on reuse
+        tree->internTable = (uint32_t*)calloc(INITIAL_INTERN, sizeof(uint32_t));
+        tree->internCapacity = tree->internTable ? INITIAL_INTERN : 0;
+    }
+    reset_root(tree);
+}
+
+void game_tree_compact(GameTree* tree) {
+    if (!tree || !tree->nodes) return;
+    GameTreeNode* nodes = (GameTreeNode*)realloc(tree->nodes, (size_t)tree->nodeCount * sizeof(GameTreeNode));
+    if (nodes) {
+        tree->nodes = nodes;
+        tree->nodeCapacity = tree->nodeCount;
+    }
+    char* pool = (char*)realloc(tree->pool, tree->poolSize);
+    if (pool) {
+        tree->pool = pool;
+        tree->poolCapacity = tree->poolSize;
+    }
+    free(tree->internTable);
+    tree->internTable = NULL;
+    tree->internCapacity = 0;
+    tree->internCount = 0;
+}
+
+// --- String pool ---
+
+static bool pool_reserve(GameTree* tree, size_t extra) {
+    if (tree->poolSize + extra <= tree->poolCapacity) return true;
+    size_t cap = tree->poolCapacity ? tree->poolCapacity : INITIAL_POOL;
+    while (cap < tree->poolSize + extra) cap *= 2;
+    if (cap > UINT32_MAX) return false;
+    char* grown = (char*)realloc(tree->pool, cap);
+    if (!grown) return false;
+    tree->pool = grown;
+    tree->poolCapacity = (uint32_t)cap;
+    return true;
+}
+
+static bool intern_grow(GameTree* tree) {
+    uint32_t cap = tree->internCapacity * 2;
+    uint32_t* table = (uint32_t*)calloc(cap, sizeof(uint32_t));
+    if (!table) return false;
+    for (uint32_t i = 0; i < tree->internCapacity; i++) {
+        uint32_t off = tree->internTable[i];
+        if (!off) continue;
+        uint32_t slot = hash_text(tree->pool + off, strlen(tree->pool + off)) & (cap - 1);
+        while (table[slot]) slot = (slot + 1) & (cap - 1);
+        table[slot] = off;
+    }
+    free(tree->internTable);
+    tree->internTable = table;
+    tree->internCapacity = cap;
+    return true;
+}
+
+// Offset of text in the pool, added if new. 0 for empty text or on failure.
+static uint32_t pool_intern(GameTree* tree, const char* text, size_t length) {
+    if (length == 0) return 0;
+
+    uint32_t* slotp = NULL;
+    if (tree->internTable) {
+        if ((tree->internCount + 1) * 4 > tree->internCapacity * 3 && !intern_grow(tree)) return 0;
+        uint32_t mask = tree->internCapacity - 1;
+        uint32_t slot = hash_text(text, length) & mask;
+        while (tree->internTable[slot]) {
+            const char* s = tree->pool + tree->internTable[slot];
+            if (strncmp(s, text, length) == 0 && s[length] == '\0') return tree->internTable[slot];
+            slot = (slot + 1) & mask;
+        }
+        slotp = &tree->internTable[slot];
+    }
+
+    if (!pool_reserve(tree, length + 1)) return 0;
+    uint32_t off = tree->poolSize;
+    memcpy(tree->pool + off, text, length);
+    tree->pool[off + length] = '\0';
+    tree->poolSize += (uint32_t)length + 1;
+    if (slotp) {
+        *slotp = off;
+        tree->internCount++;
+    }
+    return off;
+}
+
+// --- Building ---
+
+int32_t game_tree_add_move(GameTree* tree, int32_t parent, PackedMove move) {
+    if (!tree || parent < 0 || parent >= tree->nodeCount) return GAME_TREE_NONE;
+
+    int32_t last = GAME_TREE_NONE;
+    for (int32_t c = tree->nodes[parent].firstChild; c != GAME_TREE_NONE; c = tree->nodes[c].nextSibling) {
+        if (tree->nodes[c].move == move) return c;
+        last = c;
+    }
+
+    if (tree->nodeCount == tree->nodeCapacity) {
+        int32_t cap = tree->nodeCapacity ? tree->nodeCapacity * 2 : INITIAL_NODES;
+        GameTreeNode* grown = (GameTreeNode*)realloc(tree->nodes, (size_t)cap * sizeof(GameTreeNode));
+        if (!grown) return GAME_TREE_NONE;
+        tree->nodes = grown;
+        tree->nodeCapacity = cap;
+    }
+
+    int32_t id = tree->nodeCount++;
+    tree->nodes[id] = (GameTreeNode){move, (uint16_t)(tree->nodes[parent].ply + 1), {0, 0},
+                                     parent, GAME_TREE_NONE, GAME_TREE_NONE, 0};
+    if (last == GAME_TREE_NONE) tree->nodes[parent].firstChild = id;
+    else tree->nodes[last].nextSibling = id;
+    return id;
+}
+
+bool game_tree_append_comment(GameTree* tree, int32_t node, const char* text, size_t length) {
+    if (!tree || node < 0 || node >= tree->nodeCount || !text) return false;
+
+    // Trim, so "{ Good move }" and "{Good move}" intern to the same string
+    while (length > 0 && (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n')) {
+        text++;
+        length--;
+    }
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t' ||
+                          text[length - 1] == '\r' || text[length - 1] == '\n')) {
+        length--;
+    }
+    if (length == 0) return true;
+
+    uint32_t old = tree->nodes[node].comment;
+    uint32_t off;
+    if (old == 0) {
+        off = pool_intern(tree, text, length);
+    } else {
+        size_t oldLen = strlen(tree->pool + old);
+        char* joined = (char*)malloc(oldLen + 1 + length);
+        if (!joined) return false;
+        memcpy(joined, tree->pool + old, oldLen);
+        joined[oldLen] = ' ';
+        memcpy(joined + oldLen + 1, text, length);
+        off = pool_intern(tree, joined, oldLen + 1 + length);
+        free(joined);
+    }
+    if (off == 0) return false;
+    tree->nodes[node].comment = off;
+    return true;
+}
+
+const char* game_tree_comment(const GameTree* tree, int32_t node) {
+    const GameTreeNode* n = tree ? game_tree_node(tree, node) : NULL;
+    return (n && n->comment) ? tree->pool + n->comment : NULL;
+}
+
+void game_tree_add_nag(GameTree* tree, int32_t node, uint8_t nag) {
+    if (!tree || node < 0 || node >= tree->nodeCount || nag == 0) return;
+    uint8_t* nags = tree->nodes[node].nags;
+    for (int i = 0; i < GAME_TREE_MAX_NAGS; i++) {
+        if (nags[i] == nag) return;
+        if (nags[i] == 0) {
+            nags[i] = nag;
+            return;
+        }
+    }
+}
+
+// --- Navigation ---
+
+int32_t game_tree_main_child(const GameTree* tree, int32_t node) {
+    const GameTreeNode* n = game_tree_node(tree, node);
+    return n ? n->firstChild : GAME_TREE_NONE;
+}
+
+int32_t game_tree_main_line_node(const GameTree* tree, int ply) {
+    int32_t node = GAME_TREE_ROOT;
+    for (int i = 0; i < ply && node != GAME_TREE_NONE; i++) node = game_tree_main_child(tree, node);
+    return node;
+}
+
+int game_tree_child_count(const GameTree* tree, int32_t node) {
+    int count = 0;
+    for (int32_t c = game_tree_main_child(tree, node); c != GAME_TREE_NONE; c = tree->nodes[c].nextSibling) count++;
+    return count;
+}
+
+int game_tree_path(const GameTree* tree, int32_t node, PackedMove* moves, int max) {
+    const GameTreeNode* n = game_tree_node(tree, node);
+    if (!n) return 0;
+    int plies = n->ply;
+    // Walk up from the node, filling the array from the back
+    for (int32_t c = node; c != GAME_TREE_ROOT && c != GAME_TREE_NONE; c = tree->nodes[c].parent) {
+        int index = tree->nodes[c].ply - 1;
+        if (moves && index < max) moves[index] = tree->nodes[c].move;
+    }
+    return plies;
+}
+
+bool game_tree_path_uci(const GameTree* tree, int32_t node, char* buf, size_t buf_size) {
+    if (!buf || buf_size == 0) return false;
+    buf[0] = '\0';
+    const GameTreeNode* n = game_tree_node(tree, node);
+    if (!n) return false;
+    if (n->ply == 0) return true;
+
+    PackedMove* moves = (PackedMove*)malloc((size_t)n->ply * sizeof(PackedMove));
+    if (!moves) return false;
+    game_tree_path(tree, node, moves, n->ply);
+
+    size_t len = 0;
+    bool ok = true;
+    for (int i = 0; i < n->ply && ok; i++) {
+        char uci[8];
+        packed_move_to_uci(moves[i], uci);
+        int written = snprintf(buf + len, buf_size - len, "%s%s", i ? " " : "", uci);
+        ok = written > 0 && (size_t)written < buf_size - len;
+        if (ok) len += (size_t)written;
+    }
+    free(moves);
+    if (!ok) buf[0] = '\0';
+    return ok;
+}
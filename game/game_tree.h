@@ -0,0 +1,79 @@
+#ifndef GAME_TREE_H
+#define GAME_TREE_H
+
+#include "types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Annotated game tree: the main line plus side lines, comments and NAGs.
+// Nodes live in one flat array and link by index; strings are interned in
+// one pool. A tree owns three heap blocks whatever its size, so many
+// annotated games can stay resident without per-node allocations.
+
+#define GAME_TREE_NONE (-1)     // Null node index
+#define GAME_TREE_ROOT 0        // Start position (no move)
+#define GAME_TREE_MAX_NAGS 2    // NAGs kept per move ($1 = !, $2 = ?, ...)
+
+typedef struct {
+    PackedMove move;            // Move into this node (PACKED_MOVE_NONE at the root)
+    uint16_t ply;               // Half-moves from the start position
+    uint8_t nags[GAME_TREE_MAX_NAGS]; // 0 = unused
+    int32_t parent;
+    int32_t firstChild;         // Main continuation; its siblings are the alternatives
+    int32_t nextSibling;
+    uint32_t comment;           // Pool offset of the comment after the move, 0 if none
+} GameTreeNode;
+
+typedef struct {
+    GameTreeNode* nodes;
+    int32_t nodeCount;
+    int32_t nodeCapacity;
+
+    char* pool;                 // NUL-separated strings; offset 0 is ""
+    uint32_t poolSize;
+    uint32_t poolCapacity;
+
+    uint32_t* internTable;      // Open-addressed pool offsets (0 = empty slot), NULL once compacted
+    uint32_t internCapacity;
+    uint32_t internCount;
+} GameTree;
+
+// A tree holding only the root. Returns false if out of memory.
+bool game_tree_init(GameTree* tree);
+void game_tree_free(GameTree* tree);
+// Drop everything but the root, keeping the buffers for reuse
+void game_tree_clear(GameTree* tree);
+// Shrink buffers to fit and drop the intern table (the tree stays usable)
+void game_tree_compact(GameTree* tree);
+
+// Child of parent reached by move. An existing child with the same move is
+// reused; otherwise the new node becomes the last alternative.
+// Returns GAME_TREE_NONE if out of memory.
+int32_t game_tree_add_move(GameTree* tree, int32_t parent, PackedMove move);
+
+// Comments. Appending to a node that already has one joins them with a space.
+bool game_tree_append_comment(GameTree* tree, int32_t node, const char* text, size_t length);
+const char* game_tree_comment(const GameTree* tree, int32_t node);
+// Record a NAG (1..255). Extra NAGs beyond GAME_TREE_MAX_NAGS are dropped.
+void game_tree_add_nag(GameTree* tree, int32_t node, uint8_t nag);
+
+// Navigation
+static inline const GameTreeNode* game_tree_node(const GameTree* tree, int32_t node) {
+    return (node >= 0 && node < tree->nodeCount) ? &tree->nodes[node] : NULL;
+}
+// Main-line successor, GAME_TREE_NONE at the end of a line
+int32_t game_tree_main_child(const GameTree* tree, int32_t node);
+// Node reached from the root by following the main line for ply half-moves
+int32_t game_tree_main_line_node(const GameTree* tree, int ply);
+// Number of children (1 + side lines branching here)
+int game_tree_child_count(const GameTree* tree, int32_t node);
+
+// Moves from the root to node, in order. Returns the ply count; at most
+// max moves are written.
+int game_tree_path(const GameTree* tree, int32_t node, PackedMove* moves, int max);
+// Same path as a space-separated UCI string (replay loads lines this way).
+// Returns false if it does not fit.
+bool game_tree_path_uci(const GameTree* tree, int32_t node, char* buf, size_t buf_size);
+
+#endif // GAME_TREE_H
@@ -1,7 +1,7 @@
 #include "gamelogic.h"
-#include "piece.h"
 #include "move.h"
 #include "zobrist.h"
+#include "bitboard.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -36,56 +36,62 @@ int64_t get_monotonic_time_ms(void) {
 
 static bool debug_mode = false;
 
-// Simple stack implementation for move history
-typedef struct StackNode {
-    void* data;
-    struct StackNode* next;
-} StackNode;
-
-typedef struct {
-    StackNode* top;
-    int size;
-} Stack;
-
-static Stack* stack_create(void) {
-    Stack* s = (Stack*)malloc(sizeof(Stack));
-    if (s) {
-        s->top = NULL;
-        s->size = 0;
-    }
-    return s;
+// Reserve the next ply of the move history, growing both arrays when full.
+// The caller fills the Ply and its clockHistory slot.
+static Ply* history_push(GameLogic* logic) {
+    if (logic->historyCount >= logic->historyCapacity) {
+        int capacity = (logic->historyCapacity == 0) ? 128 : logic->historyCapacity * 2;
+        Ply* grown = (Ply*)realloc(logic->history, (size_t)capacity * sizeof(Ply));
+        if (!grown) return NULL;
+        logic->history = grown;
+        PlyClock* clocks = (PlyClock*)realloc(logic->clockHistory, (size_t)capacity * sizeof(PlyClock));
+        if (!clocks) return NULL;
+        logic->clockHistory = clocks;
+        logic->historyCapacity = capacity;
+    }
+    Ply* ply = &logic->history[logic->historyCount++];
+    ply->san[0] = '\0'; // Filled by gamelogic_perform_move
+    return ply;
 }
 
-static void stack_push(Stack* s, void* data) {
-    StackNode* node = (StackNode*)malloc(sizeof(StackNode));
-    if (node) {
-        node->data = data;
-        node->next = s->top;
-        s->top = node;
-        s->size++;
-    }
+// Drop the redo stack, and the snapshots that only it reached. A snapshot
+// at historyCount itself was taken on the old line, so it goes too.
+static void history_drop_redo(GameLogic* logic) {
+    logic->redoCount = 0;
+    int keep = (logic->historyCount + HISTORY_SNAPSHOT_INTERVAL - 1) / HISTORY_SNAPSHOT_INTERVAL;
+    if (logic->snapshotCount > keep) logic->snapshotCount = keep;
 }
 
-static void* stack_pop(Stack* s) {
-    if (!s || !s->top) return NULL;
-    StackNode* node = s->top;
-    void* data = node->data;
-    s->top = node->next;
-    free(node);
-    s->size--;
-    return data;
+// Keep the current position if it falls on a snapshot ply not yet stored
+static void snapshot_note(GameLogic* logic) {
+    if (logic->historyCount % HISTORY_SNAPSHOT_INTERVAL != 0) return;
+    int k = logic->historyCount / HISTORY_SNAPSHOT_INTERVAL;
+    if (k < logic->snapshotCount && logic->snapshots[k].valid) return;
+    if (k >= logic->snapshotCapacity) {
+        int capacity = (logic->snapshotCapacity == 0) ? 16 : logic->snapshotCapacity * 2;
+        while (capacity <= k) capacity *= 2;
+        HistorySnapshot* grown = (HistorySnapshot*)realloc(logic->snapshots, (size_t)capacity * sizeof(HistorySnapshot));
+        if (!grown) return; // Navigation just replays further
+        logic->snapshots = grown;
+        logic->snapshotCapacity = capacity;
+    }
+    while (logic->snapshotCount <= k) logic->snapshots[logic->snapshotCount++].valid = false;
+    gamelogic_create_snapshot(logic, &logic->snapshots[k].position);
+    logic->snapshots[k].valid = true;
 }
 
-static void stack_free(Stack* s) {
-    if (!s) return;
-    while (stack_pop(s) != NULL) {
-        // Freeing happens in caller
-    }
-    free(s);
+// Expand a recorded ply into the caller-facing Move
+static Move move_from_ply(const Ply* ply) {
+    Move m;
+    move_unpack(&m, ply->move, (Player)ply->undo.mover);
+    m.movedPieceType = ply->undo.movedPieceType;
+    m.capturedPieceType = ply->undo.capturedPieceType;
+    return m;
 }
 
 // External cache management (defined in gamelogic_movegen.c)
 extern void gamelogic_clear_cache(GameLogic* logic);
+extern void gamelogic_free_cache(GameLogic* logic);
 
 // Simple list for PieceType (for captured pieces)
 typedef struct PieceTypeNode {
@@ -121,8 +127,17 @@ static void piece_type_list_clear(PieceTypeList* list) {
     list->size = 0;
 }
 
+// Rooks on the h- and a-files castle, as in standard chess
+static void set_standard_castling_rooks(GameLogic* logic) {
+    for (int p = 0; p < 2; p++) {
+        logic->castlingRookCol[p][0] = 7;
+        logic->castlingRookCol[p][1] = 0;
+    }
+}
+
 // Create new GameLogic
 GameLogic* gamelogic_create(void) {
+    bitboard_init();
     GameLogic* logic = (GameLogic*)calloc(1, sizeof(GameLogic));
     if (logic) {
         logic->gameMode = GAME_MODE_PVC;
@@ -132,6 +147,7 @@ GameLogic* gamelogic_create(void) {
         snprintf(logic->statusMessage, sizeof(logic->statusMessage), "White's Turn");
         logic->enPassantCol = -1;
         logic->castlingRights = 0xF; // All rights
+        set_standard_castling_rooks(logic);
         logic->halfmoveClock = 0;
         logic->fullmoveNumber = 1;
 
@@ -143,7 +159,14 @@ GameLogic* gamelogic_create(void) {
         logic->started_at_ms = 0;
         logic->turn_start_time = 0;
 
-        logic->moveHistory = stack_create();
+        logic->history = NULL;
+        logic->clockHistory = NULL;
+        logic->historyCount = 0;
+        logic->redoCount = 0;
+        logic->historyCapacity = 0;
+        logic->snapshots = NULL;
+        logic->snapshotCount = 0;
+        logic->snapshotCapacity = 0;
 
         logic->isSimulation = false;
         logic->updateCallback = NULL;
@@ -164,24 +187,13 @@ GameLogic* gamelogic_create(void) {
 void gamelogic_free(GameLogic* logic) {
     if (!logic) return;
     
-    // Free board pieces
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-            }
-        }
-    }
-    
     // Free move history
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (moveStack) {
-        while (moveStack->top) {
-            Move* m = (Move*)stack_pop(moveStack);
-            move_free(m);
-        }
-        stack_free(moveStack);
-    }
+    free(logic->history);
+    free(logic->clockHistory);
+    logic->history = NULL;
+    logic->clockHistory = NULL;
+    free(logic->snapshots);
+    logic->snapshots = NULL;
 
     if (logic->think_times) {
         free(logic->think_times);
@@ -190,49 +202,130 @@ void gamelogic_free(GameLogic* logic) {
        
     
     // Free cache
-    gamelogic_clear_cache(logic);
+    gamelogic_free_cache(logic);
     
     free(logic);
 }
 
+// --- Board maintenance ---
+// Every board write inside the rules engine goes through these so the
+// masks and the piece part of currentHash never drift from the mailbox.
+
+static void bb_put_piece(GameLogic* logic, int sq, PieceType type, Player owner) {
+    Bitboard bit = BB_SQUARE(sq);
+    logic->pieceBB[type] |= bit;
+    logic->colorBB[owner] |= bit;
+    logic->mailbox[sq] = SQUARE_ENCODE(type, owner);
+    logic->currentHash ^= zobrist_piece_key(type, owner, sq);
+}
+
+static void bb_remove_piece(GameLogic* logic, int sq) {
+    uint8_t val = logic->mailbox[sq];
+    if (val == SQUARE_EMPTY) return;
+    Bitboard bit = BB_SQUARE(sq);
+    logic->pieceBB[SQUARE_TYPE(val)] &= ~bit;
+    logic->colorBB[SQUARE_OWNER(val)] &= ~bit;
+    logic->mailbox[sq] = SQUARE_EMPTY;
+    logic->currentHash ^= zobrist_piece_key(SQUARE_TYPE(val), SQUARE_OWNER(val), sq);
+}
+
+static void bb_move_piece(GameLogic* logic, int from, int to) {
+    uint8_t val = logic->mailbox[from];
+    if (val == SQUARE_EMPTY) return;
+    Bitboard fromTo = BB_SQUARE(from) | BB_SQUARE(to);
+    PieceType type = SQUARE_TYPE(val);
+    Player owner = SQUARE_OWNER(val);
+    logic->pieceBB[type] ^= fromTo;
+    logic->colorBB[owner] ^= fromTo;
+    logic->mailbox[to] = val;
+    logic->mailbox[from] = SQUARE_EMPTY;
+    logic->currentHash ^= zobrist_piece_key(type, owner, from) ^ zobrist_piece_key(type, owner, to);
+}
+
+// Side, castling and en passant part of the hash. make/undo XOR this out
+// before touching the position and back in afterwards.
+static uint64_t hash_state_keys(GameLogic* logic) {
+    uint64_t keys = zobrist_castling_key(logic->castlingRights) ^ zobrist_ep_key(logic);
+    if (logic->turn == PLAYER_BLACK) keys ^= zobrist_side_key();
+    return keys;
+}
+
+// Rebuild the masks from the mailbox alone (no hashing)
+static void bitboards_from_mailbox(GameLogic* logic) {
+    memset(logic->pieceBB, 0, sizeof(logic->pieceBB));
+    memset(logic->colorBB, 0, sizeof(logic->colorBB));
+    for (int sq = 0; sq < 64; sq++) {
+        uint8_t val = logic->mailbox[sq];
+        if (val == SQUARE_EMPTY) continue;
+        logic->pieceBB[SQUARE_TYPE(val)] |= BB_SQUARE(sq);
+        logic->colorBB[SQUARE_OWNER(val)] |= BB_SQUARE(sq);
+    }
+}
+
+void gamelogic_sync_bitboards(GameLogic* logic) {
+    if (!logic) return;
+    bitboards_from_mailbox(logic);
+    logic->currentHash = zobrist_compute(logic);
+}
+
+// One shared Piece per mailbox code, so lookups hand out stable pointers
+// without allocating
+static const Piece square_pieces[16] = {
+    [SQUARE_ENCODE(PIECE_KING, PLAYER_WHITE)]   = { PIECE_KING, PLAYER_WHITE },
+    [SQUARE_ENCODE(PIECE_KING, PLAYER_BLACK)]   = { PIECE_KING, PLAYER_BLACK },
+    [SQUARE_ENCODE(PIECE_QUEEN, PLAYER_WHITE)]  = { PIECE_QUEEN, PLAYER_WHITE },
+    [SQUARE_ENCODE(PIECE_QUEEN, PLAYER_BLACK)]  = { PIECE_QUEEN, PLAYER_BLACK },
+    [SQUARE_ENCODE(PIECE_ROOK, PLAYER_WHITE)]   = { PIECE_ROOK, PLAYER_WHITE },
+    [SQUARE_ENCODE(PIECE_ROOK, PLAYER_BLACK)]   = { PIECE_ROOK, PLAYER_BLACK },
+    [SQUARE_ENCODE(PIECE_BISHOP, PLAYER_WHITE)] = { PIECE_BISHOP, PLAYER_WHITE },
+    [SQUARE_ENCODE(PIECE_BISHOP, PLAYER_BLACK)] = { PIECE_BISHOP, PLAYER_BLACK },
+    [SQUARE_ENCODE(PIECE_KNIGHT, PLAYER_WHITE)] = { PIECE_KNIGHT, PLAYER_WHITE },
+    [SQUARE_ENCODE(PIECE_KNIGHT, PLAYER_BLACK)] = { PIECE_KNIGHT, PLAYER_BLACK },
+    [SQUARE_ENCODE(PIECE_PAWN, PLAYER_WHITE)]   = { PIECE_PAWN, PLAYER_WHITE },
+    [SQUARE_ENCODE(PIECE_PAWN, PLAYER_BLACK)]   = { PIECE_PAWN, PLAYER_BLACK },
+};
+
+const Piece* gamelogic_get_piece(GameLogic* logic, int r, int c) {
+    if (!logic || r < 0 || r > 7 || c < 0 || c > 7) return NULL;
+    uint8_t val = logic->mailbox[r * 8 + c];
+    return val == SQUARE_EMPTY ? NULL : &square_pieces[val];
+}
+
+void gamelogic_clear_board(GameLogic* logic) {
+    if (!logic) return;
+    memset(logic->pieceBB, 0, sizeof(logic->pieceBB));
+    memset(logic->colorBB, 0, sizeof(logic->colorBB));
+    memset(logic->mailbox, 0, sizeof(logic->mailbox));
+    logic->currentHash = zobrist_compute(logic);
+    logic->positionVersion++;
+}
+
+void gamelogic_place_piece(GameLogic* logic, int r, int c, PieceType type, Player owner) {
+    if (!logic || r < 0 || r > 7 || c < 0 || c > 7) return;
+    if (type < PIECE_KING || type > PIECE_PAWN) return;
+    if (owner != PLAYER_WHITE && owner != PLAYER_BLACK) return;
+    int sq = r * 8 + c;
+    bb_remove_piece(logic, sq);
+    bb_put_piece(logic, sq, type, owner);
+    logic->positionVersion++;
+}
+
 // Setup initial board
 static void setup_board(GameLogic* logic) {
-    // Clear board
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    static const PieceType backRank[8] = {
+        PIECE_ROOK, PIECE_KNIGHT, PIECE_BISHOP, PIECE_QUEEN,
+        PIECE_KING, PIECE_BISHOP, PIECE_KNIGHT, PIECE_ROOK
+    };
+
+    gamelogic_clear_board(logic);
     
-    // Setup pawns
     for (int i = 0; i < 8; i++) {
-        logic->board[1][i] = piece_create(PIECE_PAWN, PLAYER_BLACK);
-        logic->board[6][i] = piece_create(PIECE_PAWN, PLAYER_WHITE);
-    }
-    
-    // Setup back ranks
-    // Black pieces (row 0)
-    logic->board[0][0] = piece_create(PIECE_ROOK, PLAYER_BLACK);
-    logic->board[0][1] = piece_create(PIECE_KNIGHT, PLAYER_BLACK);
-    logic->board[0][2] = piece_create(PIECE_BISHOP, PLAYER_BLACK);
-    logic->board[0][3] = piece_create(PIECE_QUEEN, PLAYER_BLACK);
-    logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK);
-    logic->board[0][5] = piece_create(PIECE_BISHOP, PLAYER_BLACK);
-    logic->board[0][6] = piece_create(PIECE_KNIGHT, PLAYER_BLACK);
-    logic->board[0][7] = piece_create(PIECE_ROOK, PLAYER_BLACK);
-    
-    // White pieces (row 7)
-    logic->board[7][0] = piece_create(PIECE_ROOK, PLAYER_WHITE);
-    logic->board[7][1] = piece_create(PIECE_KNIGHT, PLAYER_WHITE);
-    logic->board[7][2] = piece_create(PIECE_BISHOP, PLAYER_WHITE);
-    logic->board[7][3] = piece_create(PIECE_QUEEN, PLAYER_WHITE);
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[7][5] = piece_create(PIECE_BISHOP, PLAYER_WHITE);
-    logic->board[7][6] = piece_create(PIECE_KNIGHT, PLAYER_WHITE);
-    logic->board[7][7] = piece_create(PIECE_ROOK, PLAYER_WHITE);
+        // Black pieces (rows 0-1), White pieces (rows 6-7)
+        gamelogic_place_piece(logic, 0, i, backRank[i], PLAYER_BLACK);
+        gamelogic_place_piece(logic, 1, i, PIECE_PAWN, PLAYER_BLACK);
+        gamelogic_place_piece(logic, 6, i, PIECE_PAWN, PLAYER_WHITE);
+        gamelogic_place_piece(logic, 7, i, backRank[i], PLAYER_WHITE);
+    }
 }
 
 // Reset game
@@ -263,21 +356,18 @@ void gamelogic_reset(GameLogic* logic) {
     
     logic->enPassantCol = -1;
     logic->castlingRights = 0xF;
+    set_standard_castling_rooks(logic);
+    logic->chess960 = false;
     logic->halfmoveClock = 0;
     logic->fullmoveNumber = 1;
     
     // Set standard start FEN
     snprintf(logic->start_fen, sizeof(logic->start_fen), "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
     
-    // Clear move history
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (moveStack) {
-        while (moveStack->top) {
-            Move* m = (Move*)stack_pop(moveStack);
-            move_free(m);
-        }
-    }
-    
+    // Clear move history (capacity is kept for the next game)
+    logic->historyCount = 0;
+    logic->redoCount = 0;
+    logic->snapshotCount = 0;
     
     // Clear cache
     gamelogic_clear_cache(logic);
@@ -327,22 +417,7 @@ void gamelogic_reset(GameLogic* logic) {
 void gamelogic_create_snapshot(GameLogic* logic, PositionSnapshot* snap) {
     if (!logic || !snap) return;
     
-    memset(snap->board, 0, 64);
-    snap->hasMovedMask = 0;
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            int sq = r * 8 + c;
-            Piece* p = logic->board[r][c];
-            if (p) {
-                snap->board[sq] = (uint8_t)(((p->type + 1) << 1) | p->owner);
-                if (p->hasMoved) {
-                    snap->hasMovedMask |= (1ULL << sq);
-                }
-            } else {
-                snap->board[sq] = 0;
-            }
-        }
-    }
+    memcpy(snap->board, logic->mailbox, 64);
     
     snap->turn = logic->turn;
     snap->castlingRights = logic->castlingRights;
@@ -355,28 +430,10 @@ void gamelogic_create_snapshot(GameLogic* logic, PositionSnapshot* snap) {
 void gamelogic_restore_snapshot(GameLogic* logic, const PositionSnapshot* snap) {
     if (!logic || !snap) return;
     
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            if (logic->board[r][c]) {
-                piece_free(logic->board[r][c]);
-                logic->board[r][c] = NULL;
-            }
-        }
-    }
-    
-    for (int i = 0; i < 64; i++) {
-        uint8_t val = snap->board[i];
-        if (val != 0) {
-            PieceType type = (PieceType)((val >> 1) - 1);
-            Player owner = (Player)(val & 1);
-            int r = i / 8;
-            int c = i % 8;
-            logic->board[r][c] = piece_create(type, owner);
-            if (logic->board[r][c]) {
-                logic->board[r][c]->hasMoved = (snap->hasMovedMask & (1ULL << i)) != 0;
-            }
-        }
-    }
+    // Plain copies: the snapshot carries the hash, so nothing is recomputed
+    memcpy(logic->mailbox, snap->board, 64);
+    bitboards_from_mailbox(logic);
+    logic->positionVersion++;
     
     logic->turn = snap->turn;
     logic->castlingRights = snap->castlingRights;
@@ -426,6 +483,23 @@ void gamelogic_update_game_state_internal(GameLogic* logic, bool skipExpensiveCh
             snprintf(logic->statusMessage, sizeof(logic->statusMessage), "Stalemate! Draw.");
             return;
         }
+        
+        // Automatic draws (mate on the final move takes precedence, checked above)
+        if (gamelogic_is_insufficient_material(logic)) {
+            logic->isGameOver = true;
+            snprintf(logic->statusMessage, sizeof(logic->statusMessage), "Insufficient material! Draw.");
+            return;
+        }
+        if (gamelogic_is_fifty_move_draw(logic)) {
+            logic->isGameOver = true;
+            snprintf(logic->statusMessage, sizeof(logic->statusMessage), "Fifty-move rule! Draw.");
+            return;
+        }
+        if (gamelogic_is_threefold_repetition(logic)) {
+            logic->isGameOver = true;
+            snprintf(logic->statusMessage, sizeof(logic->statusMessage), "Threefold repetition! Draw.");
+            return;
+        }
     }
     
     // Check for regular check (always safe)
@@ -470,8 +544,10 @@ static void make_move_internal(GameLogic* logic, Move* move);
 // Clock Interface
 // Clock Interface declaration removed from here to avoid duplication
 
-static Move* undo_move_internal(GameLogic* logic, bool free_move);
-static char get_fen_char(Piece* p);
+static void undo_move_internal(GameLogic* logic);
+static char get_fen_char(PieceType type);
+static void san_disambiguation(GameLogic* logic, int from, int to, char* out);
+static void san_format(GameLogic* logic, const Move* move, const char* disambiguation, char* san, size_t san_size);
 // External safety checks (defined in gamelogic_safety.c)
 extern bool gamelogic_is_square_safe(GameLogic* logic, int r, int c, Player p);
 extern bool gamelogic_is_in_check(GameLogic* logic, Player player);
@@ -491,21 +567,35 @@ bool gamelogic_perform_move(GameLogic* logic, Move* move) {
         return false;
     }
     
-    int r1 = move->from_sq / 8;
-    int c1 = move->from_sq % 8;
-    Piece* movingPiece = logic->board[r1][c1];
-    if (!movingPiece) {
+    uint8_t movingPiece = logic->mailbox[move->from_sq];
+    if (movingPiece == SQUARE_EMPTY) {
 
         return false;
     }
     
     // Safety check: ensure only the mover can move their own pieces
-    if (movingPiece->owner != logic->turn) {
+    if (SQUARE_OWNER(movingPiece) != logic->turn) {
 
         return false;
     }
     
+    snapshot_note(logic);
+    int plyIndex = logic->historyCount;
+    PackedMove redoNext = (logic->redoCount > 0) ? logic->history[plyIndex].move : PACKED_MOVE_NONE;
+
+    // SAN is rendered once, here, and kept with the ply for the move list
+    char disambiguation[3];
+    san_disambiguation(logic, move->from_sq, move->to_sq, disambiguation);
     make_move_internal(logic, move);
+    if (logic->historyCount > plyIndex) {
+        Ply* ply = &logic->history[plyIndex];
+        san_format(logic, move, disambiguation, ply->san, sizeof(ply->san));
+        // Replaying the next undone move keeps the rest of the line
+        if (redoNext != PACKED_MOVE_NONE && ply->move == redoNext) logic->redoCount--;
+        else history_drop_redo(logic);
+    } else {
+        history_drop_redo(logic);
+    }
 
     // Time Tracking Logic
     int64_t now = get_monotonic_time_ms();
@@ -548,16 +638,14 @@ bool gamelogic_perform_move(GameLogic* logic, Move* move) {
     // However, logic->clock is decremented by tick loop continuously, so saved time = (Start - Delta).
     // Undo restores this saved time, so we lose Delta.
     // We MUST add Delta back to the saved state to ensure Undo restores the time *at start of turn*.
-    if (!logic->isSimulation && logic->moveHistory) {
-         Stack* s = (Stack*)logic->moveHistory;
-         if (s->top) {
-             Move* recorded = (Move*)s->top->data;
-             // Check who moved (the move structure already has it, or infer from logic->turn which just swapped)
-             // logic->turn is now Opponent. So recorded->mover matches Previous Turn.
-             if (recorded->mover == PLAYER_WHITE) {
-                 recorded->prevWhiteTimeMs += delta;
+    if (!logic->isSimulation) {
+         if (logic->historyCount > 0) {
+             PlyClock* recorded = &logic->clockHistory[logic->historyCount - 1];
+             // logic->turn is now Opponent, so the mover is the previous turn.
+             if (logic->history[logic->historyCount - 1].undo.mover == PLAYER_WHITE) {
+                 recorded->whiteTimeMs += delta;
              } else {
-                 recorded->prevBlackTimeMs += delta;
+                 recorded->blackTimeMs += delta;
              }
          }
     }
@@ -580,7 +668,14 @@ void gamelogic_undo_move(GameLogic* logic) {
         logic->think_time_count--;
     }
     
-    undo_move_internal(logic, true);
+    if (logic->historyCount > 0) {
+        // The undone ply stays in place as the top of the redo stack
+        if (logic->redoCount == 0) {
+            logic->redoTipClock = (PlyClock){ logic->clock.white_time_ms, logic->clock.black_time_ms };
+        }
+        undo_move_internal(logic);
+        logic->redoCount++;
+    }
     if (!logic->isSimulation) {
         gamelogic_update_game_state(logic);
         if (logic->updateCallback) logic->updateCallback();
@@ -588,64 +683,210 @@ void gamelogic_undo_move(GameLogic* logic) {
     logic->cachedPieceRow = -1;
 }
 
-// Simulate a move and check if the resulting position is safe for the given player
-bool gamelogic_simulate_move_and_check_safety(GameLogic* logic, Move* m, Player p) {
-    if (!logic || !m) return false;
-    
-    int r1 = m->from_sq / 8, c1 = m->from_sq % 8;
-    int r2 = m->to_sq / 8, c2 = m->to_sq % 8;
-    
-    Piece* saved_start = logic->board[r1][c1];
-    Piece* saved_end = logic->board[r2][c2];
-    Piece* saved_ep = NULL;
-    Piece* saved_rook_start = NULL;
-    Piece* saved_rook_dest = NULL;
-    
-    int rookStartCol = -1, rookDestCol = -1;
-    bool is_ep_capture = false;
-    
-    Player saved_turn = logic->turn;
-    int8_t saved_enPassantCol = (int8_t)logic->enPassantCol;
-    uint8_t saved_castling = logic->castlingRights;
-    
-    // Execute move directly on board (pointers only, no copies to avoid leaks unless needed)
-    Piece* movingPiece = logic->board[r1][c1];
-    if (!movingPiece) return false;
-    
-    logic->board[r2][c2] = movingPiece;
-    logic->board[r1][c1] = NULL;
+// Play the next ply of the redo stack again, leaving its record as it was
+static void redo_move_internal(GameLogic* logic) {
+    int index = logic->historyCount;
+    Ply ply = logic->history[index];
+    PlyClock clockBefore = logic->clockHistory[index];
+    Move m = move_from_ply(&ply);
+    make_move_internal(logic, &m);
+    logic->history[index] = ply;
+    logic->clockHistory[index] = clockBefore;
+}
+
+void gamelogic_jump_to_ply(GameLogic* logic, int ply) {
+    if (!logic) return;
+    int start = logic->historyCount;
+    int end = start + logic->redoCount;
+    if (ply < 0) ply = 0;
+    if (ply > end) ply = end;
+    if (ply == start) return;
+
+    if (logic->redoCount == 0) {
+        logic->redoTipClock = (PlyClock){ logic->clock.white_time_ms, logic->clock.black_time_ms };
+    }
+
+    // Clocks are set once at the end, not pressed or restored per ply
+    bool old_sim = logic->isSimulation;
+    logic->isSimulation = true;
+
+    // Start from the nearest stored position at or before the target when
+    // that is closer than walking from here
+    int k = ply / HISTORY_SNAPSHOT_INTERVAL;
+    if (k >= logic->snapshotCount) k = logic->snapshotCount - 1;
+    while (k >= 0 && !logic->snapshots[k].valid) k--;
+    int base = k * HISTORY_SNAPSHOT_INTERVAL;
+    if (k >= 0 && ply - base < abs(ply - start)) {
+        const PositionSnapshot* snap = &logic->snapshots[k].position;
+        memcpy(logic->mailbox, snap->board, 64);
+        bitboards_from_mailbox(logic);
+        logic->turn = snap->turn;
+        logic->castlingRights = snap->castlingRights;
+        logic->enPassantCol = snap->enPassantCol;
+        logic->halfmoveClock = snap->halfmoveClock;
+        logic->fullmoveNumber = snap->fullmoveNumber;
+        logic->currentHash = snap->zobristHash;
+        logic->historyCount = base;
+        logic->positionVersion++;
+    }
+
+    while (logic->historyCount > ply) {
+        undo_move_internal(logic);
+        snapshot_note(logic);
+    }
+    while (logic->historyCount < ply) {
+        redo_move_internal(logic);
+        snapshot_note(logic);
+    }
+    logic->redoCount = end - ply;
+    logic->isSimulation = old_sim;
+
+    // Think times are kept for undone plies, like the plies themselves
+    logic->think_time_count += ply - start;
+    if (logic->think_time_count < 0) logic->think_time_count = 0;
+    if (logic->think_time_count > logic->think_time_capacity) logic->think_time_count = logic->think_time_capacity;
+
+    if (!logic->isSimulation) {
+        PlyClock clock = (ply < end) ? logic->clockHistory[ply] : logic->redoTipClock;
+        logic->clock.white_time_ms = clock.whiteTimeMs;
+        logic->clock.black_time_ms = clock.blackTimeMs;
+        logic->clock.flagged_player = PLAYER_NONE;
+        logic->clock.last_tick_time = clock_get_current_time_ms();
+        gamelogic_update_game_state(logic);
+        if (logic->updateCallback) logic->updateCallback();
+    }
+    logic->cachedPieceRow = -1;
+}
+
+bool gamelogic_redo_move(GameLogic* logic) {
+    if (!logic || logic->redoCount == 0) return false;
+    gamelogic_jump_to_ply(logic, logic->historyCount + 1);
+    return true;
+}
+
+void gamelogic_undo_moves(GameLogic* logic, int count) {
+    if (!logic || count <= 0) return;
+    gamelogic_jump_to_ply(logic, logic->historyCount - count);
+}
+
+void gamelogic_redo_moves(GameLogic* logic, int count) {
+    if (!logic || count <= 0) return;
+    gamelogic_jump_to_ply(logic, logic->historyCount + count);
+}
+
+int gamelogic_get_redo_count(GameLogic* logic) {
+    return logic ? logic->redoCount : 0;
+}
+
+void gamelogic_drop_redo(GameLogic* logic) {
+    if (logic) history_drop_redo(logic);
+}
+
+// Simulate a move and check if the resulting position is safe for the given player.
+// Works purely on the bitboards: the post-move occupancy is derived with a few
+// XORs and the king square is tested against the remaining enemy pieces, so the
+// board itself is never touched.
+static bool is_king_safe_after(GameLogic* logic, int from, int to, bool isEnPassant, bool isCastling, Player p) {
+    uint8_t moving = logic->mailbox[from];
+    if (moving == SQUARE_EMPTY) return false;
+    
+    Bitboard occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    Bitboard enemies = logic->colorBB[get_opponent(p)];
+    
+    if (isCastling) {
+        // King and rook both leave their squares, then land
+        int kingTo, rookFrom, rookTo;
+        if (!gamelogic_castling_squares(logic, from, to, &kingTo, &rookFrom, &rookTo)) return false;
+        occupied &= ~(BB_SQUARE(from) | BB_SQUARE(rookFrom));
+        occupied |= BB_SQUARE(kingTo) | BB_SQUARE(rookTo);
+        to = kingTo;
+    } else {
+        // Moved piece leaves 'from' and occupies 'to'; anything on 'to' is captured
+        occupied = (occupied & ~BB_SQUARE(from)) | BB_SQUARE(to);
+        enemies &= ~BB_SQUARE(to);
+    }
     
-    if (m->isEnPassant) {
-        saved_ep = logic->board[r1][c2];
-        logic->board[r1][c2] = NULL;
-        is_ep_capture = true;
+    if (isEnPassant) {
+        int capturedSq = (from / 8) * 8 + (to % 8);
+        occupied &= ~BB_SQUARE(capturedSq);
+        enemies &= ~BB_SQUARE(capturedSq);
     }
     
-    if (m->isCastling) {
-        rookStartCol = (c2 > c1) ? 7 : 0;
-        rookDestCol = (c2 > c1) ? 5 : 3;
-        saved_rook_start = logic->board[r1][rookStartCol];
-        saved_rook_dest = logic->board[r1][rookDestCol];
-        logic->board[r1][rookDestCol] = saved_rook_start;
-        logic->board[r1][rookStartCol] = NULL;
+    int kingSq;
+    if (SQUARE_TYPE(moving) == PIECE_KING && SQUARE_OWNER(moving) == p) {
+        kingSq = to;
+    } else {
+        Bitboard king = logic->pieceBB[PIECE_KING] & logic->colorBB[p];
+        if (!king) return true; // No king (puzzle/tutorial setups): nothing to expose
+        kingSq = bb_lsb(king);
     }
     
-    bool safe = !gamelogic_is_in_check(logic, p);
+    return (gamelogic_attackers_to(logic, kingSq, occupied) & enemies) == 0;
+}
+
+bool gamelogic_simulate_move_and_check_safety(GameLogic* logic, Move* m, Player p) {
+    if (!logic || !m) return false;
+    return is_king_safe_after(logic, m->from_sq, m->to_sq, m->isEnPassant, m->isCastling, p);
+}
+
+// PackedMove variant used by the generator (gamelogic_movegen.c)
+bool gamelogic_simulate_packed_and_check_safety(GameLogic* logic, PackedMove pm, Player p) {
+    if (!logic) return false;
+    return is_king_safe_after(logic, PACKED_FROM(pm), PACKED_TO(pm), PACKED_TYPE(pm) == MOVE_TYPE_EN_PASSANT,
+                              PACKED_TYPE(pm) == MOVE_TYPE_CASTLING, p);
+}
+
+// --- Perft (move generation test) ---
+
+// Counts leaf nodes using the internal make/undo, skipping clocks, think
+// times and game-state updates that gamelogic_perform_move does.
+static uint64_t perft_recursive(GameLogic* logic, int depth) {
+    MoveBuffer buf;
+    int count = gamelogic_generate_moves(logic, logic->turn, &buf);
+    if (depth <= 1) return (uint64_t)count;
     
-    // Restore
-    logic->board[r1][c1] = saved_start;
-    logic->board[r2][c2] = saved_end;
-    if (is_ep_capture) logic->board[r1][c2] = saved_ep;
-    if (m->isCastling) {
-        logic->board[r1][rookStartCol] = saved_rook_start;
-        logic->board[r1][rookDestCol] = saved_rook_dest;
+    uint64_t nodes = 0;
+    for (int i = 0; i < count; i++) {
+        Move m;
+        move_unpack(&m, buf.moves[i], logic->turn);
+        make_move_internal(logic, &m);
+        nodes += perft_recursive(logic, depth - 1);
+        undo_move_internal(logic);
     }
+    return nodes;
+}
+
+uint64_t gamelogic_perft(GameLogic* logic, int depth) {
+    return gamelogic_perft_divide(logic, depth, NULL, NULL);
+}
+
+uint64_t gamelogic_perft_divide(GameLogic* logic, int depth, PerftDivideCallback callback, void* user_data) {
+    if (!logic) return 0;
+    if (depth <= 0) return 1;
+    // The search reuses the history slots the redo stack lives in
+    history_drop_redo(logic);
     
-    logic->turn = saved_turn;
-    logic->enPassantCol = saved_enPassantCol;
-    logic->castlingRights = saved_castling;
+    MoveBuffer buf;
+    int count = gamelogic_generate_moves(logic, logic->turn, &buf);
     
-    return safe;
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t nodes = 1;
+        if (depth > 1) {
+            Move m;
+            move_unpack(&m, buf.moves[i], logic->turn);
+            make_move_internal(logic, &m);
+            nodes = perft_recursive(logic, depth - 1);
+            undo_move_internal(logic);
+        }
+        if (callback) {
+            char uci[8];
+            packed_move_to_uci(buf.moves[i], uci);
+            callback(uci, nodes, user_data);
+        }
+        total += nodes;
+    }
+    return total;
 }
 
 // History access
@@ -656,20 +897,18 @@ Move gamelogic_get_last_move(GameLogic* logic) {
         empty.promotionPiece = NO_PROMOTION;
         return empty;
     }
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (!moveStack || !moveStack->top) {
+    if (logic->historyCount == 0) {
         Move empty = {0};
         empty.capturedPieceType = NO_PIECE;
         empty.promotionPiece = NO_PROMOTION;
         return empty;
     }
-    return *((Move*)moveStack->top->data);
+    return move_from_ply(&logic->history[logic->historyCount - 1]);
 }
 
 int gamelogic_get_move_count(GameLogic* logic) {
-    if (!logic || !logic->moveHistory) return 0;
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    return moveStack->size;
+    if (!logic) return 0;
+    return logic->historyCount;
 }
 
 Move gamelogic_get_move_at(GameLogic* logic, int index) {
@@ -679,26 +918,27 @@ Move gamelogic_get_move_at(GameLogic* logic, int index) {
         empty.promotionPiece = NO_PROMOTION;
         return empty;
     }
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (!moveStack || index >= moveStack->size) {
+    if (index >= logic->historyCount) {
         Move empty = {0};
         empty.capturedPieceType = NO_PIECE;
         empty.promotionPiece = NO_PROMOTION;
         return empty;
     }
-    
-    StackNode* current = moveStack->top;
-    int currentIdx = moveStack->size - 1;
-    while (current && currentIdx > index) {
-        current = current->next;
-        currentIdx--;
-    }
-    
-    if (current) return *((Move*)current->data);
-    Move empty = {0};
-    empty.capturedPieceType = NO_PIECE;
-    empty.promotionPiece = NO_PROMOTION;
-    return empty;
+    return move_from_ply(&logic->history[index]);
+}
+
+// X-FEN: 'K'/'Q' when the castling rook is the outermost rook on its side
+// of the king (always so in standard chess), otherwise the rook's file
+static char castling_right_char(GameLogic* logic, Player p, int side) {
+    int row = (p == PLAYER_WHITE) ? 7 : 0;
+    int rookCol = logic->castlingRookCol[p][side];
+    int step = (side == 0) ? 1 : -1;
+    bool outermost = true;
+    for (int c = rookCol + step; c >= 0 && c < 8; c += step) {
+        if (logic->mailbox[row * 8 + c] == SQUARE_ENCODE(PIECE_ROOK, p)) outermost = false;
+    }
+    char letter = outermost ? (side == 0 ? 'k' : 'q') : (char)('a' + rookCol);
+    return (p == PLAYER_WHITE) ? (char)toupper(letter) : letter;
 }
 
 // Generate FEN string
@@ -712,8 +952,8 @@ void gamelogic_generate_fen(GameLogic* logic, char* fen, size_t fen_size) {
     for (int r = 0; r < 8; r++) {
         int empty = 0;
         for (int c = 0; c < 8; c++) {
-            Piece* p = logic->board[r][c];
-            if (!p) {
+            uint8_t p = logic->mailbox[r * 8 + c];
+            if (p == SQUARE_EMPTY) {
                 empty++;
             } else {
                 if (empty > 0) {
@@ -722,8 +962,8 @@ void gamelogic_generate_fen(GameLogic* logic, char* fen, size_t fen_size) {
                     remaining -= written;
                     empty = 0;
                 }
-                char symbol = get_fen_char(p);
-                if (p->owner == PLAYER_WHITE) {
+                char symbol = get_fen_char(SQUARE_TYPE(p));
+                if (SQUARE_OWNER(p) == PLAYER_WHITE) {
                     symbol = (char)toupper(symbol);
                 }
                 if (remaining > 0) {
@@ -750,12 +990,14 @@ void gamelogic_generate_fen(GameLogic* logic, char* fen, size_t fen_size) {
         remaining -= written;
     }
     
-    // Castling rights
+    // Castling rights (bit order matches KQkq)
     bool hasCastling = false;
-    if (logic->castlingRights & 1) { if (remaining > 0) { *ptr++ = 'K'; remaining--; hasCastling = true; } }
-    if (logic->castlingRights & 2) { if (remaining > 0) { *ptr++ = 'Q'; remaining--; hasCastling = true; } }
-    if (logic->castlingRights & 4) { if (remaining > 0) { *ptr++ = 'k'; remaining--; hasCastling = true; } }
-    if (logic->castlingRights & 8) { if (remaining > 0) { *ptr++ = 'q'; remaining--; hasCastling = true; } }
+    for (int bit = 0; bit < 4; bit++) {
+        if (!(logic->castlingRights & (1 << bit)) || remaining == 0) continue;
+        *ptr++ = castling_right_char(logic, bit < 2 ? PLAYER_WHITE : PLAYER_BLACK, bit & 1);
+        remaining--;
+        hasCastling = true;
+    }
     if (!hasCastling && remaining > 0) {
         *ptr++ = '-';
         remaining--;
@@ -797,33 +1039,16 @@ void gamelogic_get_captured_pieces(GameLogic* logic, Player capturer, void* piec
     PieceTypeList* list = (PieceTypeList*)pieces_list;
     piece_type_list_clear(list);
     
-    // Iterate through move history to find captured pieces
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (!moveStack || moveStack->size == 0) return;
-    
-    // We need to iterate through the stack - create a temporary array
-    Move** moves = (Move**)malloc(moveStack->size * sizeof(Move*));
-    if (!moves) return;
-    
-    StackNode* current = moveStack->top;
-    int count = 0;
-    while (current && count < moveStack->size) {
-        moves[count++] = (Move*)current->data;
-        current = current->next;
-    }
-    
-    // Process moves in reverse order (oldest first) to maintain chronological order
-    for (int i = count - 1; i >= 0; i--) {
-        Move* m = moves[i];
-        if (m && m->capturedPieceType != NO_PIECE) {
+    // Iterate through move history (oldest first) to find captured pieces
+    for (int i = 0; i < logic->historyCount; i++) {
+        const UndoInfo* undo = &logic->history[i].undo;
+        if (undo->capturedPieceType != NO_PIECE) {
             // If the move was made by capturer, it means capturer TOOK a piece.
-            if (m->mover == capturer) {
-                piece_type_list_add(list, m->capturedPieceType);
+            if (undo->mover == capturer) {
+                piece_type_list_add(list, (PieceType)undo->capturedPieceType);
             }
         }
     }
-    
-    free(moves);
 }
 
 // Handle game end learning (for AI training)
@@ -833,42 +1058,144 @@ void gamelogic_handle_game_end_learning(GameLogic* logic, Player winner) {
     (void)winner;
 }
 
+// --- Castling ---
+
+bool gamelogic_castling_squares(GameLogic* logic, int from, int to, int* king_to, int* rook_from, int* rook_to) {
+    if (!logic) return false;
+    int row = from / 8;
+    if ((row != 0 && row != 7) || to / 8 != row) return false;
+    Player p = (row == 7) ? PLAYER_WHITE : PLAYER_BLACK;
+    int side = (to % 8 > from % 8) ? 0 : 1; // Both encodings point the king towards its rook
+    int rookCol = logic->castlingRookCol[p][side];
+    if (rookCol < 0) return false;
+    if (king_to) *king_to = row * 8 + (side == 0 ? 6 : 2);
+    if (rook_from) *rook_from = row * 8 + rookCol;
+    if (rook_to) *rook_to = row * 8 + (side == 0 ? 5 : 3);
+    return true;
+}
+
+void gamelogic_set_chess960(GameLogic* logic, bool enabled) {
+    if (!logic) return;
+    logic->chess960 = enabled;
+    logic->positionVersion++; // Castling moves change encoding
+}
+
+void gamelogic_setup_chess960(GameLogic* logic, int index) {
+    if (!logic || index < 0 || index >= 960) return;
+    
+    // Scharnagl numbering: bishops, queen, knights, then R-K-R in the gaps
+    char rank[9] = {0};
+    int n = index;
+    rank[(n % 4) * 2 + 1] = 'b';
+    n /= 4;
+    rank[(n % 4) * 2] = 'b';
+    n /= 4;
+    int queen = n % 6;
+    n /= 6;
+    static const int knights[10][2] = {{0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 2}, {1, 3}, {1, 4}, {2, 3}, {2, 4}, {3, 4}};
+    
+    int empty = 0;
+    for (int c = 0; c < 8; c++) {
+        if (rank[c]) continue;
+        if (empty++ == queen) rank[c] = 'q';
+    }
+    empty = 0;
+    for (int c = 0; c < 8; c++) {
+        if (rank[c]) continue;
+        if (empty == knights[n][0] || empty == knights[n][1]) rank[c] = 'n';
+        empty++;
+    }
+    const char* rest = "rkr";
+    for (int c = 0; c < 8; c++) {
+        if (!rank[c]) rank[c] = *rest++;
+    }
+    
+    char white[9];
+    for (int c = 0; c < 8; c++) white[c] = (char)toupper((unsigned char)rank[c]);
+    white[8] = '\0';
+    char fen[96];
+    snprintf(fen, sizeof(fen), "%s/pppppppp/8/8/8/8/PPPPPPPP/%s w KQkq - 0 1", rank, white);
+    gamelogic_load_fen(logic, fen);
+    logic->chess960 = true; // Also for 518, so castling keeps the 960 encoding
+}
+
+// Side (0 = kingside, 1 = queenside) if the king move from->to castles, else -1.
+// Accepts the king landing on its own castling rook and, as in standard
+// chess, the king moving two files onto its castling square.
+static int castling_side(GameLogic* logic, int from, int to, uint8_t moving) {
+    if (SQUARE_TYPE(moving) != PIECE_KING) return -1;
+    Player p = SQUARE_OWNER(moving);
+    int home = (p == PLAYER_WHITE) ? 7 : 0;
+    if (from / 8 != home || to / 8 != home) return -1;
+    
+    int side = (to % 8 > from % 8) ? 0 : 1;
+    int rookCol = logic->castlingRookCol[p][side];
+    if (rookCol < 0) return -1;
+    if (logic->mailbox[to] == SQUARE_ENCODE(PIECE_ROOK, p)) return (to % 8 == rookCol) ? side : -1;
+    if (abs(to % 8 - from % 8) == 2 && to % 8 == (side == 0 ? 6 : 2)) return side;
+    return -1;
+}
+
+// A rook leaving (or captured on) its castling square takes the right with it
+static void clear_rook_right(GameLogic* logic, Player p, int r, int c) {
+    if (r != ((p == PLAYER_WHITE) ? 7 : 0)) return;
+    uint8_t kingside = (p == PLAYER_WHITE) ? 1 : 4;
+    if (c == logic->castlingRookCol[p][0]) logic->castlingRights &= ~kingside;
+    if (c == logic->castlingRookCol[p][1]) logic->castlingRights &= ~(kingside << 1);
+}
+
 // Internal: Make a move
 static void make_move_internal(GameLogic* logic, Move* move) {
     if (!logic || !move) return;
     
     int r1 = move->from_sq / 8, c1 = move->from_sq % 8;
     int r2 = move->to_sq / 8, c2 = move->to_sq % 8;
-    Piece* movingPiece = logic->board[r1][c1];
-    if (!movingPiece) return;
+    uint8_t moving = logic->mailbox[move->from_sq];
+    if (moving == SQUARE_EMPTY) return;
+    PieceType movingType = SQUARE_TYPE(moving);
+    Player movingOwner = SQUARE_OWNER(moving);
+    
+    // Keep a requested under-promotion; anything else is normalized below
+    PieceType requestedPromotion = (PieceType)move->promotionPiece;
     
     move->isEnPassant = false;
     move->isCastling = false;
-    move->rookFirstMove = false;
     move->promotionPiece = NO_PROMOTION;
 
-    move->movedPieceType = movingPiece->type;
+    move->movedPieceType = (uint8_t)movingType;
     
     // Store attributes for undo
-    move->prevEnPassantCol = (int8_t)logic->enPassantCol;
-    move->prevCastlingRights = logic->castlingRights;
-    move->prevHalfmoveClock = logic->halfmoveClock;
-    move->prevWhiteTimeMs = logic->clock.white_time_ms;
-    move->prevBlackTimeMs = logic->clock.black_time_ms;
+    UndoInfo undo;
+    undo.movedPieceType = (uint8_t)movingType;
+    undo.prevCastlingRights = logic->castlingRights;
+    undo.prevEnPassantCol = logic->enPassantCol;
+    undo.prevHalfmoveClock = (uint16_t)logic->halfmoveClock;
+    undo.mover = (uint8_t)logic->turn;
     
-    Piece* target = logic->board[r2][c2];
+    PlyClock clockBefore = { logic->clock.white_time_ms, logic->clock.black_time_ms };
+    uint64_t prevHash = logic->currentHash;
+    
+    // Pieces are hashed by the bb_* helpers; state keys are swapped around the move
+    logic->currentHash ^= hash_state_keys(logic);
+    
+    // Castling may be given as king-takes-rook, so decide it before captures
+    int castleSide = castling_side(logic, move->from_sq, move->to_sq, moving);
+    uint8_t target = (castleSide >= 0) ? SQUARE_EMPTY : logic->mailbox[move->to_sq];
 
-    bool is_ep = (movingPiece->type == PIECE_PAWN &&
+    bool is_ep = (movingType == PIECE_PAWN &&
                   c1 != c2 &&
-                  target == NULL &&
+                  target == SQUARE_EMPTY &&
                   logic->enPassantCol == c2);
 
     move->capturedPieceType = NO_PIECE;
 
-    if (target) {
-        move->capturedPieceType = target->type;
-        piece_free(target);
-        logic->board[r2][c2] = NULL;
+    if (target != SQUARE_EMPTY) {
+        move->capturedPieceType = (uint8_t)SQUARE_TYPE(target);
+        bb_remove_piece(logic, move->to_sq);
+    }
+    
+    // Captures and pawn moves are irreversible and reset the fifty-move count
+    if (target != SQUARE_EMPTY || movingType == PIECE_PAWN) {
         logic->halfmoveClock = 0;
     } else {
         logic->halfmoveClock++;
@@ -882,145 +1209,123 @@ static void make_move_internal(GameLogic* logic, Move* move) {
     if (is_ep) {
         move->isEnPassant = true;
         move->capturedPieceType = PIECE_PAWN;
-        piece_free(logic->board[r1][c2]);
-        logic->board[r1][c2] = NULL;
+        bb_remove_piece(logic, r1 * 8 + c2);
     }
-
-    move->firstMove = !movingPiece->hasMoved;
-    movingPiece->hasMoved = true;
     
     // Update castling rights
-    if (movingPiece->type == PIECE_KING) {
-        if (movingPiece->owner == PLAYER_WHITE) logic->castlingRights &= ~3;
+    if (movingType == PIECE_KING) {
+        if (movingOwner == PLAYER_WHITE) logic->castlingRights &= ~3;
         else logic->castlingRights &= ~12;
     }
-    if (movingPiece->type == PIECE_ROOK) {
-        if (movingPiece->owner == PLAYER_WHITE) {
-            if (r1 == 7 && c1 == 7) logic->castlingRights &= ~1;
-            if (r1 == 7 && c1 == 0) logic->castlingRights &= ~2;
-        } else {
-            if (r1 == 0 && c1 == 7) logic->castlingRights &= ~4;
-            if (r1 == 0 && c1 == 0) logic->castlingRights &= ~8;
-        }
+    if (movingType == PIECE_ROOK) {
+        clear_rook_right(logic, movingOwner, r1, c1);
     }
     // Also if a rook is captured
     if (move->capturedPieceType == PIECE_ROOK) {
-        if (r2 == 7 && c2 == 7) logic->castlingRights &= ~1;
-        if (r2 == 7 && c2 == 0) logic->castlingRights &= ~2;
-        if (r2 == 0 && c2 == 7) logic->castlingRights &= ~4;
-        if (r2 == 0 && c2 == 0) logic->castlingRights &= ~8;
+        clear_rook_right(logic, get_opponent(movingOwner), r2, c2);
     }
     
-    if (movingPiece->type == PIECE_KING && abs(c1 - c2) == 2) {
+    if (castleSide >= 0) {
+        // Lift both pieces first: in Chess960 either may land where the other stood
         move->isCastling = true;
-        int rookStartCol = (c2 > c1) ? 7 : 0;
-        int rookDestCol = (c2 > c1) ? 5 : 3;
-        Piece* rook = logic->board[r1][rookStartCol];
-        if (rook) {
-            move->rookFirstMove = !rook->hasMoved;
-            logic->board[r1][rookDestCol] = rook;
-            logic->board[r1][rookStartCol] = NULL;
-            rook->hasMoved = true;
-        }
+        int kingTo, rookFrom, rookTo;
+        gamelogic_castling_squares(logic, move->from_sq, move->to_sq, &kingTo, &rookFrom, &rookTo);
+        bb_remove_piece(logic, move->from_sq);
+        bb_remove_piece(logic, rookFrom);
+        bb_put_piece(logic, kingTo, PIECE_KING, movingOwner);
+        bb_put_piece(logic, rookTo, PIECE_ROOK, movingOwner);
+    } else {
+        bb_move_piece(logic, move->from_sq, move->to_sq);
     }
     
-    PieceType movingPieceType = movingPiece->type;
-    
-    logic->board[r2][c2] = movingPiece;
-    logic->board[r1][c1] = NULL;
-    
-    if (movingPieceType == PIECE_PAWN && (r2 == 0 || r2 == 7)) {
-        if (move->promotionPiece == NO_PROMOTION) move->promotionPiece = PIECE_QUEEN;
-        Player owner = movingPiece->owner;
-        piece_free(movingPiece);
-        logic->board[r2][c2] = piece_create(move->promotionPiece, owner);
-        logic->board[r2][c2]->hasMoved = true;
+    if (movingType == PIECE_PAWN && (r2 == 0 || r2 == 7)) {
+        bool validPromotion = (requestedPromotion == PIECE_QUEEN || requestedPromotion == PIECE_ROOK ||
+                               requestedPromotion == PIECE_BISHOP || requestedPromotion == PIECE_KNIGHT);
+        PieceType promotion = validPromotion ? requestedPromotion : PIECE_QUEEN;
+        move->promotionPiece = (uint8_t)promotion;
+        bb_remove_piece(logic, move->to_sq);
+        bb_put_piece(logic, move->to_sq, promotion, movingOwner);
     }
     
-    if (movingPieceType == PIECE_PAWN && abs(r1 - r2) == 2) {
+    if (movingType == PIECE_PAWN && abs(r1 - r2) == 2) {
         logic->enPassantCol = c1;
     } else {
         logic->enPassantCol = -1;
     }
     
     if (logic->turn == PLAYER_BLACK) logic->fullmoveNumber++;
-    move->mover = logic->turn;
+    move->mover = (uint8_t)logic->turn;
     logic->turn = get_opponent(logic->turn);
     
     // Add to history
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (moveStack) {
-        Move* moveCopy = move_copy(move);
-        stack_push(moveStack, moveCopy);
+    undo.capturedPieceType = move->capturedPieceType;
+    Ply* ply = history_push(logic);
+    if (ply) {
+        ply->hash = prevHash;
+        ply->move = move_pack(move);
+        ply->undo = undo;
+        logic->clockHistory[logic->historyCount - 1] = clockBefore;
     }
     
-    logic->currentHash = zobrist_compute(logic);
+    logic->currentHash ^= hash_state_keys(logic);
+    ZOBRIST_ASSERT(logic);
     logic->positionVersion++;
 }
 
 // Internal: Undo last move
-static Move* undo_move_internal(GameLogic* logic, bool free_move) {
-    if (!logic) return NULL;
+static void undo_move_internal(GameLogic* logic) {
+    if (!logic || logic->historyCount == 0) return;
     
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (!moveStack || !moveStack->top) return NULL;
+    int index = --logic->historyCount;
+    PackedMove pm = logic->history[index].move;
+    const UndoInfo* undo = &logic->history[index].undo;
     
-    Move* lastMove = (Move*)stack_pop(moveStack);
+    logic->currentHash ^= hash_state_keys(logic);
     
     // Switch turns back
     logic->turn = get_opponent(logic->turn);
     if (logic->turn == PLAYER_BLACK) logic->fullmoveNumber--;
     
-    int r1 = lastMove->from_sq / 8, c1 = lastMove->from_sq % 8;
-    int r2 = lastMove->to_sq / 8, c2 = lastMove->to_sq % 8;
-    
-    Piece* movedPiece = logic->board[r2][c2];
-    if (movedPiece) {
-        // BULLETPROOF: ONLY restore as pawn if this was actually a promotion move
-        // and the piece currently at (r2,c2) matches the promotion type.
-        if (lastMove->promotionPiece != NO_PROMOTION && movedPiece->type == lastMove->promotionPiece) {
-            piece_free(movedPiece);
-            logic->board[r1][c1] = piece_create(PIECE_PAWN, logic->turn);
+    int from = PACKED_FROM(pm), to = PACKED_TO(pm);
+    int r1 = from / 8;
+    int c2 = to % 8;
+    PieceType promotion = PACKED_PROMOTION_PIECE(pm);
+    
+    if (PACKED_TYPE(pm) == MOVE_TYPE_CASTLING) {
+        int kingTo, rookFrom, rookTo;
+        gamelogic_castling_squares(logic, from, to, &kingTo, &rookFrom, &rookTo);
+        bb_remove_piece(logic, kingTo);
+        bb_remove_piece(logic, rookTo);
+        bb_put_piece(logic, from, PIECE_KING, logic->turn);
+        bb_put_piece(logic, rookFrom, PIECE_ROOK, logic->turn);
+    } else if (logic->mailbox[to] != SQUARE_EMPTY) {
+        // A promotion puts the pawn back; anything else just moves home
+        if (promotion != NO_PROMOTION) {
+            bb_remove_piece(logic, to);
+            bb_put_piece(logic, from, PIECE_PAWN, logic->turn);
         } else {
-            // Otherwise, it was just a normal move.
-            logic->board[r1][c1] = movedPiece;
+            bb_move_piece(logic, to, from);
         }
-        logic->board[r1][c1]->hasMoved = !lastMove->firstMove;
-        logic->board[r2][c2] = NULL;
     }
     
     // Restore captured piece
-    if (lastMove->capturedPieceType != NO_PIECE) {
+    if (undo->capturedPieceType != NO_PIECE) {
         Player victimColor = get_opponent(logic->turn);
-        Piece* restored = piece_create(lastMove->capturedPieceType, victimColor);
-        if (lastMove->isEnPassant) {
-            logic->board[r1][c2] = restored;
-        } else {
-            logic->board[r2][c2] = restored;
-        }
-    }
-    
-    // Revert Castling
-    if (lastMove->isCastling) {
-        int rookStartCol = (c2 > c1) ? 7 : 0;
-        int rookDestCol = (c2 > c1) ? 5 : 3;
-        Piece* rook = logic->board[r1][rookDestCol];
-        if (rook) {
-            logic->board[r1][rookStartCol] = rook;
-            logic->board[r1][rookDestCol] = NULL;
-            rook->hasMoved = !lastMove->rookFirstMove;
-        }
+        PieceType victim = (PieceType)undo->capturedPieceType;
+        int victimSq = (PACKED_TYPE(pm) == MOVE_TYPE_EN_PASSANT) ? r1 * 8 + c2 : to;
+        bb_put_piece(logic, victimSq, victim, victimColor);
     }
     
     // Restore global state
-    logic->castlingRights = lastMove->prevCastlingRights;
-    logic->enPassantCol = lastMove->prevEnPassantCol;
-    logic->halfmoveClock = lastMove->prevHalfmoveClock;
+    logic->castlingRights = undo->prevCastlingRights;
+    logic->enPassantCol = undo->prevEnPassantCol;
+    logic->halfmoveClock = undo->prevHalfmoveClock;
+    logic->currentHash ^= hash_state_keys(logic);
 
     // Restore Clock
     if (!logic->isSimulation) {
-        logic->clock.white_time_ms = lastMove->prevWhiteTimeMs;
-        logic->clock.black_time_ms = lastMove->prevBlackTimeMs;
+        logic->clock.white_time_ms = logic->clockHistory[index].whiteTimeMs;
+        logic->clock.black_time_ms = logic->clockHistory[index].blackTimeMs;
         logic->clock.flagged_player = PLAYER_NONE;
         
         // CRITICAL: Reset the last tick time to NOW.
@@ -1034,13 +1339,8 @@ static Move* undo_move_internal(GameLogic* logic, bool free_move) {
         // But let's just restore values.
     }
     
-    if (free_move) {
-        move_free(lastMove);
-        lastMove = NULL;
-    }
-    logic->currentHash = zobrist_compute(logic);
+    ZOBRIST_ASSERT(logic);
     logic->positionVersion++;
-    return lastMove;
 }
 
 GameMode gamelogic_get_game_mode(GameLogic* logic) {
@@ -1052,9 +1352,8 @@ void gamelogic_set_game_mode(GameLogic* logic, GameMode mode) {
 }
 
 // Helper: Get FEN character for piece
-static char get_fen_char(Piece* p) {
-    if (!p) return ' ';
-    switch (p->type) {
+static char get_fen_char(PieceType type) {
+    switch (type) {
         case PIECE_PAWN: return 'p';
         case PIECE_ROOK: return 'r';
         case PIECE_KNIGHT: return 'n';
@@ -1065,18 +1364,33 @@ static char get_fen_char(Piece* p) {
     }
 }
 
+// Column of p's king on its back rank, or -1
+static int home_king_col(GameLogic* logic, Player p) {
+    int row = (p == PLAYER_WHITE) ? 7 : 0;
+    for (int c = 0; c < 8; c++) {
+        if (logic->mailbox[row * 8 + c] == SQUARE_ENCODE(PIECE_KING, p)) return c;
+    }
+    return -1;
+}
+
+// Column of p's back-rank rook furthest from the king in direction step, or -1
+static int outermost_rook_col(GameLogic* logic, Player p, int kingCol, int step) {
+    int row = (p == PLAYER_WHITE) ? 7 : 0;
+    int found = -1;
+    for (int c = kingCol + step; c >= 0 && c < 8; c += step) {
+        if (logic->mailbox[row * 8 + c] == SQUARE_ENCODE(PIECE_ROOK, p)) found = c;
+    }
+    return found;
+}
+
 // Load position from FEN string
 void gamelogic_load_fen(GameLogic* logic, const char* fen) {
     if (!logic || !fen) return;
 
     // Clear move history first
-    Stack* moveStack = (Stack*)logic->moveHistory;
-    if (moveStack) {
-        while (moveStack->top) {
-            Move* m = (Move*)stack_pop(moveStack);
-            move_free(m);
-        }
-    }
+    logic->historyCount = 0;
+    logic->redoCount = 0;
+    logic->snapshotCount = 0;
     // Also clear cache as position is changing discontinuously
     gamelogic_clear_cache(logic);
     logic->cachedPieceRow = -1;
@@ -1087,14 +1401,7 @@ void gamelogic_load_fen(GameLogic* logic, const char* fen) {
     snprintf(logic->start_fen, sizeof(logic->start_fen), "%s", fen);
     
     // Clear the board first
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
     // Parse board position
     int row = 0, col = 0;
@@ -1123,7 +1430,7 @@ void gamelogic_load_fen(GameLogic* logic, const char* fen) {
             }
             
             if (row < 8 && col < 8) {
-                logic->board[row][col] = piece_create(type, owner);
+                gamelogic_place_piece(logic, row, col, type, owner);
             }
             col++;
         }
@@ -1142,50 +1449,62 @@ void gamelogic_load_fen(GameLogic* logic, const char* fen) {
     // Parse castling rights
     while (*ptr && *ptr == ' ') ptr++;
     
-    bool wk_f = false, wq_f = false, bk_f = false, bq_f = false;
+    // KQkq pick the outermost rook on that side of the king (X-FEN);
+    // A-H/a-h name the rook's file (Shredder-FEN)
+    logic->castlingRights = 0;
+    logic->castlingRookCol[PLAYER_WHITE][0] = logic->castlingRookCol[PLAYER_WHITE][1] = -1;
+    logic->castlingRookCol[PLAYER_BLACK][0] = logic->castlingRookCol[PLAYER_BLACK][1] = -1;
+    bool byFile = false;
     if (*ptr && *ptr != '-') {
         while (*ptr && *ptr != ' ') {
-            if (*ptr == 'K') wk_f = true;
-            else if (*ptr == 'Q') wq_f = true;
-            else if (*ptr == 'k') bk_f = true;
-            else if (*ptr == 'q') bq_f = true;
-            ptr++;
+            char ch = *ptr++;
+            Player p = isupper((unsigned char)ch) ? PLAYER_WHITE : PLAYER_BLACK;
+            char lower = (char)tolower((unsigned char)ch);
+            int kingCol = home_king_col(logic, p);
+            if (kingCol < 0) continue;
+            int rookCol;
+            if (lower == 'k' || lower == 'q') {
+                rookCol = outermost_rook_col(logic, p, kingCol, lower == 'k' ? 1 : -1);
+            } else if (lower >= 'a' && lower <= 'h') {
+                rookCol = lower - 'a';
+                byFile = true;
+            } else {
+                continue;
+            }
+            // A right is only meaningful while its king and rook stand at
+            // home; drop the rest so a rook arriving later cannot revive it
+            int row = (p == PLAYER_WHITE) ? 7 : 0;
+            if (rookCol < 0 || rookCol == kingCol ||
+                logic->mailbox[row * 8 + rookCol] != SQUARE_ENCODE(PIECE_ROOK, p)) {
+                continue;
+            }
+            int side = (rookCol > kingCol) ? 0 : 1;
+            logic->castlingRookCol[p][side] = (int8_t)rookCol;
+            logic->castlingRights |= (uint8_t)(1 << (p == PLAYER_WHITE ? side : 2 + side));
         }
     } else if (*ptr == '-') {
         ptr++;
     }
 
-    // Update castling rights in the logic struct
-    logic->castlingRights = 0;
-    if (wk_f) logic->castlingRights |= 1;
-    if (wq_f) logic->castlingRights |= 2;
-    if (bk_f) logic->castlingRights |= 4;
-    if (bq_f) logic->castlingRights |= 8;
-
-    // Set hasMoved flags for kings and rooks based on castling rights
-    // White King
-    if (logic->board[7][4] && logic->board[7][4]->type == PIECE_KING) {
-        logic->board[7][4]->hasMoved = !(wk_f || wq_f);
-    }
-    // White Rooks
-    if (logic->board[7][7] && logic->board[7][7]->type == PIECE_ROOK) {
-        logic->board[7][7]->hasMoved = !wk_f;
-    }
-    if (logic->board[7][0] && logic->board[7][0]->type == PIECE_ROOK) {
-        logic->board[7][0]->hasMoved = !wq_f;
-    }
-    // Black King
-    if (logic->board[0][4] && logic->board[0][4]->type == PIECE_KING) {
-        logic->board[0][4]->hasMoved = !(bk_f || bq_f);
-    }
-    // Black Rooks
-    if (logic->board[0][7] && logic->board[0][7]->type == PIECE_ROOK) {
-        logic->board[0][7]->hasMoved = !bk_f;
-    }
-    if (logic->board[0][0] && logic->board[0][0]->type == PIECE_ROOK) {
-        logic->board[0][0]->hasMoved = !bq_f;
+    // Standard chess unless a right needs a king off the e-file or a rook
+    // off the corners. Sides without a right keep the corner rooks, so the
+    // two-file king move still resolves; it never validates as legal.
+    bool standard = !byFile;
+    for (int p = 0; p < 2; p++) {
+        int row = (p == PLAYER_WHITE) ? 7 : 0;
+        for (int side = 0; side < 2; side++) {
+            int rookCol = logic->castlingRookCol[p][side];
+            if (rookCol < 0) {
+                logic->castlingRookCol[p][side] = (side == 0) ? 7 : 0;
+            } else if (rookCol != (side == 0 ? 7 : 0) ||
+                       logic->mailbox[row * 8 + 4] != SQUARE_ENCODE(PIECE_KING, (Player)p)) {
+                standard = false;
+            }
+        }
     }
-    
+    logic->chess960 = !standard;
+
+
     while (*ptr && *ptr == ' ') ptr++;
     
     // Parse en passant square (e.g., "e3")
@@ -1222,8 +1541,12 @@ void gamelogic_load_fen(GameLogic* logic, const char* fen) {
     } else {
         logic->enPassantCol = -1;
     }
+    // Skip the rest of the en passant field ("-" or the square)
+    while (*ptr && *ptr != ' ') ptr++;
 
-    // Parse clocks
+    // Parse clocks (default to a fresh count if the FEN omits them)
+    logic->halfmoveClock = 0;
+    logic->fullmoveNumber = 1;
     while (*ptr && *ptr == ' ') ptr++;
     if (*ptr && isdigit(*ptr)) {
         logic->halfmoveClock = atoi(ptr);
@@ -1259,114 +1582,112 @@ static char get_san_piece_char(PieceType type) {
     }
 }
 
-void gamelogic_get_move_san(GameLogic* logic, Move* move, char* san, size_t san_size) {
-    if (!logic || !move || !san || san_size == 0) return;
-
-    // Suppress callbacks and updates during this calculation to avoid recursion or UI flicker
-    bool old_sim = logic->isSimulation;
-    logic->isSimulation = true;
-
-    // 1. We need to analyze the position BEFORE the move for disambiguation.
-    // We'll temporarily undo the move if it's the last move in history.
-    bool was_undone = false;
-    Stack* history = (Stack*)logic->moveHistory;
-    if (history && history->top) {
-        Move* last = (Move*)history->top->data;
-        if (move_equals(last, move)) {
-            undo_move_internal(logic, false); // Pop but don't free
-            was_undone = true;
-        }
-    }
-
-    if (!was_undone) {
-        // If we can't safely undo (e.g. calculating SAN for historical move not at top),
-        // we fallback to UCI for now to ensure stability. 
-        // In the future we might want a "stateless" SAN generator.
-        move_to_uci(move, san);
-        logic->isSimulation = old_sim;
-        return;
-    }
+// SAN disambiguation for a move about to be played: the file, rank or both
+// of from when another piece of the same type can legally reach to as well
+static void san_disambiguation(GameLogic* logic, int from, int to, char* out) {
+    out[0] = '\0';
+    uint8_t moving = logic->mailbox[from];
+    if (moving == SQUARE_EMPTY) return;
+    PieceType type = SQUARE_TYPE(moving);
+    Player mover = SQUARE_OWNER(moving);
+    
+    Bitboard occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    Bitboard others;
+    switch (type) {
+        case PIECE_KNIGHT: others = bb_knight_attacks[to]; break;
+        case PIECE_BISHOP: others = bb_bishop_attacks(to, occupied); break;
+        case PIECE_ROOK:   others = bb_rook_attacks(to, occupied); break;
+        case PIECE_QUEEN:  others = bb_rook_attacks(to, occupied) | bb_bishop_attacks(to, occupied); break;
+        default:           return; // Pawns use the file on captures; there is one king
+    }
+    others &= logic->pieceBB[type] & logic->colorBB[mover] & ~BB_SQUARE(from);
+    
+    bool alternatives = false, same_file = false, same_rank = false;
+    while (others) {
+        int other = bb_pop_lsb(&others);
+        if (!gamelogic_simulate_packed_and_check_safety(logic, PACKED_MOVE(other, to, MOVE_TYPE_NORMAL), mover)) continue;
+        alternatives = true;
+        if (other % 8 == from % 8) same_file = true;
+        if (other / 8 == from / 8) same_rank = true;
+    }
+    if (!alternatives) return;
+    
+    int n = 0;
+    if (!same_file || same_rank) out[n++] = (char)('a' + (from % 8));
+    if (same_file) out[n++] = (char)('8' - (from / 8));
+    out[n] = '\0';
+}
 
-    // --- SAN Generation Logic (Position is now BEFORE the move) ---
-    char buffer[32] = {0};
+// Finish SAN once the move has been made (make_move_internal has filled in
+// the capture, castling and promotion fields of move)
+static void san_format(GameLogic* logic, const Move* move, const char* disambiguation, char* san, size_t san_size) {
+    char buffer[16];
     int ptr = 0;
-
+    
     if (move->isCastling) {
-        int c2 = move->to_sq % 8;
-        int c1 = move->from_sq % 8;
-        ptr = snprintf(buffer, sizeof(buffer), (c2 > c1) ? "O-O" : "O-O-O");
+        ptr = snprintf(buffer, sizeof(buffer), (move->to_sq % 8 > move->from_sq % 8) ? "O-O" : "O-O-O");
     } else {
         char pieceChar = get_san_piece_char(move->movedPieceType);
         if (pieceChar != '\0') {
             buffer[ptr++] = pieceChar;
-            
-            // Disambiguation
-            int count = 0;
-            Move** legal = gamelogic_get_all_legal_moves(logic, logic->turn, &count);
-            
-            bool same_file = false;
-            bool same_rank = false;
-            int alternatives = 0;
-            
-            for (int i = 0; i < count; i++) {
-                if (legal[i]->to_sq == move->to_sq && 
-                    legal[i]->movedPieceType == move->movedPieceType &&
-                    legal[i]->from_sq != move->from_sq) {
-                    
-                    alternatives++;
-                    if ((legal[i]->from_sq % 8) == (move->from_sq % 8)) same_file = true;
-                    if ((legal[i]->from_sq / 8) == (move->from_sq / 8)) same_rank = true;
-                }
-            }
-            
-            if (alternatives > 0) {
-                if (!same_file) {
-                    buffer[ptr++] = (char)('a' + (move->from_sq % 8));
-                } else if (!same_rank) {
-                    buffer[ptr++] = (char)('8' - (move->from_sq / 8));
-                } else {
-                    buffer[ptr++] = (char)('a' + (move->from_sq % 8));
-                    buffer[ptr++] = (char)('8' - (move->from_sq / 8));
-                }
-            }
-            
-            for (int i = 0; i < count; i++) move_free(legal[i]);
-            if (legal) free(legal);
-
-            if (move->capturedPieceType != NO_PIECE) {
-                buffer[ptr++] = 'x';
-            }
-        } else {
-            // Pawn move
-            if (move->capturedPieceType != NO_PIECE) {
-                buffer[ptr++] = (char)('a' + (move->from_sq % 8));
-                buffer[ptr++] = 'x';
-            }
+            for (const char* d = disambiguation; *d; d++) buffer[ptr++] = *d;
+            if (move->capturedPieceType != NO_PIECE) buffer[ptr++] = 'x';
+        } else if (move->capturedPieceType != NO_PIECE) {
+            buffer[ptr++] = (char)('a' + (move->from_sq % 8));
+            buffer[ptr++] = 'x';
         }
-        
-        // Destination square
         buffer[ptr++] = (char)('a' + (move->to_sq % 8));
         buffer[ptr++] = (char)('8' - (move->to_sq / 8));
-        
-        // Promotion
         if (move->promotionPiece != NO_PROMOTION) {
             buffer[ptr++] = '=';
             buffer[ptr++] = get_san_piece_char(move->promotionPiece);
         }
     }
-
-    // --- Redo move to check for Check/Mate marks ---
-    make_move_internal(logic, move);
     
-    // Check state AFTER move
-    if (gamelogic_is_checkmate(logic, logic->turn)) {
-        buffer[ptr++] = '#';
-    } else if (gamelogic_is_in_check(logic, logic->turn)) {
-        buffer[ptr++] = '+';
+    // Check or mate: only a side in check needs its replies counted
+    if (gamelogic_is_in_check(logic, logic->turn)) {
+        MoveBuffer replies;
+        buffer[ptr++] = gamelogic_generate_moves(logic, logic->turn, &replies) == 0 ? '#' : '+';
     }
     buffer[ptr] = '\0';
-
     snprintf(san, san_size, "%s", buffer);
+}
+
+const char* gamelogic_get_san_at(GameLogic* logic, int index) {
+    if (!logic || index < 0 || index >= logic->historyCount) return NULL;
+    const char* san = logic->history[index].san;
+    return san[0] ? san : NULL;
+}
+
+void gamelogic_get_move_san(GameLogic* logic, Move* move, char* san, size_t san_size) {
+    if (!logic || !move || !san || san_size == 0) return;
+    
+    // Only the last move can be rendered: SAN depends on the position before it
+    if (logic->historyCount == 0) {
+        move_to_uci(move, san);
+        return;
+    }
+    Ply* last = &logic->history[logic->historyCount - 1];
+    Move lastMove = move_from_ply(last);
+    if (!move_equals(&lastMove, move)) {
+        // Fall back to UCI rather than guess at an older position
+        move_to_uci(move, san);
+        return;
+    }
+    if (last->san[0]) {
+        snprintf(san, san_size, "%s", last->san);
+        return;
+    }
+    
+    // Recorded without SAN (e.g. rebuilt history): take the move back and replay it
+    bool old_sim = logic->isSimulation;
+    logic->isSimulation = true;
+    undo_move_internal(logic);
+    char disambiguation[3];
+    san_disambiguation(logic, move->from_sq, move->to_sq, disambiguation);
+    Move replay = *move;
+    make_move_internal(logic, &replay);
+    san_format(logic, &replay, disambiguation, san, san_size);
     logic->isSimulation = old_sim;
 }
 
@@ -1399,29 +1720,26 @@ void gamelogic_load_from_uci_moves(GameLogic* logic, const char* moves_uci, cons
             char* token = cursor;
             
             // Find matching move for this UCI token among all legal moves
-            int count = 0;
-            Move** legal_moves = gamelogic_get_all_legal_moves(logic, logic->turn, &count);
+            MoveBuffer legal;
+            gamelogic_generate_moves(logic, logic->turn, &legal);
             
-            Move* matched_move = NULL;
-            for (int i = 0; i < count; i++) {
+            PackedMove matched_move = PACKED_MOVE_NONE;
+            for (int i = 0; i < legal.count; i++) {
                 char current_uci[8];
-                move_to_uci(legal_moves[i], current_uci);
+                packed_move_to_uci(legal.moves[i], current_uci);
                 if (strcmp(current_uci, token) == 0) {
-                    matched_move = move_copy(legal_moves[i]);
+                    matched_move = legal.moves[i];
                     break;
                 }
             }
             
-            // Cleanup all generated legal moves
-            for (int i = 0; i < count; i++) move_free(legal_moves[i]);
-            if (legal_moves) free(legal_moves);
-            
-            if (matched_move) {
-                gamelogic_perform_move(logic, matched_move);
-                move_free(matched_move);
+            if (matched_move != PACKED_MOVE_NONE) {
+                Move m;
+                move_unpack(&m, matched_move, logic->turn);
+                gamelogic_perform_move(logic, &m);
             } else {
                 if(debug_mode) fprintf(stderr, "[Gamelogic] Replay: Could not match UCI move '%s' at ply %d\n", 
-                        token, ((Stack*)logic->moveHistory) ? ((Stack*)logic->moveHistory)->size : 0);
+                        token, logic->historyCount);
                 cursor[len] = saved; // Restore before break
                 break; 
             }
@@ -1437,33 +1755,6 @@ void gamelogic_load_from_uci_moves(GameLogic* logic, const char* moves_uci, cons
     free(moves_copy);
 }
 
-void gamelogic_rebuild_history(GameLogic* logic, Move** moves, int count) {
-    if (!logic) return;
-    
-    // Clear existing history
-    Stack* s = (Stack*)logic->moveHistory;
-    if (s) {
-        while (s->top) {
-            Move* m = (Move*)stack_pop(s);
-            move_free(m);
-        }
-    }
-    
-    // Reset status flags
-    logic->isGameOver = false;
-    logic->statusMessage[0] = '\0';
-    
-    if (!moves || count <= 0) return;
-    
-    // Push new history (up to count)
-    for (int i = 0; i < count; i++) {
-        if (moves[i]) {
-            Move* copy = move_copy(moves[i]);
-            stack_push(s, copy);
-        }
-    }
-}
-
 // --- Clock Interface Implementation ---
 
 bool gamelogic_tick_clock(GameLogic* logic) {
@@ -1527,8 +1818,7 @@ void gamelogic_start_clock_on_interaction(GameLogic* logic) {
     
     // Only if clock is enabled but NOT active (first move wait state)
     if (logic->clock.enabled && !logic->clock.active) {
-        Stack* history = (Stack*)logic->moveHistory;
-        bool isFirstMove = (!history || history->size == 0);
+        bool isFirstMove = (logic->historyCount == 0);
         
         if (isFirstMove) {
              // Start the clock NOW.
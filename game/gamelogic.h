@@ -2,15 +2,65 @@
 #define GAMELOGIC_H
 
 #include "types.h"
+#include "bitboard.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "clock.h"
 
+// Upper bound on moves in any position (the known maximum is 218)
+#define MOVE_BUFFER_CAPACITY 256
+
+// Fixed-capacity move buffer, meant to live on the caller's stack
+typedef struct {
+    PackedMove moves[MOVE_BUFFER_CAPACITY];
+    int count;
+} MoveBuffer;
+
+// State a ply destroys, kept so undo can restore it (8 bytes)
+typedef struct {
+    uint8_t movedPieceType;     // PieceType
+    uint8_t capturedPieceType;  // PieceType or NO_PIECE
+    uint8_t prevCastlingRights;
+    int8_t prevEnPassantCol;
+    uint16_t prevHalfmoveClock;
+    uint8_t mover;              // Player
+} UndoInfo;
+
+// Longest SAN is 7 characters ("exd8=Q+", "Qa1xb2#")
+#define PLY_SAN_SIZE 8
+
+// One entry of the game record: the packed move, its undo state, the
+// Zobrist hash of the position before it and the move's SAN
+typedef struct {
+    uint64_t hash;
+    PackedMove move;
+    UndoInfo undo;
+    char san[PLY_SAN_SIZE];     // Empty if the ply was not played through gamelogic_perform_move
+} Ply;
+
+// Clock readings before a ply, restored when it is taken back.
+// Kept apart from Ply so search-side make/undo never touches them.
+typedef struct {
+    int64_t whiteTimeMs;
+    int64_t blackTimeMs;
+} PlyClock;
+
+// Every HISTORY_SNAPSHOT_INTERVAL plies the position is kept the first time
+// the game passes through it, so navigation replays at most that many moves
+#define HISTORY_SNAPSHOT_INTERVAL 16
+
+typedef struct {
+    PositionSnapshot position;
+    bool valid;
+} HistorySnapshot;
+
 // GameLogic structure
 struct GameLogic {
-    // Board state
-    Piece* board[8][8];
+    // Board state: one byte per square plus bitboards, kept in sync by make/undo
+    uint8_t mailbox[64];    // SQUARE_ENCODE(type, owner), SQUARE_EMPTY if empty
+    Bitboard pieceBB[6];    // Indexed by PieceType, both colors
+    Bitboard colorBB[2];    // Indexed by Player
     
     // Game state
     GameMode gameMode;
@@ -35,16 +85,29 @@ struct GameLogic {
     
     // Position attributes
     uint8_t castlingRights; // Bitmask: WK=1, WQ=2, BK=4, BQ=8
+    int8_t castlingRookCol[2][2]; // [player][0 = kingside, 1 = queenside], -1 if none
+    bool chess960;          // Castling is encoded king-takes-rook, FEN rights by file
     int8_t enPassantCol;    // -1 if none
     int halfmoveClock;
     int fullmoveNumber;
     uint64_t currentHash;
     
-    // History for undo
-    void* moveHistory;  // Stack<Move>
+    // History for undo (contiguous, grows by doubling). Undone plies stay
+    // in place after historyCount as the redo stack.
+    Ply* history;
+    PlyClock* clockHistory; // Parallel to history
+    int historyCount;
+    int redoCount;
+    int historyCapacity;
+    PlyClock redoTipClock;  // Clock at the end of the line, while plies are undone
+
+    // snapshots[k] holds ply k * HISTORY_SNAPSHOT_INTERVAL of the current line
+    HistorySnapshot* snapshots;
+    int snapshotCount;
+    int snapshotCapacity;
     
     // Cache for single-piece move generation
-    void* cachedMoves;      // MoveList* (internal)
+    void* cachedMoves;      // MoveBuffer* (allocated on first use)
     int cachedPieceRow;
     int cachedPieceCol;
     uint64_t cachedVersion;
@@ -69,31 +132,84 @@ void gamelogic_reset(GameLogic* logic);
 GameMode gamelogic_get_game_mode(GameLogic* logic);
 void gamelogic_set_game_mode(GameLogic* logic, GameMode mode);
 
+// Board access. Returns NULL for an empty square; the pointer refers to a
+// shared constant, so it stays valid across moves but says nothing about them.
+const Piece* gamelogic_get_piece(GameLogic* logic, int r, int c);
+
+// Board editing (keeps mailbox and bitboards in sync)
+void gamelogic_clear_board(GameLogic* logic);
+void gamelogic_place_piece(GameLogic* logic, int r, int c, PieceType type, Player owner);
+// Rebuild bitboards and hash after mailbox was modified directly
+void gamelogic_sync_bitboards(GameLogic* logic);
+
 // Snapshot and Hashing
 void gamelogic_create_snapshot(GameLogic* logic, PositionSnapshot* snap);
 void gamelogic_restore_snapshot(GameLogic* logic, const PositionSnapshot* snap);
 uint64_t gamelogic_compute_hash(GameLogic* logic);
 
 // Move generation & validation
+// Allocation-free: fill buf with the legal moves and return the count
+int gamelogic_generate_moves(GameLogic* logic, Player player, MoveBuffer* buf);
+int gamelogic_generate_piece_moves(GameLogic* logic, int row, int col, MoveBuffer* buf);
+
+// Expand a generated move using the current board (piece types, mover)
+void gamelogic_unpack_move(GameLogic* logic, PackedMove pm, Move* out);
+
+// Compatibility wrappers returning heap-allocated Move objects
 void gamelogic_generate_legal_moves(GameLogic* logic, Player player, void* moves_list);
 Move** gamelogic_get_valid_moves_for_piece(GameLogic* logic, int row, int col, int* count);
 Move** gamelogic_get_all_legal_moves(GameLogic* logic, Player player, int* count);
 bool gamelogic_is_move_valid(GameLogic* logic, int startRow, int startCol, int endRow, int endCol);
 void gamelogic_free_moves_array(Move** moves, int count);
 
+// Playing the move the redo stack holds next keeps the rest of it; any
+// other move discards it
 bool gamelogic_perform_move(GameLogic* logic, Move* move);
 void gamelogic_undo_move(GameLogic* logic);
 
+// History navigation. Undone plies can be redone until a different move is
+// played. Jumps restore the nearest snapshot and replay from it, so their
+// cost does not grow with the distance travelled.
+bool gamelogic_redo_move(GameLogic* logic);
+void gamelogic_undo_moves(GameLogic* logic, int count);
+void gamelogic_redo_moves(GameLogic* logic, int count);
+// Move to ply 0..historyCount + redoCount (0 = start position)
+void gamelogic_jump_to_ply(GameLogic* logic, int ply);
+int gamelogic_get_redo_count(GameLogic* logic);
+// Forget the undone plies, keeping the line up to the current ply
+void gamelogic_drop_redo(GameLogic* logic);
+
+// Perft: count leaf nodes of the legal move tree to the given depth.
+// The divide variant reports each root move's subtree count (may pass NULL).
+typedef void (*PerftDivideCallback)(const char* uci, uint64_t nodes, void* user_data);
+uint64_t gamelogic_perft(GameLogic* logic, int depth);
+uint64_t gamelogic_perft_divide(GameLogic* logic, int depth, PerftDivideCallback callback, void* user_data);
+
 // Game state checks
 bool gamelogic_is_in_check(GameLogic* logic, Player player);
 bool gamelogic_is_checkmate(GameLogic* logic, Player player);
 bool gamelogic_is_stalemate(GameLogic* logic, Player player);
+bool gamelogic_is_threefold_repetition(GameLogic* logic);
+bool gamelogic_is_fifty_move_draw(GameLogic* logic);
+bool gamelogic_is_insufficient_material(GameLogic* logic);
 bool gamelogic_is_computer(GameLogic* logic, Player player);
 
-// FEN generation
+// FEN generation. Castling rights are KQkq, or X-FEN rook files (e.g. "HAha")
+// where a letter alone would not say which rook may castle. Loading accepts
+// KQkq, X-FEN and Shredder-FEN and switches to Chess960 rules when the king
+// or rooks are not on their standard squares.
 void gamelogic_generate_fen(GameLogic* logic, char* fen, size_t fen_size);
 void gamelogic_load_fen(GameLogic* logic, const char* fen);
 
+// Chess960. Castling moves are generated as the king capturing its own
+// rook (UCI_Chess960 notation); a king move onto the castling square
+// ("e1g1") is still understood when it is unambiguous.
+void gamelogic_set_chess960(GameLogic* logic, bool enabled);
+// Set up start position 0..959 (518 is the standard position)
+void gamelogic_setup_chess960(GameLogic* logic, int index);
+// For a castling move: the king's and rook's final squares and the rook's start
+bool gamelogic_castling_squares(GameLogic* logic, int from, int to, int* king_to, int* rook_from, int* rook_to);
+
 // Move validation
 bool gamelogic_simulate_move_and_check_safety(GameLogic* logic, Move* m, Player p);
 
@@ -112,6 +228,7 @@ Player gamelogic_get_player_side(GameLogic* logic);
 void gamelogic_update_game_state(GameLogic* logic);
 
 // Square safety
+Bitboard gamelogic_attackers_to(GameLogic* logic, int sq, Bitboard occupied);
 bool gamelogic_is_square_safe(GameLogic* logic, int r, int c, Player p);
 int gamelogic_count_hanging_pieces(GameLogic* logic, Player player);
 
@@ -120,13 +237,13 @@ void gamelogic_handle_game_end_learning(GameLogic* logic, Player winner);
 
 // SAN and PGN
 void gamelogic_get_move_uci(GameLogic* logic, Move* move, char* uci, size_t uci_size);
+// SAN of the last move (computed when it was played); other moves come back as UCI
 void gamelogic_get_move_san(GameLogic* logic, Move* move, char* san, size_t san_size);
+// SAN stored with ply index, or NULL if it was not recorded
+const char* gamelogic_get_san_at(GameLogic* logic, int index);
 
 void gamelogic_load_from_uci_moves(GameLogic* logic, const char* moves_uci, const char* start_fen);
 
-// Reconstruct history stack (e.g. for replay)
-void gamelogic_rebuild_history(GameLogic* logic, Move** moves, int count);
-
 // Clock Interface
 bool gamelogic_tick_clock(GameLogic* logic);
 void gamelogic_set_clock(GameLogic* logic, int minutes, int increment);
@@ -1,35 +1,23 @@
 #include "gamelogic.h"
 #include "move.h"
 #include <stdlib.h>
+#include <string.h>
 
 // Forward declarations
 static bool is_valid_pos(int r, int c);
-static void get_pseudo_moves(GameLogic* logic, int r, int c, Piece* p, void* moves_list);
-static void add_moves_single_step(GameLogic* logic, int r, int c, int offsets[][2], int num_offsets, void* moves_list, Player owner, PieceType movedType);
-static void add_linear_moves(GameLogic* logic, int r, int c, int dirs[][2], int num_dirs, void* moves_list, Player owner, PieceType movedType);
+static void get_pseudo_moves(GameLogic* logic, int sq, MoveBuffer* buf);
+static void add_target_moves(int from, Bitboard targets, MoveBuffer* buf);
 static bool can_castle(GameLogic* logic, int r, int kCol, int rCol);
 
-// Simple list for moves (we'll use a dynamic array)
+extern bool gamelogic_simulate_packed_and_check_safety(GameLogic* logic, PackedMove pm, Player p);
+
+// Legacy heap list (layout shared with callers of gamelogic_generate_legal_moves)
 typedef struct {
     Move** moves;
     int count;
     int capacity;
 } MoveList;
 
-static MoveList* movelist_create(void) {
-    MoveList* list = (MoveList*)malloc(sizeof(MoveList));
-    if (list) {
-        list->capacity = 32;
-        list->count = 0;
-        list->moves = (Move**)malloc(sizeof(Move*) * list->capacity);
-        if (!list->moves) {
-            free(list);
-            return NULL;
-        }
-    }
-    return list;
-}
-
 static void movelist_clear(MoveList* list) {
     if (!list) return;
     for (int i = 0; i < list->count; i++) {
@@ -41,7 +29,7 @@ static void movelist_clear(MoveList* list) {
 static void movelist_add(MoveList* list, Move* move) {
     if (!list || !move) return;
     if (list->count >= list->capacity) {
-        int new_cap = list->capacity * 2;
+        int new_cap = list->capacity > 0 ? list->capacity * 2 : 32;
         Move** new_moves = (Move**)realloc(list->moves, sizeof(Move*) * new_cap);
         if (!new_moves) return; // Fail safe, don't crash
         list->moves = new_moves;
@@ -50,280 +38,294 @@ static void movelist_add(MoveList* list, Move* move) {
     list->moves[list->count++] = move;
 }
 
-static void movelist_free(MoveList* list) {
-    if (!list) return;
-    for (int i = 0; i < list->count; i++) {
-        move_free(list->moves[i]);
+static void buffer_add(MoveBuffer* buf, PackedMove pm) {
+    if (buf->count >= MOVE_BUFFER_CAPACITY) return;
+    buf->moves[buf->count++] = pm;
+}
+
+// Per-position legality masks, computed once before filtering
+typedef struct {
+    int kingSq;            // -1 if the side has no king (puzzle/tutorial setups)
+    Player opponent;
+    Bitboard occupied;
+    Bitboard checkers;     // Enemy pieces giving check
+    Bitboard evasionMask;  // Non-king moves must land here (all squares when not in check)
+    Bitboard pinned;       // Own pieces pinned to the king
+    Bitboard pinRay[64];   // For pinned squares: the line they may still move along
+} LegalityMasks;
+
+static void compute_legality_masks(GameLogic* logic, Player player, LegalityMasks* lm) {
+    Player opp = (player == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+    Bitboard king = logic->pieceBB[PIECE_KING] & logic->colorBB[player];
+    
+    lm->opponent = opp;
+    lm->occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    lm->checkers = BB_EMPTY;
+    lm->evasionMask = ~BB_EMPTY;
+    lm->pinned = BB_EMPTY;
+    lm->kingSq = king ? bb_lsb(king) : -1;
+    if (lm->kingSq < 0) return;
+    
+    int k = lm->kingSq;
+    Bitboard enemies = logic->colorBB[opp];
+    lm->checkers = gamelogic_attackers_to(logic, k, lm->occupied) & enemies;
+    
+    int numCheckers = bb_popcount(lm->checkers);
+    if (numCheckers == 1) {
+        int checkerSq = bb_lsb(lm->checkers);
+        lm->evasionMask = lm->checkers | bb_between[k][checkerSq];
+    } else if (numCheckers > 1) {
+        lm->evasionMask = BB_EMPTY; // Double check: only the king may move
+    }
+    
+    // Enemy sliders that would see the king through own pieces only
+    Bitboard rookLike = (logic->pieceBB[PIECE_ROOK] | logic->pieceBB[PIECE_QUEEN]) & enemies;
+    Bitboard bishopLike = (logic->pieceBB[PIECE_BISHOP] | logic->pieceBB[PIECE_QUEEN]) & enemies;
+    Bitboard snipers = (bb_rook_attacks(k, enemies) & rookLike) | (bb_bishop_attacks(k, enemies) & bishopLike);
+    while (snipers) {
+        int s = bb_pop_lsb(&snipers);
+        Bitboard blockers = bb_between[k][s] & lm->occupied;
+        if (bb_popcount(blockers) == 1 && (blockers & logic->colorBB[player])) {
+            lm->pinned |= blockers;
+            lm->pinRay[bb_lsb(blockers)] = bb_between[k][s] | BB_SQUARE(s);
+        }
     }
-    free(list->moves);
-    free(list);
 }
 
-// Generate legal moves for a player
-void gamelogic_generate_legal_moves(GameLogic* logic, Player player, void* moves_list) {
-    if (!logic) return;
+static bool is_move_legal(GameLogic* logic, const LegalityMasks* lm, PackedMove pm, Player player) {
+    if (lm->kingSq < 0) return true; // No king: nothing to expose
     
-    MoveList* pseudo_moves = movelist_create();
+    int from = PACKED_FROM(pm);
+    int to = PACKED_TO(pm);
+    if (from == lm->kingSq) {
+        // Castling squares are checked by can_castle
+        if (PACKED_TYPE(pm) == MOVE_TYPE_CASTLING) return true;
+        // The king must not stay on the line of a slider it is moving away from
+        Bitboard occ = lm->occupied & ~BB_SQUARE(lm->kingSq);
+        return (gamelogic_attackers_to(logic, to, occ) & logic->colorBB[lm->opponent]) == 0;
+    }
     
-    // Generate pseudo-legal moves
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            Piece* p = logic->board[r][c];
-            if (p && p->owner == player) {
-                get_pseudo_moves(logic, r, c, p, pseudo_moves);
-            }
+    // En passant removes two pieces from a rank; rare enough to simulate
+    if (PACKED_TYPE(pm) == MOVE_TYPE_EN_PASSANT) {
+        return gamelogic_simulate_packed_and_check_safety(logic, pm, player);
+    }
+    
+    if (!(lm->evasionMask & BB_SQUARE(to))) return false;
+    if ((lm->pinned & BB_SQUARE(from)) && !(lm->pinRay[from] & BB_SQUARE(to))) return false;
+    return true;
+}
+
+// Drop pseudo-legal moves that leave the king attacked (in place)
+static int filter_legal(GameLogic* logic, const LegalityMasks* lm, MoveBuffer* buf, Player player) {
+    int kept = 0;
+    for (int i = 0; i < buf->count; i++) {
+        if (is_move_legal(logic, lm, buf->moves[i], player)) {
+            buf->moves[kept++] = buf->moves[i];
         }
     }
+    buf->count = kept;
+    return kept;
+}
+
+// Generate legal moves for a player into a caller-provided buffer
+int gamelogic_generate_moves(GameLogic* logic, Player player, MoveBuffer* buf) {
+    if (!buf) return 0;
+    buf->count = 0;
+    if (!logic) return 0;
     
-    // Filter to only legal moves
-    MoveList* legal_moves = (MoveList*)moves_list;
-    if (!legal_moves) {
-        // If caller passed NULL, we can't return anything. 
-        // To avoid leak, just free pseudo and return.
-        movelist_free(pseudo_moves);
-        return;
+    LegalityMasks lm;
+    compute_legality_masks(logic, player, &lm);
+    
+    // Generate pseudo-legal moves (in double check only the king can move)
+    Bitboard own = logic->colorBB[player];
+    if (bb_popcount(lm.checkers) > 1) own &= logic->pieceBB[PIECE_KING];
+    while (own) {
+        get_pseudo_moves(logic, bb_pop_lsb(&own), buf);
     }
     
+    return filter_legal(logic, &lm, buf, player);
+}
+
+// Compatibility: fill a caller-owned MoveList with heap Move copies
+void gamelogic_generate_legal_moves(GameLogic* logic, Player player, void* moves_list) {
+    MoveList* legal_moves = (MoveList*)moves_list;
+    if (!logic || !legal_moves) return;
+    
     // Clear list to prevent accumulation
     movelist_clear(legal_moves);
     
-    // Declare extern for simulate function
-    extern bool gamelogic_simulate_move_and_check_safety(GameLogic* logic, Move* m, Player p);
+    MoveBuffer buf;
+    gamelogic_generate_moves(logic, player, &buf);
+    for (int i = 0; i < buf.count; i++) {
+        Move* m = move_create(0, 0);
+        if (!m) break;
+        gamelogic_unpack_move(logic, buf.moves[i], m);
+        movelist_add(legal_moves, m);
+    }
+}
+
+// Piece types come from the board, so call this before the move is made
+void gamelogic_unpack_move(GameLogic* logic, PackedMove pm, Move* out) {
+    if (!logic || !out) return;
+    int from = PACKED_FROM(pm);
+    int to = PACKED_TO(pm);
+    uint8_t moving = logic->mailbox[from];
+    uint8_t target = logic->mailbox[to];
     
-    for (int i = 0; i < pseudo_moves->count; i++) {
-        Move* m = pseudo_moves->moves[i];
-        if (gamelogic_simulate_move_and_check_safety(logic, m, player)) {
-             // Use move_copy to preserve ALL fields (isEnPassant, isCastling, promotionPiece, etc.)
-             Move* mp = move_copy(m);
-             if (mp) {
-                 mp->mover = player;
-                 movelist_add(legal_moves, mp);
-             }
+    move_unpack(out, pm, moving != SQUARE_EMPTY ? SQUARE_OWNER(moving) : logic->turn);
+    if (moving != SQUARE_EMPTY) out->movedPieceType = (uint8_t)SQUARE_TYPE(moving);
+    if (PACKED_TYPE(pm) == MOVE_TYPE_EN_PASSANT) {
+        out->capturedPieceType = PIECE_PAWN;
+    } else if (target != SQUARE_EMPTY) {
+        out->capturedPieceType = (uint8_t)SQUARE_TYPE(target);
+    }
+}
+
+// Append pawn moves to a square, expanding promotions
+static void add_pawn_move(MoveBuffer* buf, int from, int to, bool isPromo) {
+    if (isPromo) {
+        PieceType promos[] = {PIECE_QUEEN, PIECE_ROOK, PIECE_BISHOP, PIECE_KNIGHT};
+        for (int k = 0; k < 4; k++) {
+            buffer_add(buf, PACKED_PROMOTION(from, to, promos[k]));
         }
+    } else {
+        buffer_add(buf, PACKED_MOVE(from, to, MOVE_TYPE_NORMAL));
     }
-    
-    // Free pseudo moves
-    movelist_free(pseudo_moves);
 }
 
-// Get pseudo-legal moves for a piece
-static void get_pseudo_moves(GameLogic* logic, int r, int c, Piece* p, void* moves_list) {
-    MoveList* moves = (MoveList*)moves_list;
-    if (!moves || !p) return;
+// Get pseudo-legal moves for the piece on sq
+static void get_pseudo_moves(GameLogic* logic, int sq, MoveBuffer* buf) {
+    uint8_t val = logic->mailbox[sq];
+    if (!buf || val == SQUARE_EMPTY) return;
     
-    int forward = (p->owner == PLAYER_WHITE) ? -1 : 1;
+    PieceType type = SQUARE_TYPE(val);
+    Player owner = SQUARE_OWNER(val);
+    Player opp = (owner == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+    Bitboard occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    Bitboard notOwn = ~logic->colorBB[owner];
+    int r = sq / 8;
+    int c = sq % 8;
     
-    switch (p->type) {
+    switch (type) {
         case PIECE_PAWN: {
-            // Forward move
-            if (is_valid_pos(r + forward, c) && logic->board[r + forward][c] == NULL) {
-                bool isPromo = (p->owner == PLAYER_WHITE && r + forward == 0) || (p->owner == PLAYER_BLACK && r + forward == 7);
-                if (isPromo) {
-                    PieceType promos[] = {PIECE_QUEEN, PIECE_ROOK, PIECE_BISHOP, PIECE_KNIGHT};
-                    for(int k=0; k<4; k++) {
-                    Move* m = move_create(r * 8 + c, (r + forward) * 8 + c);
-                    m->promotionPiece = promos[k];
-                    m->movedPieceType = PIECE_PAWN;
-                    movelist_add(moves, m);
-                    }
-                } else {
-                    Move* m = move_create(r * 8 + c, (r + forward) * 8 + c);
-                    m->movedPieceType = PIECE_PAWN;
-                    movelist_add(moves, m);
-                }
+            int forward = (owner == PLAYER_WHITE) ? -8 : 8;
+            int promoRow = (owner == PLAYER_WHITE) ? 0 : 7;
+            int startRow = (owner == PLAYER_WHITE) ? 6 : 1;
+            int epRow = (owner == PLAYER_WHITE) ? 3 : 4;
+            int oneStep = sq + forward;
+            
+            // Forward moves
+            if (oneStep >= 0 && oneStep < 64 && !(occupied & BB_SQUARE(oneStep))) {
+                add_pawn_move(buf, sq, oneStep, (oneStep / 8) == promoRow);
                 
-                // Double move from starting position
-                bool isStartRank = (p->owner == PLAYER_WHITE && r == 6) || 
-                                  (p->owner == PLAYER_BLACK && r == 1);
-                if (!p->hasMoved && isStartRank && is_valid_pos(r + (forward * 2), c) && 
-                    logic->board[r + (forward * 2)][c] == NULL) {
-                    // Start rank moves can't be promotions, so just add
-                    Move* m = move_create(r * 8 + c, (r + (forward * 2)) * 8 + c);
-                    m->movedPieceType = PIECE_PAWN;
-                    movelist_add(moves, m);
+                // Double move from starting position (start rank can't promote)
+                int twoStep = oneStep + forward;
+                if (r == startRow && !(occupied & BB_SQUARE(twoStep))) {
+                    add_pawn_move(buf, sq, twoStep, false);
                 }
             }
             
-            // Capture moves
-            int cols[] = {c - 1, c + 1};
-            for (int i = 0; i < 2; i++) {
-                int targetCol = cols[i];
-                if (is_valid_pos(r + forward, targetCol)) {
-                    Piece* target = logic->board[r + forward][targetCol];
-                    if (target && target->owner != p->owner) {
-                        bool isPromo = (p->owner == PLAYER_WHITE && r + forward == 0) || (p->owner == PLAYER_BLACK && r + forward == 7);
-                        if (isPromo) {
-                            PieceType promos[] = {PIECE_QUEEN, PIECE_ROOK, PIECE_BISHOP, PIECE_KNIGHT};
-                            for(int k=0; k<4; k++) {
-                                Move* m = move_create(r * 8 + c, (r + forward) * 8 + targetCol);
-                                m->promotionPiece = promos[k];
-                                m->capturedPieceType = target->type;
-                                m->movedPieceType = PIECE_PAWN;
-                                movelist_add(moves, m);
-                            }
-                        } else {
-                            Move* m = move_create(r * 8 + c, (r + forward) * 8 + targetCol);
-                            m->capturedPieceType = target->type;
-                            m->movedPieceType = PIECE_PAWN;
-                            movelist_add(moves, m);
-                        }
-                    }
-                    // En passant
-                    // En passant can only be done from the 5th rank (row 3 for white, row 4 for black)
-                    if (target == NULL && 
-                        ((p->owner == PLAYER_WHITE && r == 3) || (p->owner == PLAYER_BLACK && r == 4)) &&
-                        targetCol == logic->enPassantCol && logic->enPassantCol != -1) {
-                        
-                        // Explicit safety check: adjacent column
-                        if (abs(targetCol - c) == 1) {
-                            Piece* epPawn = logic->board[r][targetCol];
-                            if (epPawn && epPawn->type == PIECE_PAWN && epPawn->owner != p->owner) {
-                                Move* epMove = move_create(r * 8 + c, (r + forward) * 8 + targetCol);
-                                epMove->isEnPassant = 1;  // Mark as en passant move
-                                epMove->capturedPieceType = epPawn->type;
-                                epMove->movedPieceType = PIECE_PAWN;
-                                movelist_add(moves, epMove);
-                            }
-                        }
-                    }
+            // Captures
+            Bitboard captures = bb_pawn_attacks[owner][sq] & logic->colorBB[opp];
+            while (captures) {
+                int to = bb_pop_lsb(&captures);
+                add_pawn_move(buf, sq, to, (to / 8) == promoRow);
+            }
+            
+            // En passant can only be done from the 5th rank (row 3 for white, row 4 for black)
+            if (logic->enPassantCol != -1 && r == epRow && abs(logic->enPassantCol - c) == 1) {
+                int epPawnSq = r * 8 + logic->enPassantCol;
+                int to = epPawnSq + forward;
+                if (logic->mailbox[epPawnSq] == SQUARE_ENCODE(PIECE_PAWN, opp) &&
+                    !(occupied & BB_SQUARE(to))) {
+                    buffer_add(buf, PACKED_MOVE(sq, to, MOVE_TYPE_EN_PASSANT));
                 }
             }
             break;
         }
         
-        case PIECE_KNIGHT: {
-            int offsets[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, 
-                                {1, -2}, {1, 2}, {2, -1}, {2, 1}};
-            add_moves_single_step(logic, r, c, offsets, 8, moves, p->owner, PIECE_KNIGHT);
+        case PIECE_KNIGHT:
+            add_target_moves(sq, bb_knight_attacks[sq] & notOwn, buf);
             break;
-        }
         
         case PIECE_KING: {
-            int offsets[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, 
-                                {0, 1}, {1, -1}, {1, 0}, {1, 1}};
-            add_moves_single_step(logic, r, c, offsets, 8, moves, p->owner, PIECE_KING);
+            add_target_moves(sq, bb_king_attacks[sq] & notOwn, buf);
             
-            // Castling
-            if (!p->hasMoved && !gamelogic_is_in_check(logic, p->owner)) {
-                // Kingside
-                if (can_castle(logic, r, c, 7)) {
-                    Move* m = move_create(r * 8 + c, r * 8 + 6);
-                    m->isCastling = true;
-                    m->movedPieceType = PIECE_KING;
-                    movelist_add(moves, m);
-                }
-                // Queenside
-                if (can_castle(logic, r, c, 0)) {
-                    Move* m = move_create(r * 8 + c, r * 8 + 2);
-                    m->isCastling = true;
-                    m->movedPieceType = PIECE_KING;
-                    movelist_add(moves, m);
+            // Castling: castlingRights is the only record of whether the king
+            // and rook have moved (make clears it, undo restores it)
+            uint8_t kingsideRight = (owner == PLAYER_WHITE) ? 1 : 4;
+            if (r == ((owner == PLAYER_WHITE) ? 7 : 0) && (logic->castlingRights & (kingsideRight * 3)) &&
+                !gamelogic_is_in_check(logic, owner)) {
+                for (int side = 0; side < 2; side++) {
+                    int rookCol = logic->castlingRookCol[owner][side];
+                    if (!(logic->castlingRights & (kingsideRight << side)) || !can_castle(logic, r, c, rookCol)) continue;
+                    // Chess960 castles king-takes-rook; standard chess moves the king two files
+                    bool standard = !logic->chess960 && c == 4 && rookCol == (side == 0 ? 7 : 0);
+                    int to = standard ? r * 8 + (side == 0 ? 6 : 2) : r * 8 + rookCol;
+                    buffer_add(buf, PACKED_MOVE(sq, to, MOVE_TYPE_CASTLING));
                 }
             }
             break;
         }
         
-        case PIECE_ROOK: {
-            int dirs[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-            add_linear_moves(logic, r, c, dirs, 4, moves, p->owner, PIECE_ROOK);
+        case PIECE_ROOK:
+            add_target_moves(sq, bb_rook_attacks(sq, occupied) & notOwn, buf);
             break;
-        }
         
-        case PIECE_BISHOP: {
-            int dirs[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-            add_linear_moves(logic, r, c, dirs, 4, moves, p->owner, PIECE_BISHOP);
+        case PIECE_BISHOP:
+            add_target_moves(sq, bb_bishop_attacks(sq, occupied) & notOwn, buf);
             break;
-        }
         
-        case PIECE_QUEEN: {
-            int dirs[8][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}, 
-                             {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-            add_linear_moves(logic, r, c, dirs, 8, moves, p->owner, PIECE_QUEEN);
+        case PIECE_QUEEN:
+            add_target_moves(sq, (bb_rook_attacks(sq, occupied) | bb_bishop_attacks(sq, occupied)) & notOwn,
+                             buf);
             break;
-        }
-    }
-}
-
-// Add single-step moves (Knight, King)
-static void add_moves_single_step(GameLogic* logic, int r, int c, int offsets[][2], int num_offsets, void* moves_list, Player owner, PieceType movedType) {
-    MoveList* moves = (MoveList*)moves_list;
-    if (!moves) return;
-    
-    for (int i = 0; i < num_offsets; i++) {
-        int nr = r + offsets[i][0];
-        int nc = c + offsets[i][1];
-        if (is_valid_pos(nr, nc)) {
-            Piece* target = logic->board[nr][nc];
-            if (target == NULL) {
-                 Move* m = move_create(r * 8 + c, nr * 8 + nc);
-                 m->movedPieceType = movedType;
-                 movelist_add(moves, m);
-            } else if (target->owner != owner) {
-                 Move* m = move_create(r * 8 + c, nr * 8 + nc);
-                 m->capturedPieceType = target->type;
-                 m->movedPieceType = movedType;
-                 movelist_add(moves, m);
-            }
-        }
     }
 }
 
-// Add linear moves (Rook, Bishop, Queen)
-static void add_linear_moves(GameLogic* logic, int r, int c, int dirs[][2], int num_dirs, void* moves_list, Player owner, PieceType movedType) {
-    MoveList* moves = (MoveList*)moves_list;
-    if (!moves) return;
-    
-    for (int i = 0; i < num_dirs; i++) {
-        int nr = r + dirs[i][0];
-        int nc = c + dirs[i][1];
-        while (is_valid_pos(nr, nc)) {
-            Piece* target = logic->board[nr][nc];
-            if (target == NULL) {
-                Move* m = move_create(r * 8 + c, nr * 8 + nc);
-                m->movedPieceType = movedType;
-                movelist_add(moves, m);
-            } else {
-                if (target->owner != owner) {
-                    Move* m = move_create(r * 8 + c, nr * 8 + nc);
-                    m->capturedPieceType = target->type;
-                    m->movedPieceType = movedType;
-                    movelist_add(moves, m);
-                }
-                break;
-            }
-            nr += dirs[i][0];
-            nc += dirs[i][1];
-        }
+// Add one move per target square
+static void add_target_moves(int from, Bitboard targets, MoveBuffer* buf) {
+    while (targets) {
+        buffer_add(buf, PACKED_MOVE(from, bb_pop_lsb(&targets), MOVE_TYPE_NORMAL));
     }
 }
 
 // Check if castling is possible
 static bool can_castle(GameLogic* logic, int r, int kCol, int rCol) {
-    Piece* rook = logic->board[r][rCol];
-    // Check rook exists, is rook, has not moved, AND belongs to same owner as king
-    if (!rook || rook->type != PIECE_ROOK || rook->hasMoved) return false;
-    Piece* king = logic->board[r][kCol];
-    if (!king || king->owner != rook->owner) return false;
-    
-    // Path must be clear
-    int start = (kCol < rCol) ? kCol + 1 : rCol + 1;
-    int end = (kCol > rCol) ? kCol : rCol;
-    for (int i = start; i < end; i++) {
-        if (logic->board[r][i] != NULL) return false;
+    uint8_t king = logic->mailbox[r * 8 + kCol];
+    // Rook must stand on its castling square and belong to the king's side
+    if (king == SQUARE_EMPTY || rCol < 0 || logic->mailbox[r * 8 + rCol] != SQUARE_ENCODE(PIECE_ROOK, SQUARE_OWNER(king))) {
+        return false;
     }
+    Player p = SQUARE_OWNER(king);
     
-    // Safety checks
-    // King check already done above
-    if (!king) return false;
-    Player p = king->owner;
-    int step = (rCol > kCol) ? 1 : -1;
+    // King and rook land on the g/f files (kingside) or c/d files (queenside),
+    // wherever they started (Chess960)
+    bool kingside = rCol > kCol;
+    int kTo = kingside ? 6 : 2;
+    int rTo = kingside ? 5 : 3;
     
-    // Check intermediate square (need to declare extern)
-    extern bool gamelogic_is_square_safe(GameLogic* logic, int r, int c, Player p);
-    if (!gamelogic_is_square_safe(logic, r, kCol + step, p)) return false;
+    // Everything between the four squares must be empty, king and rook aside
+    Bitboard occupied = (logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK]) &
+                        ~(BB_SQUARE(r * 8 + kCol) | BB_SQUARE(r * 8 + rCol));
+    int lo = kCol < rCol ? kCol : rCol;
+    int hi = kCol > rCol ? kCol : rCol;
+    if (kTo < lo) lo = kTo;
+    if (rTo < lo) lo = rTo;
+    if (kTo > hi) hi = kTo;
+    if (rTo > hi) hi = rTo;
+    for (int i = lo; i <= hi; i++) {
+        if (occupied & BB_SQUARE(r * 8 + i)) return false;
+    }
     
-    // Check landing square
-    if (!gamelogic_is_square_safe(logic, r, kCol + (step * 2), p)) return false;
+    // No square the king crosses (or lands on) may be attacked. The castling
+    // rook is left out, since it no longer shields the king afterwards.
+    Bitboard enemies = logic->colorBB[(p == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE];
+    int step = (kTo > kCol) ? 1 : -1;
+    for (int i = kCol; ; i += step) {
+        if (gamelogic_attackers_to(logic, r * 8 + i, occupied) & enemies) return false;
+        if (i == kTo) break;
+    }
     
     return true;
 }
@@ -335,98 +337,105 @@ static bool is_valid_pos(int r, int c) {
 
 // --- Cache Management and UI API ---
 
+// Invalidate the single-piece cache (the buffer itself is kept for reuse)
 void gamelogic_clear_cache(GameLogic* logic) {
     if (!logic) return;
-    if (logic->cachedMoves) {
-        movelist_free((MoveList*)logic->cachedMoves);
-        logic->cachedMoves = NULL;
-    }
     logic->cachedPieceRow = -1;
     logic->cachedPieceCol = -1;
     logic->cachedVersion = 0;
 }
 
-static Move** move_array_clone(MoveList* list, int* count) {
-    if (!list || list->count == 0) {
-        *count = 0;
-        return NULL;
-    }
-    *count = list->count;
-    Move** arr = (Move**)malloc(sizeof(Move*) * list->count);
-    for (int i = 0; i < list->count; i++) {
-        arr[i] = move_copy(list->moves[i]);
-    }
-    return arr;
+// Release the cache buffer (gamelogic_free)
+void gamelogic_free_cache(GameLogic* logic) {
+    if (!logic) return;
+    free(logic->cachedMoves);
+    logic->cachedMoves = NULL;
+    gamelogic_clear_cache(logic);
 }
 
-Move** gamelogic_get_valid_moves_for_piece(GameLogic* logic, int row, int col, int* count) {
-    if (!logic || !is_valid_pos(row, col)) {
+static Move** move_array_from_buffer(GameLogic* logic, const MoveBuffer* buf, int* count) {
+    if (!buf || buf->count == 0) {
+        if (count) *count = 0;
+        return NULL;
+    }
+    Move** arr = (Move**)malloc(sizeof(Move*) * buf->count);
+    if (!arr) {
         if (count) *count = 0;
         return NULL;
     }
+    for (int i = 0; i < buf->count; i++) {
+        arr[i] = move_create(0, 0);
+        if (arr[i]) gamelogic_unpack_move(logic, buf->moves[i], arr[i]);
+    }
+    if (count) *count = buf->count;
+    return arr;
+}
 
+// Legal moves for the piece on (row, col). Results are cached per position
+// version, so repeated hover/click queries on the same piece are a memcpy.
+int gamelogic_generate_piece_moves(GameLogic* logic, int row, int col, MoveBuffer* buf) {
+    if (!buf) return 0;
+    buf->count = 0;
+    if (!logic || !is_valid_pos(row, col)) return 0;
+    
+    MoveBuffer* cache = (MoveBuffer*)logic->cachedMoves;
+    
     // Check cache
-    if (logic->cachedMoves && logic->cachedPieceRow == row && logic->cachedPieceCol == col && logic->cachedVersion == logic->positionVersion) {
-        return move_array_clone((MoveList*)logic->cachedMoves, count);
+    if (cache && logic->cachedPieceRow == row && logic->cachedPieceCol == col && logic->cachedVersion == logic->positionVersion) {
+        buf->count = cache->count;
+        memcpy(buf->moves, cache->moves, sizeof(PackedMove) * cache->count);
+        return buf->count;
     }
     
     // Cache miss - regenerate
     gamelogic_clear_cache(logic);
     
-    Piece* p = logic->board[row][col];
-    if (!p) {
-        if (count) *count = 0;
-        return NULL;
-    }
+    uint8_t val = logic->mailbox[row * 8 + col];
+    if (val == SQUARE_EMPTY) return 0;
+    Player owner = SQUARE_OWNER(val);
     
     // UI ARBITRATION: Don't show moves for pieces that aren't for the current turn
-    if (p->owner != logic->turn && !logic->isSimulation) {
-        if (count) *count = 0;
-        return NULL;
-    }
-    
-    MoveList* pseudo = movelist_create();
-    get_pseudo_moves(logic, row, col, p, pseudo);
-    
-    MoveList* valid = movelist_create();
+    if (owner != logic->turn && !logic->isSimulation) return 0;
     
-    extern bool gamelogic_simulate_move_and_check_safety(GameLogic* logic, Move* m, Player p);
-    
-    for (int i = 0; i < pseudo->count; i++) {
-        Move* m = pseudo->moves[i];
-        if (gamelogic_simulate_move_and_check_safety(logic, m, p->owner)) {
-            // Use move_copy to preserve all fields
-            Move* clone = move_copy(m);
-            if (clone) movelist_add(valid, clone);
-        }
-    }
-    
-    movelist_free(pseudo);
+    LegalityMasks lm;
+    compute_legality_masks(logic, owner, &lm);
+    get_pseudo_moves(logic, row * 8 + col, buf);
+    filter_legal(logic, &lm, buf, owner);
     
     // Store in cache
-    logic->cachedMoves = valid;
-    logic->cachedPieceRow = row;
-    logic->cachedPieceCol = col;
-    logic->cachedVersion = logic->positionVersion;
+    if (!cache) {
+        cache = (MoveBuffer*)malloc(sizeof(MoveBuffer));
+        logic->cachedMoves = cache;
+    }
+    if (cache) {
+        cache->count = buf->count;
+        memcpy(cache->moves, buf->moves, sizeof(PackedMove) * buf->count);
+        logic->cachedPieceRow = row;
+        logic->cachedPieceCol = col;
+        logic->cachedVersion = logic->positionVersion;
+    }
     
-    return move_array_clone(valid, count);
+    return buf->count;
+}
+
+Move** gamelogic_get_valid_moves_for_piece(GameLogic* logic, int row, int col, int* count) {
+    MoveBuffer buf;
+    gamelogic_generate_piece_moves(logic, row, col, &buf);
+    if (buf.count == 0) {
+        if (count) *count = 0;
+        return NULL;
+    }
+    return move_array_from_buffer(logic, &buf, count);
 }
 
 bool gamelogic_is_move_valid(GameLogic* logic, int startRow, int startCol, int endRow, int endCol) {
-    int count = 0;
-    Move** moves = gamelogic_get_valid_moves_for_piece(logic, startRow, startCol, &count);
+    MoveBuffer buf;
+    gamelogic_generate_piece_moves(logic, startRow, startCol, &buf);
     
-    bool valid = false;
-    if (moves) {
-        for (int i = 0; i < count; i++) {
-            if (moves[i]->to_sq == (endRow * 8 + endCol)) {
-                valid = true;
-                break;
-            }
-        }
-        gamelogic_free_moves_array(moves, count);
+    for (int i = 0; i < buf.count; i++) {
+        if (PACKED_TO(buf.moves[i]) == (endRow * 8 + endCol)) return true;
     }
-    return valid;
+    return false;
 }
 
 void gamelogic_free_moves_array(Move** moves, int count) {
@@ -443,10 +452,7 @@ Move** gamelogic_get_all_legal_moves(GameLogic* logic, Player player, int* count
         return NULL;
     }
     
-    MoveList* legal = movelist_create();
-    gamelogic_generate_legal_moves(logic, player, legal);
-    
-    Move** arr = move_array_clone(legal, count);
-    movelist_free(legal);
-    return arr;
+    MoveBuffer buf;
+    gamelogic_generate_moves(logic, player, &buf);
+    return move_array_from_buffer(logic, &buf, count);
 }
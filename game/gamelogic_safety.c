@@ -6,141 +6,73 @@
 // Forward declarations
 static bool is_valid_pos(int r, int c);
 static Player get_opponent(Player p);
-static bool is_threat(GameLogic* logic, int r, int c, Player opp, PieceType type);
-static bool is_line_threat(GameLogic* logic, int r, int c, int dr, int dc, Player oppOwner, PieceType t1, PieceType t2);
+
+// All pieces (both colors) attacking a square, given an occupancy mask.
+// Callers mask the result with colorBB[...] to pick a side; passing a modified
+// occupancy lets move simulation test x-rays without touching the board.
+Bitboard gamelogic_attackers_to(GameLogic* logic, int sq, Bitboard occupied) {
+    if (!logic || sq < 0 || sq > 63) return BB_EMPTY;
+    
+    Bitboard rookLike = logic->pieceBB[PIECE_ROOK] | logic->pieceBB[PIECE_QUEEN];
+    Bitboard bishopLike = logic->pieceBB[PIECE_BISHOP] | logic->pieceBB[PIECE_QUEEN];
+    Bitboard pawns = logic->pieceBB[PIECE_PAWN];
+    
+    // A black pawn attacks sq iff it stands where a white pawn on sq would attack (and vice versa)
+    return (bb_pawn_attacks[PLAYER_WHITE][sq] & pawns & logic->colorBB[PLAYER_BLACK]) |
+           (bb_pawn_attacks[PLAYER_BLACK][sq] & pawns & logic->colorBB[PLAYER_WHITE]) |
+           (bb_knight_attacks[sq] & logic->pieceBB[PIECE_KNIGHT]) |
+           (bb_king_attacks[sq] & logic->pieceBB[PIECE_KING]) |
+           (bb_rook_attacks(sq, occupied) & rookLike) |
+           (bb_bishop_attacks(sq, occupied) & bishopLike);
+}
 
 // Check if a square is safe for a player
 bool gamelogic_is_square_safe(GameLogic* logic, int r, int c, Player p) {
     if (!logic || !is_valid_pos(r, c)) return false;
     
-    Player opp = get_opponent(p);
-    
-    // Knight threats
-    int kOffsets[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, 
-                          {1, -2}, {1, 2}, {2, -1}, {2, 1}};
-    for (int i = 0; i < 8; i++) {
-        if (is_threat(logic, r + kOffsets[i][0], c + kOffsets[i][1], opp, PIECE_KNIGHT)) {
-            return false;
-        }
-    }
-    
-    // Sliding threats (Rook, Bishop, Queen)
-    int rookDirs[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-    for (int i = 0; i < 4; i++) {
-        if (is_line_threat(logic, r, c, rookDirs[i][0], rookDirs[i][1], opp, PIECE_ROOK, PIECE_QUEEN)) {
-            return false;
-        }
-    }
-    
-    int bishopDirs[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-    for (int i = 0; i < 4; i++) {
-        if (is_line_threat(logic, r, c, bishopDirs[i][0], bishopDirs[i][1], opp, PIECE_BISHOP, PIECE_QUEEN)) {
-            return false;
-        }
-    }
-    
-    // Pawn threats
-    int enemyPawnRow = (p == PLAYER_WHITE) ? r - 1 : r + 1;
-    if (is_threat(logic, enemyPawnRow, c - 1, opp, PIECE_PAWN)) return false;
-    if (is_threat(logic, enemyPawnRow, c + 1, opp, PIECE_PAWN)) return false;
-    
-    // King threats
-    int kingOffsets[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, 
-                             {0, 1}, {1, -1}, {1, 0}, {1, 1}};
-    for (int i = 0; i < 8; i++) {
-        if (is_threat(logic, r + kingOffsets[i][0], c + kingOffsets[i][1], opp, PIECE_KING)) {
-            return false;
-        }
-    }
-    
-    return true;
+    Bitboard occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    Bitboard attackers = gamelogic_attackers_to(logic, r * 8 + c, occupied);
+    return (attackers & logic->colorBB[get_opponent(p)]) == 0;
 }
 
 // Check if player is in check
 bool gamelogic_is_in_check(GameLogic* logic, Player player) {
     if (!logic) return false;
     
-    // Find king
-    int kr = -1, kc = -1;
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            Piece* pc = logic->board[r][c];
-            if (pc && pc->owner == player && pc->type == PIECE_KING) {
-                kr = r;
-                kc = c;
-                break;
-            }
-        }
-        if (kr != -1) break;
-    }
-    
-    if (kr == -1) return false;
+    Bitboard king = logic->pieceBB[PIECE_KING] & logic->colorBB[player];
+    if (!king) return false;
     
-    // Check if king's square is attacked
-    return !gamelogic_is_square_safe(logic, kr, kc, player);
+    int kingSq = bb_lsb(king);
+    Bitboard occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    return (gamelogic_attackers_to(logic, kingSq, occupied) & logic->colorBB[get_opponent(player)]) != 0;
 }
 
 int gamelogic_count_hanging_pieces(GameLogic* logic, Player player) {
     if (!logic) return 0;
     int count = 0;
     Player opp = get_opponent(player);
-    
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            Piece* p = logic->board[r][c];
-            if (p && p->owner == player && p->type != PIECE_KING) {
-                // Attacked by opponent
-                bool attacked = !gamelogic_is_square_safe(logic, r, c, player);
-                // Defended by own pieces (we check if it's "safe" for the opponent to land there)
-                bool defended = !gamelogic_is_square_safe(logic, r, c, opp);
-                
-                if (attacked && !defended) {
-                    count++;
-                }
-            }
+    Bitboard occupied = logic->colorBB[PLAYER_WHITE] | logic->colorBB[PLAYER_BLACK];
+    
+    Bitboard pieces = logic->colorBB[player] & ~logic->pieceBB[PIECE_KING];
+    while (pieces) {
+        int sq = bb_pop_lsb(&pieces);
+        Bitboard attackers = gamelogic_attackers_to(logic, sq, occupied);
+        // Attacked by opponent, not defended by own pieces
+        if ((attackers & logic->colorBB[opp]) && !(attackers & logic->colorBB[player])) {
+            count++;
         }
     }
     return count;
 }
 
-// Simple move list for checking moves
-typedef struct {
-    Move** moves;
-    int count;
-    int capacity;
-} MoveList;
-
-static MoveList* movelist_create(void) {
-    MoveList* list = (MoveList*)malloc(sizeof(MoveList));
-    if (list) {
-        list->capacity = 32;
-        list->count = 0;
-        list->moves = (Move**)malloc(sizeof(Move*) * list->capacity);
-    }
-    return list;
-}
-
-static void movelist_free(MoveList* list) {
-    if (!list) return;
-    for (int i = 0; i < list->count; i++) {
-        move_free(list->moves[i]);
-    }
-    free(list->moves);
-    free(list);
-}
-
 // Check if player is in checkmate
 bool gamelogic_is_checkmate(GameLogic* logic, Player player) {
     if (!logic) return false;
     if (!gamelogic_is_in_check(logic, player)) return false;
     
     // Generate legal moves - if none exist, it's checkmate
-    MoveList* moves_list = movelist_create();
-    gamelogic_generate_legal_moves(logic, player, moves_list);
-    bool is_mate = (moves_list->count == 0);
-    movelist_free(moves_list);
-    
-    return is_mate;
+    MoveBuffer buf;
+    return gamelogic_generate_moves(logic, player, &buf) == 0;
 }
 
 // Check if player is in stalemate
@@ -149,40 +81,48 @@ bool gamelogic_is_stalemate(GameLogic* logic, Player player) {
     if (gamelogic_is_in_check(logic, player)) return false;
     
     // Generate legal moves - if none exist, it's stalemate
-    MoveList* moves_list = movelist_create();
-    gamelogic_generate_legal_moves(logic, player, moves_list);
-    bool is_stale = (moves_list->count == 0);
-    movelist_free(moves_list);
-    
-    return is_stale;
-}
-
-// Helper: Check if there's a threat at a position
-static bool is_threat(GameLogic* logic, int r, int c, Player opp, PieceType type) {
-    if (!is_valid_pos(r, c)) return false;
-    Piece* p = logic->board[r][c];
-    return (p && p->owner == opp && p->type == type);
+    MoveBuffer buf;
+    return gamelogic_generate_moves(logic, player, &buf) == 0;
 }
 
-// Helper: Check for line threats (Rook, Bishop, Queen)
-static bool is_line_threat(GameLogic* logic, int r, int c, int dr, int dc, Player oppOwner, PieceType t1, PieceType t2) {
-    int nr = r + dr;
-    int nc = c + dc;
+// Threefold repetition: the current position occurred twice before.
+// Only positions since the last capture or pawn move can match, so the scan
+// walks back halfmoveClock plies at most, same side to move only.
+bool gamelogic_is_threefold_repetition(GameLogic* logic) {
+    if (!logic) return false;
+    
+    int limit = logic->halfmoveClock;
+    if (limit > logic->historyCount) limit = logic->historyCount;
     
-    while (is_valid_pos(nr, nc)) {
-        Piece* p = logic->board[nr][nc];
-        if (p) {
-            if (p->owner == oppOwner && (p->type == t1 || p->type == t2)) {
-                return true;
-            }
-            return false;  // Path blocked
+    int repeats = 0;
+    for (int back = 4; back <= limit; back += 2) {
+        if (logic->history[logic->historyCount - back].hash == logic->currentHash) {
+            if (++repeats >= 2) return true;
         }
-        nr += dr;
-        nc += dc;
     }
     return false;
 }
 
+// Fifty moves by each side without a capture or pawn move
+bool gamelogic_is_fifty_move_draw(GameLogic* logic) {
+    return logic && logic->halfmoveClock >= 100;
+}
+
+// Neither side can possibly mate: bare kings, a single minor piece,
+// or only bishops that all stand on the same square color
+bool gamelogic_is_insufficient_material(GameLogic* logic) {
+    if (!logic) return false;
+    
+    if (logic->pieceBB[PIECE_PAWN] | logic->pieceBB[PIECE_ROOK] | logic->pieceBB[PIECE_QUEEN]) return false;
+    
+    Bitboard minors = logic->pieceBB[PIECE_KNIGHT] | logic->pieceBB[PIECE_BISHOP];
+    if (bb_popcount(minors) <= 1) return true;
+    if (logic->pieceBB[PIECE_KNIGHT]) return false;
+    
+    Bitboard bishops = logic->pieceBB[PIECE_BISHOP];
+    return (bishops & BB_LIGHT_SQUARES) == 0 || (bishops & ~BB_LIGHT_SQUARES) == 0;
+}
+
 // Helper functions
 static bool is_valid_pos(int r, int c) {
     return (r >= 0 && r < 8 && c >= 0 && c < 8);
@@ -0,0 +1,143 @@
+// Convert saved JSON matches to binary match records.
+//
+//   match_convert [--delete] <matches dir | file.json>...
+//
+// Each file.json gets a file.mrec beside it. A record is only written when
+// decoding it gives back the same moves and think times; --delete then
+// removes the JSON file it replaces.
+
+#include "match_record.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+typedef struct {
+    bool delete_json;
+    int converted;
+    int failed;
+    long long json_bytes;
+    long long record_bytes;
+} ConvertStats;
+
+static long long file_size(const char* path) {
+    struct stat st;
+    return (stat(path, &st) == 0) ? (long long)st.st_size : -1;
+}
+
+// Same moves, ignoring how the JSON spaced them
+static bool same_moves(const char* a, const char* b) {
+    const char* delims = " \t\r\n";
+    a = a ? a : "";
+    b = b ? b : "";
+    for (;;) {
+        a += strspn(a, delims);
+        b += strspn(b, delims);
+        size_t la = strcspn(a, delims), lb = strcspn(b, delims);
+        if (la != lb || strncmp(a, b, la) != 0) return false;
+        if (la == 0) return true;
+        a += la;
+        b += lb;
+    }
+}
+
+static void convert_file(const char* json_path, ConvertStats* stats) {
+    size_t n = strlen(json_path);
+    size_t ext = strlen(MATCH_JSON_EXT);
+    if (n <= ext || strcmp(json_path + n - ext, MATCH_JSON_EXT) != 0) return;
+
+    char record_path[4096];
+    snprintf(record_path, sizeof(record_path), "%.*s%s", (int)(n - ext), json_path, MATCH_RECORD_EXT);
+
+    MatchHistoryEntry entry, check;
+    memset(&entry, 0, sizeof(entry));
+    memset(&check, 0, sizeof(check));
+    bool ok = match_record_load_json(json_path, &entry) && match_record_save(record_path, &entry) &&
+              match_record_load(record_path, &check);
+    if (ok) {
+        ok = same_moves(entry.moves_uci, check.moves_uci) && entry.think_time_count == check.think_time_count &&
+             (entry.think_time_count == 0 ||
+              memcmp(entry.think_time_ms, check.think_time_ms, (size_t)entry.think_time_count * sizeof(int)) == 0);
+        if (!ok) remove(record_path);
+    }
+
+    if (ok) {
+        long long before = file_size(json_path), after = file_size(record_path);
+        stats->converted++;
+        stats->json_bytes += before;
+        stats->record_bytes += after;
+        printf("%s: %lld -> %lld bytes\n", json_path, before, after);
+        if (stats->delete_json) remove(json_path);
+    } else {
+        stats->failed++;
+        fprintf(stderr, "%s: not converted (unreadable, or a move does not replay)\n", json_path);
+    }
+    free(entry.moves_uci);
+    free(entry.think_time_ms);
+    free(check.moves_uci);
+    free(check.think_time_ms);
+}
+
+static void convert_directory(const char* dir_path, ConvertStats* stats) {
+    char path[4096];
+#ifdef _WIN32
+    char search_path[4096];
+    snprintf(search_path, sizeof(search_path), "%.2048s/*%s", dir_path, MATCH_JSON_EXT);
+    WIN32_FIND_DATAA fd;
+    HANDLE hFind = FindFirstFileA(search_path, &fd);
+    if (hFind == INVALID_HANDLE_VALUE) return;
+    do {
+        snprintf(path, sizeof(path), "%.2048s/%.1024s", dir_path, fd.cFileName);
+        convert_file(path, stats);
+    } while (FindNextFileA(hFind, &fd));
+    FindClose(hFind);
+#else
+    DIR* d = opendir(dir_path);
+    if (!d) return;
+    struct dirent* de;
+    while ((de = readdir(d)) != NULL) {
+        snprintf(path, sizeof(path), "%.2048s/%.1024s", dir_path, de->d_name);
+        convert_file(path, stats);
+    }
+    closedir(d);
+#endif
+}
+
+int main(int argc, char** argv) {
+    ConvertStats stats = {0};
+    int first = 1;
+    if (argc > 1 && strcmp(argv[1], "--delete") == 0) {
+        stats.delete_json = true;
+        first = 2;
+    }
+    if (first >= argc) {
+        fprintf(stderr, "usage: %s [--delete] <matches dir | file.json>...\n", argv[0]);
+        return 2;
+    }
+
+    for (int i = first; i < argc; i++) {
+        struct stat st;
+        if (stat(argv[i], &st) != 0) {
+            fprintf(stderr, "%s: not found\n", argv[i]);
+            stats.failed++;
+        } else if (S_ISDIR(st.st_mode)) {
+            convert_directory(argv[i], &stats);
+        } else {
+            convert_file(argv[i], &stats);
+        }
+    }
+
+    printf("Converted %d match(es), %d failed", stats.converted, stats.failed);
+    if (stats.record_bytes > 0) {
+        printf("; %lld -> %lld bytes (%.1fx smaller)", stats.json_bytes, stats.record_bytes,
+               (double)stats.json_bytes / (double)stats.record_bytes);
+    }
+    printf("\n");
+    return stats.failed ? 1 : 0;
+}
@@ -0,0 +1,452 @@
+#include "match_record.h"
+#include "gamelogic.h"
+#include "move.h"
+#include "platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADER_SIZE 64
+#define JSON_LINE_MAX 65536
+
+enum {
+    FLAG_CLOCK = 1,
+    FLAG_WHITE_AI = 2,
+    FLAG_BLACK_AI = 4,
+    FLAG_THINK_TIMES = 8
+};
+
+static const char* const RESULTS[] = { "*", "1-0", "0-1", "1/2-1/2" };
+
+// --- Byte buffers ---
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+    bool error;
+} RecordWriter;
+
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool error;
+} RecordReader;
+
+static void put_bytes(RecordWriter* w, const void* bytes, size_t n) {
+    if (w->error) return;
+    if (w->len + n > w->cap) {
+        size_t cap = w->cap ? w->cap : 256;
+        while (cap < w->len + n) cap *= 2;
+        uint8_t* grown = (uint8_t*)realloc(w->data, cap);
+        if (!grown) {
+            w->error = true;
+            return;
+        }
+        w->data = grown;
+        w->cap = cap;
+    }
+    memcpy(w->data + w->len, bytes, n);
+    w->len += n;
+}
+
+static void put_u8(RecordWriter* w, unsigned v) {
+    uint8_t b = (uint8_t)v;
+    put_bytes(w, &b, 1);
+}
+
+static void put_le(RecordWriter* w, uint64_t v, int bytes) {
+    uint8_t b[8];
+    for (int i = 0; i < bytes; i++) b[i] = (uint8_t)(v >> (8 * i));
+    put_bytes(w, b, (size_t)bytes);
+}
+
+static void put_varint(RecordWriter* w, uint64_t v) {
+    uint8_t b[10];
+    size_t n = 0;
+    while (v >= 0x80) {
+        b[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    b[n++] = (uint8_t)v;
+    put_bytes(w, b, n);
+}
+
+static void put_string(RecordWriter* w, const char* s) {
+    size_t n = strlen(s);
+    put_varint(w, n);
+    put_bytes(w, s, n);
+}
+
+static uint64_t get_le(RecordReader* r, int bytes) {
+    if (r->error || r->end - r->p < bytes) {
+        r->error = true;
+        return 0;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= (uint64_t)r->p[i] << (8 * i);
+    r->p += bytes;
+    return v;
+}
+
+static uint64_t get_varint(RecordReader* r) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64 && !r->error; shift += 7) {
+        if (r->p >= r->end) break;
+        uint8_t b = *r->p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    r->error = true;
+    return 0;
+}
+
+// Read a string into a fixed field, truncating what does not fit
+static void get_string(RecordReader* r, char* dest, size_t dest_size) {
+    uint64_t n = get_varint(r);
+    if (r->error || (uint64_t)(r->end - r->p) < n) {
+        r->error = true;
+        dest[0] = '\0';
+        return;
+    }
+    snprintf(dest, dest_size, "%.*s", (int)(n < dest_size ? n : dest_size - 1), (const char*)r->p);
+    r->p += n;
+}
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static GameLogic* replay_logic(const char* start_fen) {
+    GameLogic* logic = gamelogic_create();
+    if (!logic) return NULL;
+    logic->isSimulation = true; // No clocks, think times or UI callbacks
+    if (start_fen && start_fen[0]) gamelogic_load_fen(logic, start_fen);
+    return logic;
+}
+
+// --- Encoding ---
+
+uint8_t* match_record_encode(const MatchHistoryEntry* entry, size_t* out_size) {
+    if (!entry || !out_size) return NULL;
+    GameLogic* logic = replay_logic(entry->start_fen);
+    if (!logic) return NULL;
+
+    int result = 0;
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(entry->result, RESULTS[i]) == 0) result = i;
+    }
+    bool hasTimes = entry->think_time_ms && entry->think_time_count > 0;
+    unsigned flags = (entry->clock.enabled ? FLAG_CLOCK : 0) | (entry->white.is_ai ? FLAG_WHITE_AI : 0) |
+                     (entry->black.is_ai ? FLAG_BLACK_AI : 0) | (hasTimes ? FLAG_THINK_TIMES : 0);
+
+    RecordWriter w = {0};
+    put_bytes(&w, "HCMR", 4);
+    put_u8(&w, MATCH_RECORD_VERSION);
+    put_u8(&w, flags);
+    put_u8(&w, (unsigned)result);
+    put_u8(&w, (unsigned)entry->game_mode);
+    put_le(&w, (uint64_t)entry->timestamp, 8);
+    put_le(&w, (uint64_t)entry->created_at_ms, 8);
+    put_le(&w, (uint64_t)entry->started_at_ms, 8);
+    put_le(&w, (uint64_t)entry->ended_at_ms, 8);
+    put_le(&w, (uint32_t)entry->clock.initial_ms, 4);
+    put_le(&w, (uint32_t)entry->clock.increment_ms, 4);
+    const MatchPlayerConfig* players[2] = { &entry->white, &entry->black };
+    for (int i = 0; i < 2; i++) {
+        put_le(&w, (uint16_t)players[i]->elo, 2);
+        put_u8(&w, (unsigned)players[i]->depth);
+        put_u8(&w, (unsigned)players[i]->engine_type);
+    }
+    put_le(&w, 0, 4); // Ply count, patched below
+    put_le(&w, hasTimes ? (uint32_t)entry->think_time_count : 0, 4);
+
+    put_string(&w, entry->result_reason);
+    for (int i = 0; i < 2; i++) {
+        put_string(&w, players[i]->engine_path);
+        put_string(&w, players[i]->player_name);
+    }
+    put_string(&w, entry->start_fen);
+
+    // Each move is stored as its index among the legal moves
+    uint32_t plies = 0;
+    const char* cursor = entry->moves_uci ? entry->moves_uci : "";
+    const char* delims = " \t\r\n";
+    bool ok = true;
+    while (ok && !w.error) {
+        cursor += strspn(cursor, delims);
+        size_t len = strcspn(cursor, delims);
+        if (len == 0) break;
+
+        MoveBuffer legal;
+        gamelogic_generate_moves(logic, logic->turn, &legal);
+        int index = -1;
+        for (int i = 0; i < legal.count && index < 0; i++) {
+            char uci[8];
+            packed_move_to_uci(legal.moves[i], uci);
+            if (strlen(uci) == len && strncmp(uci, cursor, len) == 0) index = i;
+        }
+        if (index < 0) {
+            ok = false;
+            break;
+        }
+        put_varint(&w, (uint64_t)index);
+        Move m;
+        move_unpack(&m, legal.moves[index], logic->turn);
+        gamelogic_perform_move(logic, &m);
+        plies++;
+        cursor += len;
+    }
+    gamelogic_free(logic);
+
+    if (hasTimes) {
+        int64_t prev = 0;
+        for (int i = 0; i < entry->think_time_count; i++) {
+            put_varint(&w, zigzag((int64_t)entry->think_time_ms[i] - prev));
+            prev = entry->think_time_ms[i];
+        }
+    }
+
+    if (!ok || w.error) {
+        free(w.data);
+        return NULL;
+    }
+    for (int i = 0; i < 4; i++) w.data[56 + i] = (uint8_t)(plies >> (8 * i));
+    *out_size = w.len;
+    return w.data;
+}
+
+// --- Decoding ---
+
+bool match_record_decode(const uint8_t* data, size_t size, MatchHistoryEntry* entry) {
+    if (!data || !entry || size < HEADER_SIZE || memcmp(data, "HCMR", 4) != 0 || data[4] != MATCH_RECORD_VERSION) {
+        return false;
+    }
+
+    char id[sizeof(entry->id)];
+    memcpy(id, entry->id, sizeof(id));
+    memset(entry, 0, sizeof(*entry));
+    memcpy(entry->id, id, sizeof(id));
+
+    RecordReader r = { data + 5, data + size, false };
+    unsigned flags = (unsigned)get_le(&r, 1);
+    unsigned result = (unsigned)get_le(&r, 1);
+    entry->game_mode = (int)get_le(&r, 1);
+    entry->timestamp = (int64_t)get_le(&r, 8);
+    entry->created_at_ms = (int64_t)get_le(&r, 8);
+    entry->started_at_ms = (int64_t)get_le(&r, 8);
+    entry->ended_at_ms = (int64_t)get_le(&r, 8);
+    entry->clock.enabled = (flags & FLAG_CLOCK) != 0;
+    entry->clock.initial_ms = (int32_t)get_le(&r, 4);
+    entry->clock.increment_ms = (int32_t)get_le(&r, 4);
+    MatchPlayerConfig* players[2] = { &entry->white, &entry->black };
+    for (int i = 0; i < 2; i++) {
+        players[i]->is_ai = (flags & (i == 0 ? FLAG_WHITE_AI : FLAG_BLACK_AI)) != 0;
+        players[i]->elo = (int)get_le(&r, 2);
+        players[i]->depth = (int)get_le(&r, 1);
+        players[i]->engine_type = (int)get_le(&r, 1);
+    }
+    uint32_t plies = (uint32_t)get_le(&r, 4);
+    uint32_t times = (uint32_t)get_le(&r, 4);
+    snprintf(entry->result, sizeof(entry->result), "%s", RESULTS[result < 4 ? result : 0]);
+
+    get_string(&r, entry->result_reason, sizeof(entry->result_reason));
+    for (int i = 0; i < 2; i++) {
+        get_string(&r, players[i]->engine_path, sizeof(players[i]->engine_path));
+        get_string(&r, players[i]->player_name, sizeof(players[i]->player_name));
+    }
+    get_string(&r, entry->start_fen, sizeof(entry->start_fen));
+    // Every ply and think time takes at least one byte
+    if (r.error || (uint64_t)plies + times > (uint64_t)(r.end - r.p)) return false;
+
+    GameLogic* logic = replay_logic(entry->start_fen);
+    char* moves = (char*)malloc((size_t)plies * 6 + 1);
+    if (!logic || !moves) {
+        gamelogic_free(logic);
+        free(moves);
+        return false;
+    }
+    size_t len = 0;
+    moves[0] = '\0';
+    for (uint32_t i = 0; i < plies && !r.error; i++) {
+        uint64_t index = get_varint(&r);
+        MoveBuffer legal;
+        gamelogic_generate_moves(logic, logic->turn, &legal);
+        if (index >= (uint64_t)legal.count) {
+            r.error = true;
+            break;
+        }
+        char uci[8];
+        packed_move_to_uci(legal.moves[index], uci);
+        len += (size_t)snprintf(moves + len, (size_t)plies * 6 + 1 - len, "%s%s", i ? " " : "", uci);
+        Move m;
+        move_unpack(&m, legal.moves[index], logic->turn);
+        gamelogic_perform_move(logic, &m);
+    }
+    gamelogic_generate_fen(logic, entry->final_fen, sizeof(entry->final_fen));
+    gamelogic_free(logic);
+    entry->moves_uci = moves;
+    entry->move_count = (int)plies;
+
+    if ((flags & FLAG_THINK_TIMES) && times > 0 && !r.error) {
+        entry->think_time_ms = (int*)malloc((size_t)times * sizeof(int));
+        if (!entry->think_time_ms) r.error = true;
+        int64_t prev = 0;
+        for (uint32_t i = 0; i < times && !r.error; i++) {
+            prev += unzigzag(get_varint(&r));
+            entry->think_time_ms[i] = (int)prev;
+        }
+        entry->think_time_count = (int)times;
+    }
+
+    if (r.error) {
+        free(entry->moves_uci);
+        free(entry->think_time_ms);
+        entry->moves_uci = NULL;
+        entry->think_time_ms = NULL;
+        entry->think_time_count = 0;
+        return false;
+    }
+    return true;
+}
+
+// --- Files ---
+
+bool match_record_save(const char* path, const MatchHistoryEntry* entry) {
+    if (!path || !entry) return false;
+    size_t size = 0;
+    uint8_t* data = match_record_encode(entry, &size);
+    if (!data) return false;
+    FILE* f = fopen(path, "wb");
+    bool ok = f && fwrite(data, 1, size, f) == size;
+    if (f && fclose(f) != 0) ok = false;
+    free(data);
+    if (!ok) remove(path);
+    return ok;
+}
+
+bool match_record_load(const char* path, MatchHistoryEntry* entry) {
+    if (!path || !entry) return false;
+    MappedFile mf;
+    if (!platform_map_file(path, &mf)) return false;
+    bool ok = match_record_decode((const uint8_t*)mf.data, mf.size, entry);
+    platform_unmap_file(&mf);
+    return ok;
+}
+
+// --- Legacy JSON ---
+
+static void json_extract_str(const char* line, const char* key, char* dest, size_t dest_size) {
+    char search[128];
+    snprintf(search, sizeof(search), "\"%s\":", key);
+    const char* found = strstr(line, search);
+    if (!found) return;
+    const char* start = strchr(found + strlen(search), '"');
+    if (!start) return;
+    start++;
+    const char* end = strchr(start, '"');
+    if (!end) return;
+    size_t len = (size_t)(end - start);
+    if (len >= dest_size) len = dest_size - 1;
+    snprintf(dest, dest_size, "%.*s", (int)len, start);
+}
+
+static int json_int_after(const char* line, const char* key) {
+    const char* p = strstr(line, key);
+    p = p ? strchr(p, ':') : NULL;
+    return p ? atoi(p + 1) : 0;
+}
+
+static int64_t json_int64_after(const char* line, const char* key) {
+    const char* p = strstr(line, key);
+    p = p ? strchr(p, ':') : NULL;
+    return p ? (int64_t)strtoll(p + 1, NULL, 10) : 0;
+}
+
+// The files were written by one fixed printer: one key (or one player
+// object) per line, so a line scan is enough
+bool match_record_load_json(const char* path, MatchHistoryEntry* entry) {
+    if (!path || !entry) return false;
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char* line = (char*)malloc(JSON_LINE_MAX);
+    if (!line) {
+        fclose(f);
+        return false;
+    }
+
+    char id[sizeof(entry->id)];
+    memcpy(id, entry->id, sizeof(id));
+    memset(entry, 0, sizeof(*entry));
+    memcpy(entry->id, id, sizeof(id));
+
+    int context = 0; // 0: Root, 1: White, 2: Black, 3: Clock
+    while (fgets(line, JSON_LINE_MAX, f)) {
+        if (strstr(line, "\"white\": {")) context = 1;
+        else if (strstr(line, "\"black\": {")) context = 2;
+        else if (strstr(line, "\"clock\": {")) context = 3;
+        else if (strchr(line, '}') && context != 0) context = 0;
+
+        if (strstr(line, "\"timestamp\"")) entry->timestamp = json_int64_after(line, "\"timestamp\"");
+        else if (strstr(line, "\"created_at_ms\"")) entry->created_at_ms = json_int64_after(line, "\"created_at_ms\"");
+        else if (strstr(line, "\"started_at_ms\"")) entry->started_at_ms = json_int64_after(line, "\"started_at_ms\"");
+        else if (strstr(line, "\"ended_at_ms\"")) entry->ended_at_ms = json_int64_after(line, "\"ended_at_ms\"");
+        else if (context == 3) {
+            if (strstr(line, "\"initial_ms\"")) entry->clock.initial_ms = json_int_after(line, "\"initial_ms\"");
+            else if (strstr(line, "\"increment_ms\"")) entry->clock.increment_ms = json_int_after(line, "\"increment_ms\"");
+            else if (strstr(line, "\"enabled\"")) entry->clock.enabled = strstr(line, "true") != NULL;
+        }
+        else if (context == 1 || context == 2) {
+            MatchPlayerConfig* p = (context == 1) ? &entry->white : &entry->black;
+            if (strstr(line, "\"is_ai\"")) p->is_ai = strstr(line, "\"is_ai\": true") != NULL;
+            if (strstr(line, "\"elo\"")) p->elo = json_int_after(line, "\"elo\"");
+            if (strstr(line, "\"depth\"")) p->depth = json_int_after(line, "\"depth\"");
+            if (strstr(line, "\"engine_type\"")) p->engine_type = json_int_after(line, "\"engine_type\"");
+            json_extract_str(line, "engine_path", p->engine_path, sizeof(p->engine_path));
+            json_extract_str(line, "player_name", p->player_name, sizeof(p->player_name));
+        }
+        else if (strstr(line, "\"think_time_ms\"")) {
+            const char* p = strchr(line, '[');
+            if (!p) continue;
+            int count = 1;
+            for (const char* c = p; *c && *c != ']'; c++) {
+                if (*c == ',') count++;
+            }
+            free(entry->think_time_ms);
+            entry->think_time_ms = (int*)malloc((size_t)count * sizeof(int));
+            entry->think_time_count = 0;
+            if (!entry->think_time_ms) continue;
+            p++;
+            while (entry->think_time_count < count) {
+                char* stop;
+                long v = strtol(p, &stop, 10);
+                if (stop == p) break;
+                entry->think_time_ms[entry->think_time_count++] = (int)v;
+                p = stop + strspn(stop, ", \"");
+            }
+        }
+        else if (strstr(line, "\"game_mode\"")) entry->game_mode = json_int_after(line, "\"game_mode\"");
+        else if (strstr(line, "\"result_reason\"")) json_extract_str(line, "result_reason", entry->result_reason, sizeof(entry->result_reason));
+        else if (strstr(line, "\"result\"")) json_extract_str(line, "result", entry->result, sizeof(entry->result));
+        else if (strstr(line, "\"move_count\"")) entry->move_count = json_int_after(line, "\"move_count\"");
+        else if (strstr(line, "\"moves_uci\"")) {
+            const char* p = strstr(line, "\"moves_uci\":");
+            const char* start = p ? strchr(p + 12, '"') : NULL;
+            const char* end = start ? strchr(start + 1, '"') : NULL;
+            if (end) {
+                free(entry->moves_uci);
+                entry->moves_uci = (char*)malloc((size_t)(end - start));
+                if (entry->moves_uci) snprintf(entry->moves_uci, (size_t)(end - start), "%s", start + 1);
+            }
+        }
+        else if (strstr(line, "\"start_fen\"")) json_extract_str(line, "start_fen", entry->start_fen, sizeof(entry->start_fen));
+        else if (strstr(line, "\"final_fen\"")) json_extract_str(line, "final_fen", entry->final_fen, sizeof(entry->final_fen));
+    }
+    free(line);
+    fclose(f);
+    return true;
+}
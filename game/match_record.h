@@ -0,0 +1,78 @@
+#ifndef MATCH_RECORD_H
+#define MATCH_RECORD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Saved matches. New matches are stored in a compact binary record; the
+// JSON files older versions wrote are still read.
+
+typedef struct {
+    bool is_ai;
+    int elo;
+    int depth;
+    int engine_type; // 0: Internal, 1: Custom
+    char engine_path[512];
+    char player_name[64]; // NEW: Dedicated player name field
+} MatchPlayerConfig;
+
+typedef struct {
+    char id[64];
+    int64_t timestamp;      // Legacy (keep for now)
+    int64_t created_at_ms;  // Creation time
+    int64_t started_at_ms;  // Actual start time
+    int64_t ended_at_ms;    // Game end time
+
+    int game_mode;
+
+    // Clock Snapshot used for this match
+    struct {
+        bool enabled;
+        int initial_ms;
+        int increment_ms;
+    } clock;
+
+    MatchPlayerConfig white;
+    MatchPlayerConfig black;
+    char result[16];        // "1-0", "0-1", "1/2-1/2", "*"
+    char result_reason[64]; // "Checkmate", "Stalemate", "Reset", "Incomplete", "Timeout"
+    int move_count;
+    char* moves_uci;        // Allocated string of moves "e2e4 e7e5 g1f3 ..."
+
+    // Think times per ply (optional)
+    int* think_time_ms;
+    int think_time_count;
+
+    char start_fen[256];
+    char final_fen[256];
+} MatchHistoryEntry;
+
+#define MATCH_RECORD_EXT ".mrec"
+#define MATCH_JSON_EXT ".json"
+
+// Binary record layout (version 1, little-endian):
+//   64-byte header: magic "HCMR", version, flags (clock, AI sides, think
+//   times), result code, game mode, the four timestamps, clock settings,
+//   both players' elo/depth/engine type, ply and think-time counts.
+//   Strings, each a varint length and bytes: result reason, then engine
+//   path and name for White and Black, then the start FEN.
+//   One varint per ply: the move's index in the legal move list.
+//   One zigzag varint per think time: the change from the previous one.
+// The final FEN is not stored; decoding replays the moves and rebuilds it.
+#define MATCH_RECORD_VERSION 1
+
+// Encode a match. Returns a malloc'd buffer (size in out_size), or NULL if
+// a move does not replay from the start position.
+uint8_t* match_record_encode(const MatchHistoryEntry* entry, size_t* out_size);
+// Decode into entry (id is left alone). moves_uci and think_time_ms are
+// malloc'd. Returns false if the record is truncated or malformed.
+bool match_record_decode(const uint8_t* data, size_t size, MatchHistoryEntry* entry);
+
+// File helpers. The loaders clear entry except for its id.
+bool match_record_save(const char* path, const MatchHistoryEntry* entry);
+bool match_record_load(const char* path, MatchHistoryEntry* entry);
+// Legacy JSON match file
+bool match_record_load_json(const char* path, MatchHistoryEntry* entry);
+
+#endif // MATCH_RECORD_H
@@ -13,14 +13,7 @@ Move* move_create(uint8_t from, uint8_t to) {
         m->capturedPieceType = NO_PIECE;
         m->isEnPassant = 0;
         m->isCastling = 0;
-        m->firstMove = 0;
-        m->rookFirstMove = 0;
         m->mover = PLAYER_WHITE;
-        m->prevCastlingRights = 0;
-        m->prevEnPassantCol = -1;
-        m->prevHalfmoveClock = 0;
-        m->prevWhiteTimeMs = 0;
-        m->prevBlackTimeMs = 0;
     }
     return m;
 }
@@ -47,13 +40,12 @@ void move_free(Move* m) {
     }
 }
 
-void move_to_uci(Move* m, char* buf) {
-    if (!m || !buf) return;
-    
-    int r1 = m->from_sq / 8;
-    int c1 = m->from_sq % 8;
-    int r2 = m->to_sq / 8;
-    int c2 = m->to_sq % 8;
+// Shared UCI formatting for Move and PackedMove
+static void format_uci(int from, int to, PieceType promo, char* buf) {
+    int r1 = from / 8;
+    int c1 = from % 8;
+    int r2 = to / 8;
+    int c2 = to % 8;
     
     // UCI: file (a-h), rank (1-8). 
     // Internal: row 0 = Rank 8, row 7 = Rank 1.
@@ -65,9 +57,9 @@ void move_to_uci(Move* m, char* buf) {
     *ptr++ = 'a' + c2;
     *ptr++ = '8' - r2;
     
-    if (m->promotionPiece != NO_PROMOTION) {
+    if (promo != NO_PROMOTION) {
         char pChar = ' ';
-        switch(m->promotionPiece) {
+        switch(promo) {
             case PIECE_QUEEN: pChar = 'q'; break;
             case PIECE_ROOK: pChar = 'r'; break;
             case PIECE_BISHOP: pChar = 'b'; break;
@@ -79,3 +71,33 @@ void move_to_uci(Move* m, char* buf) {
     
     *ptr = '\0';
 }
+
+void move_to_uci(Move* m, char* buf) {
+    if (!m || !buf) return;
+    format_uci(m->from_sq, m->to_sq, m->promotionPiece, buf);
+}
+
+PackedMove move_pack(const Move* m) {
+    if (!m) return PACKED_MOVE_NONE;
+    if (m->promotionPiece != NO_PROMOTION) return PACKED_PROMOTION(m->from_sq, m->to_sq, m->promotionPiece);
+    if (m->isEnPassant) return PACKED_MOVE(m->from_sq, m->to_sq, MOVE_TYPE_EN_PASSANT);
+    if (m->isCastling) return PACKED_MOVE(m->from_sq, m->to_sq, MOVE_TYPE_CASTLING);
+    return PACKED_MOVE(m->from_sq, m->to_sq, MOVE_TYPE_NORMAL);
+}
+
+void move_unpack(Move* m, PackedMove pm, Player mover) {
+    if (!m) return;
+    m->from_sq = (uint8_t)PACKED_FROM(pm);
+    m->to_sq = (uint8_t)PACKED_TO(pm);
+    m->movedPieceType = PIECE_PAWN;
+    m->promotionPiece = (uint8_t)PACKED_PROMOTION_PIECE(pm);
+    m->capturedPieceType = NO_PIECE;
+    m->isEnPassant = PACKED_TYPE(pm) == MOVE_TYPE_EN_PASSANT;
+    m->isCastling = PACKED_TYPE(pm) == MOVE_TYPE_CASTLING;
+    m->mover = (uint8_t)mover;
+}
+
+void packed_move_to_uci(PackedMove pm, char* buf) {
+    if (!buf) return;
+    format_uci(PACKED_FROM(pm), PACKED_TO(pm), PACKED_PROMOTION_PIECE(pm), buf);
+}
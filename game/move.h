@@ -19,5 +19,16 @@ void move_free(Move* m);
 // buf must optionally be at least 6 bytes
 void move_to_uci(Move* m, char* buf);
 
+// Pack a Move into 16 bits (piece types and mover are dropped)
+PackedMove move_pack(const Move* m);
+
+// Expand a PackedMove into a Move. Piece types are not encoded in the packed
+// form: movedPieceType defaults to pawn and capturedPieceType to NO_PIECE
+// (make/perform fill them in; gamelogic_unpack_move reads them from the board).
+void move_unpack(Move* m, PackedMove pm, Player mover);
+
+// UCI string for a PackedMove (same format as move_to_uci)
+void packed_move_to_uci(PackedMove pm, char* buf);
+
 #endif // MOVE_H
 
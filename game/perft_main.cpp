@@ -0,0 +1,211 @@
+// Perft driver for the C rules engine in game/.
+// Counts move-tree leaves for a suite of standard positions, reports
+// nodes/second, and cross-checks every count against the embedded
+// Stockfish Engine::perft so rules bugs and speed regressions show up in one run.
+//
+// Usage:
+//   perft                      Run the suite at its reference depths
+//   perft -d <depth>           Run the suite at a fixed depth (Stockfish only)
+//   perft -d <depth> "<fen>"   Divide a single position against Stockfish
+//   --no-sf                    Skip the Stockfish cross-check
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "../src/bitboard.h"
+#include "../src/engine.h"
+#include "../src/position.h"
+
+extern "C" {
+#include "gamelogic.h"
+}
+
+using namespace Stockfish;
+
+struct PerftCase {
+    const char* name;
+    const char* fen;
+    int depth;
+    uint64_t expected;
+    bool chess960 = false;
+};
+
+// Reference counts (Chess Programming Wiki perft results, Stockfish for the torture cases)
+static const PerftCase suite[] = {
+    {"Start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609ULL},
+    {"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603ULL},
+    {"Position 3 (en passant pins)", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624ULL},
+    {"Position 4 (promotions)", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333ULL},
+    {"Position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487ULL},
+    {"Position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594ULL},
+    {"Castling torture", "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", 4, 314346ULL},
+    {"Promotion torture", "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1", 4, 182838ULL},
+    {"En passant discovered check", "8/8/8/2k5/2pP4/8/B7/4K3 b - d3 0 3", 6, 444954ULL},
+    {"Chess960 #1", "bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w HFhf - 2 9", 4, 326672ULL, true},
+    {"Chess960 #2", "2nnrbkr/p1qppppp/8/1ppb4/6PP/3PP3/PPP2P2/BQNNRBKR w HEhe - 1 9", 4, 667366ULL, true},
+    {"Chess960 #3", "b1q1rrkb/pppppppp/3nn3/8/P7/1PPP4/4PPPP/BQNNRKRB w GE - 1 9", 4, 273318ULL, true},
+};
+
+// Engine::perft prints its divide through sync_cout; capture it instead
+static uint64_t stockfish_perft(Engine& engine, const std::string& fen, int depth, bool chess960, std::string* divide) {
+    std::ostringstream captured;
+    std::streambuf* old_cout = std::cout.rdbuf(captured.rdbuf());
+    uint64_t nodes = engine.perft(fen, depth, chess960);
+    std::cout.rdbuf(old_cout);
+    if (divide) *divide = captured.str();
+    return nodes;
+}
+
+static void collect_divide(const char* uci, uint64_t nodes, void* user_data) {
+    (*static_cast<std::map<std::string, uint64_t>*>(user_data))[uci] = nodes;
+}
+
+static int run_divide(Engine* engine, const char* fen, int depth) {
+    GameLogic* logic = gamelogic_create();
+    gamelogic_load_fen(logic, fen);
+    logic->isSimulation = true;
+    bool chess960 = logic->chess960;
+
+    std::map<std::string, uint64_t> ours;
+    uint64_t total = gamelogic_perft_divide(logic, depth, collect_divide, &ours);
+    gamelogic_free(logic);
+
+    std::map<std::string, uint64_t> theirs;
+    uint64_t sfTotal = 0;
+    if (engine) {
+        std::string text;
+        sfTotal = stockfish_perft(*engine, fen, depth, chess960, &text);
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line)) {
+            size_t colon = line.find(": ");
+            if (colon != std::string::npos)
+                theirs[line.substr(0, colon)] = std::strtoull(line.c_str() + colon + 2, nullptr, 10);
+        }
+    }
+
+    int mismatches = 0;
+    for (const auto& entry : ours) {
+        std::cout << entry.first << ": " << entry.second;
+        if (engine) {
+            auto it = theirs.find(entry.first);
+            if (it == theirs.end()) {
+                std::cout << "  <-- illegal (not generated by Stockfish)";
+                mismatches++;
+            } else if (it->second != entry.second) {
+                std::cout << "  <-- Stockfish: " << it->second;
+                mismatches++;
+            }
+        }
+        std::cout << std::endl;
+    }
+    for (const auto& entry : theirs) {
+        if (ours.find(entry.first) == ours.end()) {
+            std::cout << entry.first << ": missing  <-- Stockfish: " << entry.second << std::endl;
+            mismatches++;
+        }
+    }
+
+    std::cout << "\nNodes searched: " << total;
+    if (engine) std::cout << " (Stockfish: " << sfTotal << ")";
+    std::cout << std::endl;
+    return mismatches == 0 && (!engine || total == sfTotal) ? 0 : 1;
+}
+
+static int run_suite(Engine* engine, int depthOverride) {
+    bool all_passed = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+
+    std::cout << "Running perft suite (C rules engine)..." << std::endl;
+    std::cout << "------------------------------------------------------------------------" << std::endl;
+
+    GameLogic* logic = gamelogic_create();
+    for (const auto& tc : suite) {
+        int depth = depthOverride > 0 ? depthOverride : tc.depth;
+        gamelogic_load_fen(logic, tc.fen);
+        gamelogic_set_chess960(logic, tc.chess960);
+        logic->isSimulation = true;
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = gamelogic_perft(logic, depth);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totalNodes += nodes;
+        totalSeconds += seconds;
+
+        bool passed = true;
+        std::string note;
+        if (depthOverride <= 0 && nodes != tc.expected) {
+            passed = false;
+            note += " expected " + std::to_string(tc.expected);
+        }
+        if (engine) {
+            uint64_t sfNodes = stockfish_perft(*engine, tc.fen, depth, tc.chess960, nullptr);
+            if (sfNodes != nodes) {
+                passed = false;
+                note += " stockfish " + std::to_string(sfNodes);
+            }
+        }
+
+        uint64_t nps = seconds > 0.0 ? (uint64_t)(nodes / seconds) : 0;
+        std::cout << std::left << std::setw(30) << tc.name << " d" << depth
+                  << " | nodes: " << std::setw(10) << nodes
+                  << " | " << std::setw(6) << std::fixed << std::setprecision(3) << seconds << "s"
+                  << " | " << std::setw(10) << nps << " nps"
+                  << " | " << (passed ? "PASS" : "FAIL") << note << std::endl;
+
+        if (!passed) all_passed = false;
+    }
+    gamelogic_free(logic);
+
+    std::cout << "------------------------------------------------------------------------" << std::endl;
+    uint64_t nps = totalSeconds > 0.0 ? (uint64_t)(totalNodes / totalSeconds) : 0;
+    std::cout << "Total: " << totalNodes << " nodes in " << std::setprecision(3) << totalSeconds
+              << "s (" << nps << " nps)" << std::endl;
+
+    if (all_passed) {
+        std::cout << "SUCCESS: All perft counts match!" << std::endl;
+        return 0;
+    }
+    std::cout << "FAILURE: Perft mismatch (run with -d <depth> \"<fen>\" to divide)" << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    int depth = 0;
+    const char* fen = nullptr;
+    bool useStockfish = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            depth = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--no-sf") == 0) {
+            useStockfish = false;
+        } else {
+            fen = argv[i];
+        }
+    }
+
+    if (fen && depth <= 0) {
+        std::cerr << "A depth (-d <depth>) is required to divide a position" << std::endl;
+        return 2;
+    }
+
+    Engine* engine = nullptr;
+    if (useStockfish) {
+        Bitboards::init();
+        Position::init();
+        engine = new Engine();
+    }
+
+    int rc = fen ? run_divide(engine, fen, depth) : run_suite(engine, depth);
+    delete engine;
+    return rc;
+}
@@ -0,0 +1,221 @@
+#include "pgn_export.h"
+#include "game_import.h"
+#include "move.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PGN_LINE_WIDTH 80
+#define STANDARD_START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+static PgnWriter* writer_create(FILE* file, bool owns_file) {
+    PgnWriter* w = (PgnWriter*)calloc(1, sizeof(PgnWriter));
+    if (!w) return NULL;
+    w->logic = gamelogic_create();
+    if (!w->logic) {
+        free(w);
+        return NULL;
+    }
+    w->logic->isSimulation = true; // No game-over checks or callbacks while replaying
+    w->file = file;
+    w->owns_file = owns_file;
+    return w;
+}
+
+PgnWriter* pgn_writer_open(const char* path) {
+    if (!path) return NULL;
+    FILE* f = fopen(path, "wb");
+    if (!f) return NULL;
+    PgnWriter* w = writer_create(f, true);
+    if (!w) fclose(f);
+    return w;
+}
+
+PgnWriter* pgn_writer_open_stream(FILE* stream) {
+    return stream ? writer_create(stream, false) : NULL;
+}
+
+// --- Buffered output ---
+
+static void writer_flush(PgnWriter* w) {
+    if (w->len > 0 && !w->error && fwrite(w->buffer, 1, w->len, w->file) != w->len) w->error = true;
+    w->len = 0;
+}
+
+static void writer_put(PgnWriter* w, const char* text, size_t length) {
+    while (length > 0) {
+        if (w->len == sizeof(w->buffer)) writer_flush(w);
+        size_t n = sizeof(w->buffer) - w->len;
+        if (n > length) n = length;
+        memcpy(w->buffer + w->len, text, n);
+        w->len += n;
+        text += n;
+        length -= n;
+    }
+}
+
+static void writer_puts(PgnWriter* w, const char* text) {
+    writer_put(w, text, strlen(text));
+}
+
+// Movetext token, wrapping before it would pass the line width
+static void writer_token(PgnWriter* w, const char* text) {
+    int length = (int)strlen(text);
+    if (w->column > 0) {
+        if (w->column + 1 + length >= PGN_LINE_WIDTH) {
+            writer_put(w, "\n", 1);
+            w->column = 0;
+        } else {
+            writer_put(w, " ", 1);
+            w->column++;
+        }
+    }
+    writer_put(w, text, (size_t)length);
+    w->column += length;
+}
+
+// [Key "Value"] with quotes and backslashes escaped
+static void writer_tag(PgnWriter* w, const char* key, const char* value) {
+    if (!value || !value[0]) value = "?";
+    writer_put(w, "[", 1);
+    writer_puts(w, key);
+    writer_put(w, " \"", 2);
+    for (const char* p = value; *p; p++) {
+        if (*p == '"' || *p == '\\') writer_put(w, "\\", 1);
+        if (*p != '\n' && *p != '\r') writer_put(w, p, 1);
+    }
+    writer_put(w, "\"]\n", 3);
+}
+
+// --- Annotations ---
+
+static void format_clock(char* buf, size_t size, int64_t ms) {
+    if (ms < 0) ms = 0;
+    int64_t s = ms / 1000;
+    snprintf(buf, size, "%d:%02d:%02d", (int)(s / 3600), (int)(s / 60 % 60), (int)(s % 60));
+}
+
+static void format_eval(char* buf, size_t size, const PgnEval* e) {
+    if (e->is_mate) {
+        snprintf(buf, size, "#%d", e->value);
+    } else {
+        snprintf(buf, size, "%s%d.%02d", e->value < 0 ? "-" : "", abs(e->value) / 100, abs(e->value) % 100);
+    }
+}
+
+// Replay the moves and write the movetext; false if a move did not resolve
+static bool write_moves(PgnWriter* w, const PgnGameRecord* game) {
+    GameLogic* logic = w->logic;
+    if (game->start_fen && game->start_fen[0]) gamelogic_load_fen(logic, game->start_fen);
+    else gamelogic_reset(logic);
+    
+    int64_t remaining[2] = {game->clock_initial_ms, game->clock_initial_ms};
+    const char* p = game->moves_uci ? game->moves_uci : "";
+    bool ok = true;
+    int ply = 0;
+    
+    for (;;) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (!*p) break;
+        char uci[8];
+        size_t n = strcspn(p, " \t\r\n");
+        if (n >= sizeof(uci)) {
+            ok = false;
+            break;
+        }
+        memcpy(uci, p, n);
+        uci[n] = '\0';
+        p += n;
+        
+        PackedMove pm = game_import_resolve_uci(logic, uci);
+        if (pm == PACKED_MOVE_NONE) {
+            ok = false;
+            break;
+        }
+        
+        Player mover = logic->turn;
+        if (mover == PLAYER_WHITE || ply == 0) {
+            char number[16];
+            snprintf(number, sizeof(number), mover == PLAYER_WHITE ? "%d." : "%d...", logic->fullmoveNumber);
+            writer_token(w, number);
+        }
+        
+        Move move;
+        move_unpack(&move, pm, mover);
+        gamelogic_perform_move(logic, &move);
+        Move played = gamelogic_get_last_move(logic);
+        char san[32];
+        gamelogic_get_move_san(logic, &played, san, sizeof(san));
+        writer_token(w, san);
+        
+        // {[%eval 0.31] [%clk 0:04:32]}
+        char comment[96];
+        int c = 0;
+        if (game->evals && ply < game->eval_count && game->evals[ply].valid) {
+            char eval[16];
+            format_eval(eval, sizeof(eval), &game->evals[ply]);
+            c += snprintf(comment + c, sizeof(comment) - (size_t)c, "[%%eval %s]", eval);
+        }
+        if (game->clock_enabled && game->think_time_ms && ply < game->think_time_count) {
+            remaining[mover] += (int64_t)game->clock_increment_ms - game->think_time_ms[ply];
+            char clock[24];
+            format_clock(clock, sizeof(clock), remaining[mover]);
+            c += snprintf(comment + c, sizeof(comment) - (size_t)c, "%s[%%clk %s]", c ? " " : "", clock);
+        }
+        if (c > 0) {
+            char token[100];
+            snprintf(token, sizeof(token), "{%s}", comment);
+            writer_token(w, token);
+        }
+        ply++;
+    }
+    return ok;
+}
+
+bool pgn_writer_write_game(PgnWriter* w, const PgnGameRecord* game) {
+    if (!w || !game) return false;
+    
+    const char* result = (game->result && game->result[0]) ? game->result : "*";
+    if (w->games > 0) writer_put(w, "\n", 1);
+    writer_tag(w, "Event", game->event);
+    writer_tag(w, "Site", game->site);
+    writer_tag(w, "Date", game->date ? game->date : "????.??.??");
+    writer_tag(w, "Round", "-");
+    writer_tag(w, "White", game->white);
+    writer_tag(w, "Black", game->black);
+    writer_tag(w, "Result", result);
+    if (game->start_fen && game->start_fen[0] && strcmp(game->start_fen, STANDARD_START_FEN) != 0) {
+        writer_tag(w, "SetUp", "1");
+        writer_tag(w, "FEN", game->start_fen);
+    }
+    if (game->clock_enabled) {
+        char tc[32];
+        if (game->clock_increment_ms > 0) {
+            snprintf(tc, sizeof(tc), "%d+%d", game->clock_initial_ms / 1000, game->clock_increment_ms / 1000);
+        } else {
+            snprintf(tc, sizeof(tc), "%d", game->clock_initial_ms / 1000);
+        }
+        writer_tag(w, "TimeControl", tc);
+    }
+    writer_put(w, "\n", 1);
+    
+    w->column = 0;
+    bool ok = write_moves(w, game);
+    writer_token(w, result);
+    writer_put(w, "\n", 1);
+    w->games++;
+    return ok;
+}
+
+bool pgn_writer_close(PgnWriter* w) {
+    if (!w) return false;
+    writer_flush(w);
+    if (w->owns_file) {
+        if (fclose(w->file) != 0) w->error = true;
+    } else if (fflush(w->file) != 0) {
+        w->error = true;
+    }
+    bool ok = !w->error;
+    gamelogic_free(w->logic);
+    free(w);
+    return ok;
+}
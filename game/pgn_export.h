@@ -0,0 +1,65 @@
+#ifndef PGN_EXPORT_H
+#define PGN_EXPORT_H
+
+#include "gamelogic.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Engine evaluation after a ply, from White's point of view
+typedef struct {
+    bool valid;
+    bool is_mate;
+    int16_t value;              // Centipawns, or moves to mate (negative: Black mates)
+} PgnEval;
+
+// One stored game, as the writer needs it. All pointers are borrowed.
+typedef struct {
+    const char* event;          // NULL or "" writes "?"
+    const char* site;
+    const char* date;           // "YYYY.MM.DD"
+    const char* white;
+    const char* black;
+    const char* result;         // "1-0", "0-1", "1/2-1/2" or "*"
+    const char* start_fen;      // NULL or "" for the standard start
+    const char* moves_uci;      // "e2e4 e7e5 ..."
+
+    // Clock comments ({[%clk 0:04:32]}) need the clock settings and think times
+    bool clock_enabled;
+    int clock_initial_ms;
+    int clock_increment_ms;
+    const int* think_time_ms;   // Per ply, may be NULL
+    int think_time_count;
+
+    const PgnEval* evals;       // evals[i] = evaluation after ply i, may be NULL
+    int eval_count;
+} PgnGameRecord;
+
+#define PGN_WRITER_BUFFER 65536
+
+// Streams games to one file through a fixed buffer. A single scratch
+// GameLogic is reused for every game, so writing allocates nothing per game.
+typedef struct {
+    FILE* file;
+    bool owns_file;
+    bool error;                 // A write failed; later output is dropped
+    int column;                 // Current movetext column (lines wrap at 80)
+    int games;
+    GameLogic* logic;
+    size_t len;
+    char buffer[PGN_WRITER_BUFFER];
+} PgnWriter;
+
+// Create a writer for a new file at path, or for an already open stream
+// (which the writer will not close). Return NULL on failure.
+PgnWriter* pgn_writer_open(const char* path);
+PgnWriter* pgn_writer_open_stream(FILE* stream);
+
+// Append one game. Returns false if its moves could not all be replayed
+// (the game is still written, cut at the first bad move).
+bool pgn_writer_write_game(PgnWriter* writer, const PgnGameRecord* game);
+
+// Flush, close and free. Returns false if any write failed.
+bool pgn_writer_close(PgnWriter* writer);
+
+#endif // PGN_EXPORT_H
@@ -0,0 +1,72 @@
+#include "platform.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool platform_map_file(const char* path, MappedFile* mf) {
+    memset(mf, 0, sizeof(*mf));
+#ifdef _WIN32
+    mf->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (mf->file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mf->file, &size)) {
+        CloseHandle(mf->file);
+        return false;
+    }
+    mf->size = (size_t)size.QuadPart;
+    if (mf->size == 0) return true; // Empty files cannot be mapped
+    mf->mapping = CreateFileMappingA(mf->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mf->mapping) mf->data = (const char*)MapViewOfFile(mf->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!mf->data) {
+        if (mf->mapping) CloseHandle(mf->mapping);
+        CloseHandle(mf->file);
+        return false;
+    }
+#else
+    mf->fd = open(path, O_RDONLY);
+    if (mf->fd < 0) return false;
+    struct stat st;
+    if (fstat(mf->fd, &st) != 0) {
+        close(mf->fd);
+        return false;
+    }
+    mf->size = (size_t)st.st_size;
+    if (mf->size == 0) return true; // Empty files cannot be mapped
+    void* data = mmap(NULL, mf->size, PROT_READ, MAP_PRIVATE, mf->fd, 0);
+    if (data == MAP_FAILED) {
+        close(mf->fd);
+        return false;
+    }
+    mf->data = (const char*)data;
+#endif
+    return true;
+}
+
+void platform_unmap_file(MappedFile* mf) {
+#ifdef _WIN32
+    if (mf->data) UnmapViewOfFile(mf->data);
+    if (mf->mapping) CloseHandle(mf->mapping);
+    CloseHandle(mf->file);
+#else
+    if (mf->data) munmap((void*)mf->data, mf->size);
+    close(mf->fd);
+#endif
+}
+
+int platform_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
@@ -0,0 +1,28 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Thin OS wrappers shared by the bulk loaders (EPD checks, PGN import)
+
+// A whole file mapped read-only. data is NULL for an empty file.
+typedef struct {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    void* file;     // HANDLE (kept opaque so callers need not include windows.h)
+    void* mapping;
+#else
+    int fd;
+#endif
+} MappedFile;
+
+// Map path into memory. Returns false if it cannot be opened or mapped.
+bool platform_map_file(const char* path, MappedFile* mf);
+void platform_unmap_file(MappedFile* mf);
+
+// Number of online CPUs (at least 1)
+int platform_cpu_count(void);
+
+#endif // PLATFORM_H
@@ -0,0 +1,456 @@
+#include "position_check.h"
+#include "bitboard.h"
+#include "types.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "platform.h"
+
+// Below this many positions per thread, spawning costs more than it saves
+#define MIN_POSITIONS_PER_THREAD 256
+
+// Just enough board for legality checks (lives on the stack, ~90 bytes)
+typedef struct {
+    Bitboard pieceBB[6];    // Indexed by PieceType, both colors
+    Bitboard colorBB[2];    // Indexed by Player
+    Player turn;
+    uint8_t castlingRights; // Bitmask: WK=1, WQ=2, BK=4, BQ=8
+    uint8_t castlingFiles[2]; // Shredder-FEN rights: bit per rook file, by Player
+    int8_t enPassantSq;     // Target square, -1 if none
+} LitePosition;
+
+// A FEN that need not be NUL-terminated (lines of a mapped file)
+typedef struct {
+    const char* text;
+    size_t length;
+} FenSpan;
+
+static Player opponent(Player p) {
+    return (p == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+}
+
+static int piece_type_from_char(char c) {
+    switch (c) {
+        case 'k': case 'K': return PIECE_KING;
+        case 'q': case 'Q': return PIECE_QUEEN;
+        case 'r': case 'R': return PIECE_ROOK;
+        case 'b': case 'B': return PIECE_BISHOP;
+        case 'n': case 'N': return PIECE_KNIGHT;
+        case 'p': case 'P': return PIECE_PAWN;
+        default: return -1;
+    }
+}
+
+// --- Parsing ---
+
+static const char* skip_spaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+static bool at_field_end(const char* p, const char* end) {
+    return p >= end || *p == ' ' || *p == '\t';
+}
+
+// Placement, side to move, castling and en passant; anything after is ignored
+static PositionError parse_fen(const char* fen, size_t length, LitePosition* pos) {
+    memset(pos, 0, sizeof(*pos));
+    pos->enPassantSq = -1;
+    if (!fen) return POSITION_ERR_SYNTAX;
+
+    const char* end = fen + length;
+    const char* p = skip_spaces(fen, end);
+
+    int row = 0, col = 0;
+    for (; !at_field_end(p, end); p++) {
+        char c = *p;
+        if (c == '/') {
+            if (col != 8 || row == 7) return POSITION_ERR_SYNTAX;
+            row++;
+            col = 0;
+        } else if (c >= '1' && c <= '8') {
+            col += c - '0';
+            if (col > 8) return POSITION_ERR_SYNTAX;
+        } else {
+            int type = piece_type_from_char(c);
+            if (type < 0 || col > 7) return POSITION_ERR_SYNTAX;
+            Player owner = (c >= 'A' && c <= 'Z') ? PLAYER_WHITE : PLAYER_BLACK;
+            Bitboard bit = BB_SQUARE(row * 8 + col);
+            pos->pieceBB[type] |= bit;
+            pos->colorBB[owner] |= bit;
+            col++;
+        }
+    }
+    if (row != 7 || col != 8) return POSITION_ERR_SYNTAX;
+
+    // Side to move
+    p = skip_spaces(p, end);
+    if (p >= end || (*p != 'w' && *p != 'b')) return POSITION_ERR_SYNTAX;
+    pos->turn = (*p == 'w') ? PLAYER_WHITE : PLAYER_BLACK;
+    if (!at_field_end(++p, end)) return POSITION_ERR_SYNTAX;
+
+    // Castling
+    p = skip_spaces(p, end);
+    if (p >= end) return POSITION_ERR_SYNTAX;
+    if (*p == '-') {
+        p++;
+    } else {
+        for (; !at_field_end(p, end); p++) {
+            switch (*p) {
+                case 'K': pos->castlingRights |= 1; break;
+                case 'Q': pos->castlingRights |= 2; break;
+                case 'k': pos->castlingRights |= 4; break;
+                case 'q': pos->castlingRights |= 8; break;
+                default:
+                    if (*p >= 'A' && *p <= 'H') pos->castlingFiles[PLAYER_WHITE] |= (uint8_t)(1 << (*p - 'A'));
+                    else if (*p >= 'a' && *p <= 'h') pos->castlingFiles[PLAYER_BLACK] |= (uint8_t)(1 << (*p - 'a'));
+                    else return POSITION_ERR_SYNTAX;
+                    break;
+            }
+        }
+    }
+    if (!at_field_end(p, end)) return POSITION_ERR_SYNTAX;
+
+    // En passant
+    p = skip_spaces(p, end);
+    if (p >= end) return POSITION_ERR_SYNTAX;
+    if (*p == '-') {
+        p++;
+    } else {
+        if (end - p < 2 || p[0] < 'a' || p[0] > 'h' || p[1] < '1' || p[1] > '8') return POSITION_ERR_SYNTAX;
+        pos->enPassantSq = (int8_t)((8 - (p[1] - '0')) * 8 + (p[0] - 'a'));
+        p += 2;
+    }
+    if (!at_field_end(p, end)) return POSITION_ERR_SYNTAX;
+
+    return POSITION_OK;
+}
+
+// --- Attacks and move existence ---
+
+static Bitboard attackers_to(const LitePosition* pos, int sq, Bitboard occupied) {
+    Bitboard rookLike = pos->pieceBB[PIECE_ROOK] | pos->pieceBB[PIECE_QUEEN];
+    Bitboard bishopLike = pos->pieceBB[PIECE_BISHOP] | pos->pieceBB[PIECE_QUEEN];
+    Bitboard pawns = pos->pieceBB[PIECE_PAWN];
+
+    return (bb_pawn_attacks[PLAYER_WHITE][sq] & pawns & pos->colorBB[PLAYER_BLACK]) |
+           (bb_pawn_attacks[PLAYER_BLACK][sq] & pawns & pos->colorBB[PLAYER_WHITE]) |
+           (bb_knight_attacks[sq] & pos->pieceBB[PIECE_KNIGHT]) |
+           (bb_king_attacks[sq] & pos->pieceBB[PIECE_KING]) |
+           (bb_rook_attacks(sq, occupied) & rookLike) |
+           (bb_bishop_attacks(sq, occupied) & bishopLike);
+}
+
+static bool side_in_check(const LitePosition* pos, Player side) {
+    Bitboard king = pos->pieceBB[PIECE_KING] & pos->colorBB[side];
+    Bitboard occupied = pos->colorBB[PLAYER_WHITE] | pos->colorBB[PLAYER_BLACK];
+    return (attackers_to(pos, bb_lsb(king), occupied) & pos->colorBB[opponent(side)]) != 0;
+}
+
+static PieceType piece_on(const LitePosition* pos, int sq) {
+    for (int t = PIECE_KING; t <= PIECE_PAWN; t++) {
+        if (pos->pieceBB[t] & BB_SQUARE(sq)) return (PieceType)t;
+    }
+    return NO_PIECE;
+}
+
+// Play from->to on a copy and see whether the mover's king survives.
+// captureSq differs from to only for en passant.
+static bool leaves_king_safe(const LitePosition* pos, PieceType type, int from, int to, int captureSq) {
+    LitePosition next = *pos;
+    Player us = pos->turn;
+    Bitboard captured = BB_SQUARE(captureSq);
+    for (int t = PIECE_KING; t <= PIECE_PAWN; t++) next.pieceBB[t] &= ~captured;
+    next.colorBB[opponent(us)] &= ~captured;
+
+    Bitboard fromTo = BB_SQUARE(from) | BB_SQUARE(to);
+    next.pieceBB[type] ^= fromTo;
+    next.colorBB[us] ^= fromTo;
+    return !side_in_check(&next, us);
+}
+
+// Stops at the first legal move. Castling is never needed: it is only legal
+// when the king could also step to the adjacent square.
+static bool has_legal_move(const LitePosition* pos) {
+    Player us = pos->turn;
+    Player them = opponent(us);
+    Bitboard own = pos->colorBB[us];
+    Bitboard occupied = own | pos->colorBB[them];
+
+    Bitboard pieces = own;
+    while (pieces) {
+        int from = bb_pop_lsb(&pieces);
+        PieceType type = piece_on(pos, from);
+        Bitboard targets = BB_EMPTY;
+
+        switch (type) {
+            case PIECE_PAWN: {
+                // Pawns never stand on the back ranks here, so one step stays on the board
+                int forward = (us == PLAYER_WHITE) ? -8 : 8;
+                int startRow = (us == PLAYER_WHITE) ? 6 : 1;
+                int one = from + forward;
+                targets = bb_pawn_attacks[us][from] & pos->colorBB[them];
+                if (!(occupied & BB_SQUARE(one))) {
+                    targets |= BB_SQUARE(one);
+                    if (from / 8 == startRow && !(occupied & BB_SQUARE(one + forward))) {
+                        targets |= BB_SQUARE(one + forward);
+                    }
+                }
+                int ep = pos->enPassantSq;
+                if (ep >= 0 && (bb_pawn_attacks[us][from] & BB_SQUARE(ep)) &&
+                    leaves_king_safe(pos, PIECE_PAWN, from, ep, ep - forward)) {
+                    return true;
+                }
+                break;
+            }
+            case PIECE_KNIGHT:
+                targets = bb_knight_attacks[from] & ~own;
+                break;
+            case PIECE_BISHOP:
+                targets = bb_bishop_attacks(from, occupied) & ~own;
+                break;
+            case PIECE_ROOK:
+                targets = bb_rook_attacks(from, occupied) & ~own;
+                break;
+            case PIECE_QUEEN:
+                targets = (bb_rook_attacks(from, occupied) | bb_bishop_attacks(from, occupied)) & ~own;
+                break;
+            case PIECE_KING:
+                targets = bb_king_attacks[from] & ~own;
+                break;
+            default:
+                break;
+        }
+
+        while (targets) {
+            int to = bb_pop_lsb(&targets);
+            if (leaves_king_safe(pos, type, from, to, to)) return true;
+        }
+    }
+    return false;
+}
+
+// --- Validation ---
+
+static PositionError validate(const LitePosition* pos) {
+    for (int side = PLAYER_WHITE; side <= PLAYER_BLACK; side++) {
+        Bitboard mine = pos->colorBB[side];
+        if (bb_popcount(pos->pieceBB[PIECE_KING] & mine) != 1) return POSITION_ERR_KING_COUNT;
+        if (bb_popcount(mine) > 16 || bb_popcount(pos->pieceBB[PIECE_PAWN] & mine) > 8) {
+            return POSITION_ERR_PIECE_COUNT;
+        }
+    }
+
+    if (pos->pieceBB[PIECE_PAWN] & (BB_ROW_0 | BB_ROW_7)) return POSITION_ERR_PAWN_RANK;
+
+    // Each right needs its king on the back rank and a rook on the right
+    // side of it (Chess960: anywhere on the rank; KQkq take the outermost)
+    for (int side = PLAYER_WHITE; side <= PLAYER_BLACK; side++) {
+        uint8_t rights = (pos->castlingRights >> (side == PLAYER_WHITE ? 0 : 2)) & 3;
+        uint8_t files = pos->castlingFiles[side];
+        if (!rights && !files) continue;
+        int row = (side == PLAYER_WHITE) ? 7 : 0;
+        Bitboard mine = pos->colorBB[side];
+        Bitboard king = pos->pieceBB[PIECE_KING] & mine;
+        if (bb_lsb(king) / 8 != row) return POSITION_ERR_CASTLING;
+        int kingCol = bb_lsb(king) % 8;
+        uint8_t rookFiles = 0;
+        for (int c = 0; c < 8; c++) {
+            if (pos->pieceBB[PIECE_ROOK] & mine & BB_SQUARE(row * 8 + c)) rookFiles |= (uint8_t)(1 << c);
+        }
+        uint8_t kingside = (uint8_t)(0xFF << (kingCol + 1));
+        uint8_t queenside = (uint8_t)((1 << kingCol) - 1);
+        if ((rights & 1) && !(rookFiles & kingside)) return POSITION_ERR_CASTLING;
+        if ((rights & 2) && !(rookFiles & queenside)) return POSITION_ERR_CASTLING;
+        if ((files & rookFiles) != files || (files & (1 << kingCol))) return POSITION_ERR_CASTLING;
+    }
+
+    // The target sits behind a pawn of the side that just moved, with both
+    // the target and the pawn's start square empty
+    if (pos->enPassantSq >= 0) {
+        int ep = pos->enPassantSq;
+        int targetRow = (pos->turn == PLAYER_WHITE) ? 2 : 5;
+        int behind = (pos->turn == PLAYER_WHITE) ? 8 : -8;
+        Bitboard occupied = pos->colorBB[PLAYER_WHITE] | pos->colorBB[PLAYER_BLACK];
+        Bitboard theirPawns = pos->pieceBB[PIECE_PAWN] & pos->colorBB[opponent(pos->turn)];
+        if (ep / 8 != targetRow || !(theirPawns & BB_SQUARE(ep + behind)) ||
+            (occupied & (BB_SQUARE(ep) | BB_SQUARE(ep - behind)))) {
+            return POSITION_ERR_EN_PASSANT;
+        }
+    }
+
+    if (side_in_check(pos, opponent(pos->turn))) return POSITION_ERR_OPPONENT_IN_CHECK;
+    return POSITION_OK;
+}
+
+static PositionCheckResult check_position(const char* fen, size_t length) {
+    PositionCheckResult result = {POSITION_OK, 0};
+    LitePosition pos;
+
+    PositionError error = parse_fen(fen, length, &pos);
+    if (error == POSITION_OK) error = validate(&pos);
+    if (error != POSITION_OK) {
+        result.error = (uint8_t)error;
+        return result;
+    }
+
+    bool inCheck = side_in_check(&pos, pos.turn);
+    if (inCheck) result.flags |= POSITION_FLAG_CHECK;
+    if (!has_legal_move(&pos)) {
+        result.flags |= inCheck ? POSITION_FLAG_CHECKMATE : POSITION_FLAG_STALEMATE;
+    }
+    return result;
+}
+
+PositionCheckResult position_check_fen(const char* fen, size_t length) {
+    bitboard_init();
+    return check_position(fen, length);
+}
+
+const char* position_check_error_string(PositionError error) {
+    switch (error) {
+        case POSITION_OK: return "OK";
+        case POSITION_ERR_SYNTAX: return "Malformed FEN";
+        case POSITION_ERR_KING_COUNT: return "Each side needs exactly one king";
+        case POSITION_ERR_PIECE_COUNT: return "Too many pieces or pawns";
+        case POSITION_ERR_PAWN_RANK: return "Pawn on first or last rank";
+        case POSITION_ERR_CASTLING: return "Castling right without king and rook at home";
+        case POSITION_ERR_EN_PASSANT: return "Impossible en passant square";
+        case POSITION_ERR_OPPONENT_IN_CHECK: return "Side not to move is in check";
+        default: return "Unknown error";
+    }
+}
+
+// --- Parallel driver ---
+
+// One contiguous slice of the input per thread
+typedef struct {
+    const char* const* fens;   // NUL-terminated input, or NULL when spans is set
+    const FenSpan* spans;
+    PositionCheckResult* results;
+    int begin;
+    int end;
+    int valid;
+} CheckSlice;
+
+static void* check_slice(void* arg) {
+    CheckSlice* slice = (CheckSlice*)arg;
+    for (int i = slice->begin; i < slice->end; i++) {
+        PositionCheckResult r;
+        if (slice->spans) {
+            r = check_position(slice->spans[i].text, slice->spans[i].length);
+        } else {
+            const char* fen = slice->fens[i];
+            r = check_position(fen, fen ? strlen(fen) : 0);
+        }
+        slice->results[i] = r;
+        if (r.error == POSITION_OK) slice->valid++;
+    }
+    return NULL;
+}
+
+static int run_slices(const char* const* fens, const FenSpan* spans, int count,
+                      PositionCheckResult* results, int threads) {
+    if (count <= 0 || !results) return 0;
+    bitboard_init(); // Fill the attack tables before any worker reads them
+
+    if (threads <= 0) threads = platform_cpu_count();
+    int maxThreads = (count + MIN_POSITIONS_PER_THREAD - 1) / MIN_POSITIONS_PER_THREAD;
+    if (threads > maxThreads) threads = maxThreads;
+    if (threads < 1) threads = 1;
+
+    CheckSlice* slices = (CheckSlice*)calloc((size_t)threads, sizeof(CheckSlice));
+    pthread_t* handles = (pthread_t*)calloc((size_t)threads, sizeof(pthread_t));
+    bool* started = (bool*)calloc((size_t)threads, sizeof(bool));
+    if (!slices || !handles || !started) {
+        free(slices);
+        free(handles);
+        free(started);
+        CheckSlice whole = {fens, spans, results, 0, count, 0};
+        check_slice(&whole);
+        return whole.valid;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        slices[t] = (CheckSlice){fens, spans, results,
+                                 (int)((int64_t)count * t / threads),
+                                 (int)((int64_t)count * (t + 1) / threads), 0};
+    }
+    // Slice 0 runs on the calling thread; a slice whose thread fails to start does too
+    for (int t = 1; t < threads; t++) {
+        started[t] = pthread_create(&handles[t], NULL, check_slice, &slices[t]) == 0;
+    }
+    check_slice(&slices[0]);
+
+    int valid = slices[0].valid;
+    for (int t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        } else {
+            check_slice(&slices[t]);
+        }
+        valid += slices[t].valid;
+    }
+
+    free(slices);
+    free(handles);
+    free(started);
+    return valid;
+}
+
+int position_check_batch(const char* const* fens, int count, PositionCheckResult* results, int threads) {
+    if (!fens) return 0;
+    return run_slices(fens, NULL, count, results, threads);
+}
+
+// --- EPD files ---
+
+int position_check_epd_file(const char* path, PositionCheckResult** results, int threads) {
+    if (!path || !results) return -1;
+    *results = NULL;
+
+    MappedFile mf;
+    if (!platform_map_file(path, &mf)) return -1;
+
+    // Upper bound on lines, then split in place (spans point into the mapping)
+    size_t lines = 1;
+    for (size_t i = 0; i < mf.size; i++) {
+        if (mf.data[i] == '\n') lines++;
+    }
+    FenSpan* spans = (FenSpan*)malloc(lines * sizeof(FenSpan));
+    if (!spans) {
+        platform_unmap_file(&mf);
+        return -1;
+    }
+
+    int count = 0;
+    const char* p = mf.data;
+    const char* end = mf.data + mf.size;
+    while (p < end) {
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        const char* lineEnd = nl ? nl : end;
+        const char* trimmed = lineEnd;
+        while (trimmed > p && (trimmed[-1] == '\r' || trimmed[-1] == ' ' || trimmed[-1] == '\t')) trimmed--;
+        const char* start = skip_spaces(p, trimmed);
+        if (start < trimmed) {
+            spans[count].text = start;
+            spans[count].length = (size_t)(trimmed - start);
+            count++;
+        }
+        p = nl ? nl + 1 : end;
+    }
+
+    if (count > 0) {
+        *results = (PositionCheckResult*)malloc((size_t)count * sizeof(PositionCheckResult));
+        if (*results) {
+            run_slices(NULL, spans, count, *results, threads);
+        } else {
+            count = -1;
+        }
+    }
+
+    free(spans);
+    platform_unmap_file(&mf);
+    return count;
+}
@@ -0,0 +1,49 @@
+#ifndef POSITION_CHECK_H
+#define POSITION_CHECK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Bulk FEN/EPD validation. Positions are parsed into a small stack-only
+// board, so none of this touches GameLogic and it is safe to run from
+// several threads at once.
+
+// Why a position was rejected (first problem found wins)
+typedef enum {
+    POSITION_OK = 0,
+    POSITION_ERR_SYNTAX,            // Malformed placement, side, castling or ep field
+    POSITION_ERR_KING_COUNT,        // Not exactly one king per side
+    POSITION_ERR_PIECE_COUNT,       // More than 16 pieces or 8 pawns for a side
+    POSITION_ERR_PAWN_RANK,         // Pawn on the first or last rank
+    POSITION_ERR_CASTLING,          // Castling right without king and rook at home
+    POSITION_ERR_EN_PASSANT,        // Ep square with no pawn that just double-pushed
+    POSITION_ERR_OPPONENT_IN_CHECK  // Side not to move is in check
+} PositionError;
+
+// Result flags, only meaningful when error == POSITION_OK
+#define POSITION_FLAG_CHECK     0x01  // Side to move is in check
+#define POSITION_FLAG_CHECKMATE 0x02
+#define POSITION_FLAG_STALEMATE 0x04
+
+typedef struct {
+    uint8_t error;  // PositionError
+    uint8_t flags;  // POSITION_FLAG_*
+} PositionCheckResult;
+
+// Check one FEN or EPD line. Only the first four fields are read, so move
+// clocks and EPD opcodes are ignored. fen need not be NUL-terminated.
+PositionCheckResult position_check_fen(const char* fen, size_t length);
+
+// Check count NUL-terminated FENs into results[0..count).
+// threads <= 0 uses every core. Returns the number of valid positions.
+int position_check_batch(const char* const* fens, int count, PositionCheckResult* results, int threads);
+
+// Memory-map an EPD file and check every non-empty line.
+// *results receives a malloc'd array (one entry per line, caller frees).
+// Returns the line count, or -1 if the file could not be read.
+int position_check_epd_file(const char* path, PositionCheckResult** results, int threads);
+
+// Readable name for a PositionError
+const char* position_check_error_string(PositionError error);
+
+#endif // POSITION_CHECK_H
@@ -511,6 +511,9 @@ static int puzzle_count = 0;
 static int puzzle_capacity = 0;
 static bool initialized = false;
 
+static EpdPool** puzzle_pools = NULL; // Suites whose strings shared puzzles point into
+static int pool_count = 0;
+
 void puzzles_init(void) {
     if (initialized) return;
     
@@ -547,6 +550,7 @@ void puzzles_add_custom(const Puzzle* p) {
     
     // Copy puzzle data
     Puzzle new_p = *p;
+    new_p.shared = false;
     
     // Duplicate strings
     new_p.title = _strdup(p->title ? p->title : "Custom Puzzle");
@@ -564,6 +568,45 @@ void puzzles_add_custom(const Puzzle* p) {
     all_puzzles[puzzle_count++] = new_p;
 }
 
+int puzzles_add_from_epd(EpdPool* pool) {
+    if (!initialized) puzzles_init();
+    if (!pool) return 0;
+
+    EpdPool** pools = (EpdPool**)realloc(puzzle_pools, sizeof(EpdPool*) * (pool_count + 1));
+    if (!pools) return 0;
+    puzzle_pools = pools;
+
+    int added = 0;
+    int count = epd_pool_count(pool);
+    for (int i = 0; i < count; i++) {
+        const EpdEntry* e = epd_pool_entry(pool, i);
+        if (e->bestUci == 0) continue;
+
+        if (puzzle_count >= puzzle_capacity) {
+            int capacity = puzzle_capacity * 2;
+            Puzzle* grown = (Puzzle*)realloc(all_puzzles, sizeof(Puzzle) * capacity);
+            if (!grown) break;
+            all_puzzles = grown;
+            puzzle_capacity = capacity;
+        }
+
+        Puzzle p;
+        memset(&p, 0, sizeof(p));
+        p.title = e->id ? epd_pool_string(pool, e->id) : "EPD Puzzle";
+        p.description = e->c0 ? epd_pool_string(pool, e->c0) : "Find the best move.";
+        p.fen = epd_pool_string(pool, e->fen);
+        p.solution_moves[0] = epd_pool_string(pool, e->bestUci);
+        p.solution_length = 1;
+        p.turn = (Player)e->turn;
+        p.shared = true;
+        all_puzzles[puzzle_count++] = p;
+        added++;
+    }
+
+    if (added > 0) puzzle_pools[pool_count++] = epd_pool_retain(pool);
+    return added;
+}
+
 void puzzles_cleanup(void) {
     if (!all_puzzles) return;
     
@@ -571,6 +614,7 @@ void puzzles_cleanup(void) {
     int builtin_count = sizeof(builtin_puzzles) / sizeof(Puzzle);
     
     for (int i = builtin_count; i < puzzle_count; i++) {
+        if (all_puzzles[i].shared) continue;
         // Free strings (cast to void* to remove const qualifier)
         free((void*)all_puzzles[i].title);
         free((void*)all_puzzles[i].description);
@@ -580,6 +624,11 @@ void puzzles_cleanup(void) {
         }
     }
     
+    for (int i = 0; i < pool_count; i++) epd_pool_release(puzzle_pools[i]);
+    free(puzzle_pools);
+    puzzle_pools = NULL;
+    pool_count = 0;
+
     free(all_puzzles);
     all_puzzles = NULL;
     puzzle_count = 0;
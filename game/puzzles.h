@@ -2,6 +2,7 @@
 #define PUZZLES_H
 
 #include "types.h"
+#include "epd_pool.h"
 
 #define MAX_PUZZLE_MOVES 10
 
@@ -12,6 +13,7 @@ typedef struct {
     const char* solution_moves[MAX_PUZZLE_MOVES]; // UCI format (e.g. "e2e4")
     int solution_length;
     Player turn;
+    bool shared;    // Strings belong to an EpdPool, not to the puzzle list
 } Puzzle;
 
 // Returns count of available puzzles
@@ -28,6 +30,11 @@ void puzzles_init(void);
 // Note: Strings in 'p' are copied.
 void puzzles_add_custom(const Puzzle* p);
 
+// Add every entry of an EPD suite that has a playable best move (bm) as a
+// one-move puzzle. Strings are not copied: the list keeps a reference to
+// the pool instead. Returns the number of puzzles added.
+int puzzles_add_from_epd(EpdPool* pool);
+
 // Cleanup resources
 void puzzles_cleanup(void);
 
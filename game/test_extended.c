@@ -1,26 +1,9 @@
 #include "gamelogic.h"
 #include "move.h"
-#include "piece.h"
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
 
-// Helper to access internal move stack (hacky but needed for black-box testing if we don't expose it)
-// We know from gamelogic.c:
-// typedef struct StackNode { void* data; struct StackNode* next; } StackNode;
-// typedef struct { StackNode* top; int size; } Stack;
-// Logic->moveHistory is a Stack*.
-// We will replicate these structs here to inspect them.
-typedef struct StackNode {
-    void* data;
-    struct StackNode* next;
-} StackNode;
-
-typedef struct {
-    StackNode* top;
-    int size;
-} Stack;
-
 static int tests_passed = 0;
 static int tests_failed = 0;
 
@@ -34,7 +17,7 @@ static void assert_condition(bool condition, const char* message) {
     }
 }
 
-// Test 1: Verify UCI generation does NOT destroy Move history pointers
+// Test 1: Verify UCI generation does NOT disturb the recorded history
 static void test_uci_pointer_stability(void) {
     printf("\n[Test] UCI Pointer Stability\n");
     GameLogic* logic = gamelogic_create();
@@ -44,18 +27,16 @@ static void test_uci_pointer_stability(void) {
     gamelogic_perform_move(logic, m);
     move_free(m); // logic makes a copy
     
-    Stack* s = (Stack*)logic->moveHistory;
-    Move* moveInHistoryBefore = (Move*)s->top->data;
-    printf("  Move ptr before SAN: %p\n", moveInHistoryBefore);
+    PackedMove recordedBefore = logic->history[logic->historyCount - 1].move;
+    Move lastMove = gamelogic_get_last_move(logic);
     
     char uci[16];
-    gamelogic_get_move_uci(logic, moveInHistoryBefore, uci, sizeof(uci));
+    gamelogic_get_move_uci(logic, &lastMove, uci, sizeof(uci));
     printf("  UCI Generated: %s\n", uci);
     
-    Move* moveInHistoryAfter = (Move*)s->top->data;
-    printf("  Move ptr after UCI:  %p\n", moveInHistoryAfter);
+    PackedMove recordedAfter = logic->history[logic->historyCount - 1].move;
     
-    assert_condition(moveInHistoryBefore == moveInHistoryAfter, "Move pointer should remain identical (no free/malloc)");
+    assert_condition(logic->historyCount == 1 && recordedBefore == recordedAfter, "Recorded move should remain identical");
     assert_condition(strcmp(uci, "e2e4") == 0, "Output should be UCI 'e2e4'");
     
     gamelogic_free(logic);
@@ -68,14 +49,12 @@ static void test_capture_integrity(void) {
     
     // Setup: White Rook on a1, Black Pawn on a2
     // Clear board
-    for(int i=0; i<8; i++) for(int j=0; j<8; j++) {
-        if(logic->board[i][j]) { piece_free(logic->board[i][j]); logic->board[i][j] = NULL; }
-    }
+    gamelogic_clear_board(logic);
     
-    logic->board[7][0] = piece_create(PIECE_ROOK, PLAYER_WHITE);
-    logic->board[6][0] = piece_create(PIECE_PAWN, PLAYER_BLACK); // Victim
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 7, 0, PIECE_ROOK, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 6, 0, PIECE_PAWN, PLAYER_BLACK); // Victim
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 0, 4, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     
     // Move: Rxa2
@@ -83,37 +62,39 @@ static void test_capture_integrity(void) {
     gamelogic_perform_move(logic, m);
     move_free(m);
     
-    Stack* s = (Stack*)logic->moveHistory;
-    Move* captureMove = (Move*)s->top->data;
+    Move captureMove = gamelogic_get_last_move(logic);
     
-    assert_condition(captureMove->capturedPieceType == PIECE_PAWN, "Move should record capture of PAWN");
+    assert_condition(captureMove.capturedPieceType == PIECE_PAWN, "Move should record capture of PAWN");
     
-    // Generate UCI (this triggers the Peek/Restore logic if any exists, now safe)
+    // Generate UCI and SAN (SAN is read from the last ply's cache; the board is not touched)
     char uci[16];
-    gamelogic_get_move_uci(logic, captureMove, uci, sizeof(uci));
+    gamelogic_get_move_uci(logic, &captureMove, uci, sizeof(uci));
     printf("  UCI: %s\n", uci);
+    char san[16];
+    gamelogic_get_move_san(logic, &captureMove, san, sizeof(san));
+    printf("  SAN: %s\n", san);
     
-    Move* captureMoveAfter = (Move*)s->top->data;
-    assert_condition(captureMove == captureMoveAfter, "Pointer should be stable");
+    Move captureMoveAfter = gamelogic_get_last_move(logic);
+    assert_condition(logic->historyCount == 1 && captureMoveAfter.to_sq == captureMove.to_sq, "History should be unchanged");
     
     // KEY CHECK: Did the capture type get preserved?
     // If make_move_internal cleared it and didn't see the piece (because of bad restore), it would be NO_PIECE
-    assert_condition(captureMoveAfter->capturedPieceType == PIECE_PAWN, 
+    assert_condition(captureMoveAfter.capturedPieceType == PIECE_PAWN, 
                      "Captured Piece Type should still be PAWN after SAN generation");
                      
     // Undo
     gamelogic_undo_move(logic);
     
     // Check Board
-    assert_condition(logic->board[6][0] != NULL, "Pawn should be restored");
-    if(logic->board[6][0]) {
-        assert_condition(logic->board[6][0]->type == PIECE_PAWN, "Restored piece should be PAWN");
-        assert_condition(logic->board[6][0]->owner == PLAYER_BLACK, "Restored piece should be BLACK");
+    assert_condition(gamelogic_get_piece(logic, 6, 0) != NULL, "Pawn should be restored");
+    if(gamelogic_get_piece(logic, 6, 0)) {
+        assert_condition(gamelogic_get_piece(logic, 6, 0)->type == PIECE_PAWN, "Restored piece should be PAWN");
+        assert_condition(gamelogic_get_piece(logic, 6, 0)->owner == PLAYER_BLACK, "Restored piece should be BLACK");
     }
     
-    assert_condition(logic->board[7][0] != NULL, "Rook should be back");
-    if (logic->board[7][0]) {
-        assert_condition(logic->board[7][0]->type == PIECE_ROOK, "Rook should be ROOK");
+    assert_condition(gamelogic_get_piece(logic, 7, 0) != NULL, "Rook should be back");
+    if (gamelogic_get_piece(logic, 7, 0)) {
+        assert_condition(gamelogic_get_piece(logic, 7, 0)->type == PIECE_ROOK, "Rook should be ROOK");
     }
     
     gamelogic_free(logic);
@@ -139,16 +120,15 @@ static void test_graveyard_sequence(void) {
     gamelogic_perform_move(logic, m3); move_free(m3);
     
     // Check M3 capture
-    Stack* s = (Stack*)logic->moveHistory;
-    Move* capture1 = (Move*)s->top->data;
-    assert_condition(capture1->capturedPieceType == PIECE_PAWN, "First capture is PAWN");
+    Move capture1 = gamelogic_get_last_move(logic);
+    assert_condition(capture1.capturedPieceType == PIECE_PAWN, "First capture is PAWN");
     
     Move* m4 = move_create(0*8+3, 3*8+3); // Qxd5
     gamelogic_perform_move(logic, m4); move_free(m4);
     
     // Check M4 capture
-    Move* capture2 = (Move*)s->top->data;
-    assert_condition(capture2->capturedPieceType == PIECE_PAWN, "Second capture is PAWN");
+    Move capture2 = gamelogic_get_last_move(logic);
+    assert_condition(capture2.capturedPieceType == PIECE_PAWN, "Second capture is PAWN");
     
     // Verify Graveyard Content via history iteration
     // The GUI iterates history to find captured pieces.
@@ -180,12 +160,51 @@ static void test_graveyard_sequence(void) {
     gamelogic_free(logic);
 }
 
+// Test 4: SAN is recorded with each ply when the move is played
+static void test_san_cached_per_ply(void) {
+    printf("\n[Test] SAN Cached Per Ply\n");
+    GameLogic* logic = gamelogic_create();
+    
+    static const struct { const char* fen; const char* uci; const char* san; } lines[] = {
+        {NULL, "d2d4 d7d5 g1f3 b8c6 b1d2", "Nbd2"},                             // File disambiguation
+        {"4k3/8/8/R7/8/8/8/R3K3 w - - 0 1", "a1a3", "R1a3"},                    // Rank disambiguation
+        {"4k3/8/8/8/8/Q7/8/Q1Q1K3 w - - 0 1", "a1b2", "Qa1b2"},                 // Both
+        {"4k3/8/8/b7/8/2N3N1/8/4K3 w - - 0 1", "g3e2", "Ne2"},                 // Nc3 is pinned
+        {NULL, "e2e4 f7f5 d1h5", "Qh5+"},
+        {NULL, "e2e4 e7e5 f1c4 b8c6 d1h5 g8f6 h5f7", "Qxf7#"},
+        {NULL, "e2e4 e7e5 g1f3 b8c6 f1c4 g8f6 e1g1", "O-O"},
+        {NULL, "a2a4 b7b5 a4b5 a7a6 b5a6 c8b7 a6b7 b8c6 b7a8q", "bxa8=Q"},
+        {NULL, "e2e4 a7a6 e4e5 d7d5 e5d6", "exd6"},                             // En passant
+    };
+    for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+        gamelogic_load_from_uci_moves(logic, lines[i].uci, lines[i].fen);
+        const char* san = gamelogic_get_san_at(logic, logic->historyCount - 1);
+        char msg[96];
+        snprintf(msg, sizeof(msg), "Last ply SAN is '%s' (got '%s')", lines[i].san, san ? san : "(none)");
+        assert_condition(san && strcmp(san, lines[i].san) == 0, msg);
+    }
+    
+    // Every ply of the last line has its SAN, and the getter agrees with the cache
+    assert_condition(gamelogic_get_san_at(logic, 0) && strcmp(gamelogic_get_san_at(logic, 0), "e4") == 0 &&
+                     strcmp(gamelogic_get_san_at(logic, 3), "d5") == 0, "Earlier plies keep their SAN");
+    Move last = gamelogic_get_last_move(logic);
+    char san[16];
+    gamelogic_get_move_san(logic, &last, san, sizeof(san));
+    assert_condition(strcmp(san, "exd6") == 0, "gamelogic_get_move_san returns the cached SAN");
+    
+    // Undo drops the ply and its SAN
+    gamelogic_undo_move(logic);
+    assert_condition(gamelogic_get_san_at(logic, logic->historyCount) == NULL, "Undone ply has no SAN");
+    
+    gamelogic_free(logic);
+}
 
 int main(void) {
     printf("--- RUNNING EXTENDED REGRESSION TESTS ---\n");
     test_uci_pointer_stability();
     test_capture_integrity();
     test_graveyard_sequence();
+    test_san_cached_per_ply();
     
     printf("\n--- SUMMARY ---\n");
     if (tests_failed == 0) {
@@ -4,6 +4,9 @@
 #include "game_import.h"
 #include "gamelogic.h"
 #include "move.h"
+#include "pgn_export.h"
+
+static int failures = 0;
 
 // Simple test runner
 void run_test(const char* name, const char* input, int expected_moves, const char* expected_uci_substr) {
@@ -29,8 +32,11 @@ void run_test(const char* name, const char* input, int expected_moves, const cha
     
     if (passed) {
         printf(" PASS\n");
+    } else {
+        failures++;
     }
     
+    game_import_result_free(&res);
     gamelogic_free(logic);
 }
 
@@ -120,6 +126,48 @@ void test_san_ambiguity() {
     run_test("SAN Ambiguity (Nbd2)", input, 5, "b1d2");
 }
 
+void test_san_capture_and_en_passant() {
+    run_test("SAN Capture (exd5)", "1. e4 d5 2. exd5", 3, "e4d5");
+    run_test("SAN En Passant (exd6)", "1. e4 a6 2. e5 d5 3. exd6", 5, "e5d6");
+}
+
+void test_san_promotion_capture() {
+    run_test("SAN Promotion (bxa8=Q)", "1. a4 b5 2. axb5 a6 3. bxa6 Bb7 4. axb7 Nc6 5. bxa8=Q", 9, "b7a8q");
+    run_test("SAN Underpromotion (bxa8N)", "1. a4 b5 2. axb5 a6 3. bxa6 Bb7 4. axb7 Nc6 5. bxa8N", 9, "b7a8n");
+}
+
+void test_san_pinned_candidate() {
+    // The c3 knight is pinned by Bb4, so "Ne2" needs no disambiguation
+    run_test("SAN Pinned Candidate (Ne2)", "1. e4 e5 2. d4 Bb4+ 3. Nc3 a6 4. Ne2", 7, "g1e2");
+}
+
+void test_san_annotations() {
+    run_test("SAN Annotations (Nf3!?)", "1. Nf3!? d5?! 2. g3 Nf6 3. Bg2 e6 4. 0-0", 7, "g1f3 d7d5 g2g3 g8f6 f1g2 e7e6 e1g1");
+}
+
+// Moves the decoder must refuse
+static void run_reject_test(const char* name, const char* input) {
+    printf("Running Test: %s...", name);
+    
+    GameLogic* logic = gamelogic_create();
+    GameImportResult res = game_import_from_string(logic, input);
+    if (res.success) {
+        printf(" FAIL (Accepted: '%s')\n", res.loaded_uci);
+        failures++;
+    } else {
+        printf(" PASS\n");
+    }
+    game_import_result_free(&res);
+    gamelogic_free(logic);
+}
+
+void test_san_rejects() {
+    run_reject_test("SAN Reject Ambiguous (Nd2)", "1. d4 d5 2. Nf3 Nc6 3. Nd2");
+    run_reject_test("SAN Reject Blocked (Bc4)", "1. Bc4");
+    run_reject_test("SAN Reject Promotion Off Last Rank (e4=Q)", "1. e4=Q");
+    run_reject_test("SAN Reject Bad Disambiguation (Nbf3)", "1. Nbf3");
+}
+
 void test_uci_input() {
     run_test("UCI Input (e2e4)", "1. e2e4", 1, "e2e4");
 }
@@ -129,6 +177,256 @@ void test_uci_promotion() {
     // Again, legality check prevents testing invalid moves.
 }
 
+// Collects what the streaming reader hands out
+typedef struct {
+    int calls;
+    int moves[8];
+    bool success[8];
+    char white[8][64];
+    int stop_after;
+} StreamLog;
+
+static bool record_game(const GameImportResult* game, int index, void* user_data) {
+    StreamLog* log = (StreamLog*)user_data;
+    if (index < 8) {
+        log->moves[index] = game->moves_count;
+        log->success[index] = game->success;
+        snprintf(log->white[index], sizeof(log->white[index]), "%s", game->white);
+    }
+    log->calls++;
+    return log->stop_after == 0 || log->calls < log->stop_after;
+}
+
+static void check(bool ok, const char* name) {
+    printf("Running Test: %s... %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) failures++;
+}
+
+void test_stream_multi_game() {
+    FILE* f = tmpfile();
+    if (!f) {
+        check(false, "Stream: tmpfile");
+        return;
+    }
+    fputs("\xEF\xBB\xBF[Event \"Club\"]\n[White \"Ann\"]\n\n1. e4 e5 2. Nf3 {a comment\n[%clk 0:05:00] } Nc6 1-0\n\n"
+          "[White \"Bob\"]\r\n\r\n1. d4 d5 *\r\n\r\n"
+          "[White \"Cy\"]\n\n1. e4 Ke7 2. Qh5 Kxh5 0-1\n", f);
+    
+    // A game longer than the old 4096-byte UCI buffer (800 plies)
+    fputs("\n[White \"Dee\"]\n\n", f);
+    const char* cycle[] = {"Nf3", "Nf6", "Ng1", "Ng8"};
+    for (int i = 0; i < 800; i++) fprintf(f, "%s ", cycle[i % 4]);
+    fputs("*\n", f);
+    rewind(f);
+    
+    GameLogic* logic = gamelogic_create();
+    StreamLog log = {0};
+    GameImportStats stats;
+    int games = game_import_pgn_stream(logic, f, record_game, &log, &stats);
+    
+    check(games == 4 && log.calls == 4, "Stream: four games found");
+    check(log.success[0] && log.moves[0] == 4 && strcmp(log.white[0], "Ann") == 0,
+          "Stream: comment with [%clk] stays in game 1");
+    check(log.success[1] && log.moves[1] == 2 && strcmp(log.white[1], "Bob") == 0, "Stream: CRLF game");
+    check(!log.success[2] && strcmp(log.white[2], "Cy") == 0, "Stream: illegal game reported, reading continues");
+    check(log.success[3] && log.moves[3] == 800, "Stream: long game not truncated");
+    check(stats.imported == 3 && stats.failed == 1 && !stats.io_error, "Stream: stats");
+    
+    // Callback can stop the stream early
+    rewind(f);
+    StreamLog stop = {0};
+    stop.stop_after = 2;
+    games = game_import_pgn_stream(logic, f, record_game, &stop, NULL);
+    check(games == 2 && stop.calls == 2, "Stream: callback stops reading");
+    
+    gamelogic_free(logic);
+    fclose(f);
+}
+
+void test_variation_tree() {
+    const char* pgn =
+        "[White \"Ann\"]\n\n"
+        "{Opening notes} 1. e4 $1 e5 (1... c5 {Sicilian} 2. Nf3 (2. c3) d6) (1... e6!?) "
+        "2. Nf3 {[%clk 0:05:00]} Nc6 {[%clk 0:05:00]} 3. Bb5?! ; Ruy Lopez\n"
+        "a6 $2 1-0";
+    
+    GameLogic* logic = gamelogic_create();
+    GameTree tree;
+    bool ok = game_tree_init(&tree);
+    GameImportResult res = game_import_from_string_with_tree(logic, pgn, &tree);
+    
+    check(ok && res.success && res.moves_count == 6 && strcmp(res.loaded_uci, "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6") == 0,
+          "Tree: main line unchanged by side lines");
+    char fen[128];
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    check(strncmp(fen, "r1bqkbnr/1ppp1ppp/p1n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R w", 55) == 0,
+          "Tree: logic ends on the main line");
+    
+    int32_t e4 = game_tree_main_line_node(&tree, 1);
+    int32_t e5 = game_tree_main_line_node(&tree, 2);
+    const char* root_comment = game_tree_comment(&tree, GAME_TREE_ROOT);
+    check(root_comment && strcmp(root_comment, "Opening notes") == 0, "Tree: comment before first move");
+    check(tree.nodes[e4].nags[0] == 1, "Tree: $1 on 1. e4");
+    check(game_tree_child_count(&tree, e4) == 3, "Tree: two alternatives to 1... e5");
+    
+    int32_t c5 = tree.nodes[e5].nextSibling;
+    int32_t e6 = c5 != GAME_TREE_NONE ? tree.nodes[c5].nextSibling : GAME_TREE_NONE;
+    const char* c5_comment = game_tree_comment(&tree, c5);
+    check(c5_comment && strcmp(c5_comment, "Sicilian") == 0, "Tree: comment in side line");
+    check(e6 != GAME_TREE_NONE && tree.nodes[e6].nags[0] == 5, "Tree: suffix !? becomes $5");
+    
+    // Nested side line: 1... c5 2. Nf3 (2. c3) d6
+    int32_t nf3 = game_tree_main_child(&tree, c5);
+    int32_t c3 = nf3 != GAME_TREE_NONE ? tree.nodes[nf3].nextSibling : GAME_TREE_NONE;
+    char line[64];
+    check(c3 != GAME_TREE_NONE && game_tree_path_uci(&tree, c3, line, sizeof(line)) &&
+          strcmp(line, "e2e4 c7c5 c2c3") == 0, "Tree: nested side line path");
+    check(game_tree_path_uci(&tree, game_tree_main_child(&tree, nf3), line, sizeof(line)) &&
+          strcmp(line, "e2e4 c7c5 g1f3 d7d6") == 0, "Tree: side line continues after nested one");
+    
+    int32_t bb5 = game_tree_main_line_node(&tree, 5);
+    const char* bb5_comment = game_tree_comment(&tree, bb5);
+    check(tree.nodes[bb5].nags[0] == 6 && bb5_comment && strcmp(bb5_comment, "Ruy Lopez") == 0,
+          "Tree: ?! and ; comment on 3. Bb5");
+    check(tree.nodes[game_tree_main_line_node(&tree, 3)].comment == tree.nodes[game_tree_main_line_node(&tree, 4)].comment,
+          "Tree: repeated comments interned once");
+    
+    game_tree_compact(&tree);
+    check(tree.nodeCapacity == tree.nodeCount && tree.nodeCount == 12 && game_tree_comment(&tree, c5) != NULL,
+          "Tree: compact keeps nodes and comments");
+    
+    // Plain import still skips the annotations; a bad side line fails the game
+    game_import_result_free(&res);
+    res = game_import_from_string(logic, pgn);
+    check(res.success && res.moves_count == 6, "Tree: plain import skips side lines and NAGs");
+    game_import_result_free(&res);
+    res = game_import_from_string_with_tree(logic, "1. e4 e5 (1... Ke7 2. Qh5 Kxh5) 2. Nf3 *", &tree);
+    check(!res.success, "Tree: illegal move in side line rejected");
+    
+    game_import_result_free(&res);
+    game_tree_free(&tree);
+    gamelogic_free(logic);
+}
+
+void test_pgn_export() {
+    FILE* f = tmpfile();
+    PgnWriter* writer = f ? pgn_writer_open_stream(f) : NULL;
+    if (!writer) {
+        check(false, "Export: open writer");
+        if (f) fclose(f);
+        return;
+    }
+    
+    const int think[] = {2000, 3500, 61000, 500};
+    const PgnEval evals[] = {{true, false, 31}, {true, false, -5}, {false, false, 0}, {true, true, -2}};
+    PgnGameRecord game = {0};
+    game.event = "Club \"Open\"";
+    game.date = "2024.05.01";
+    game.white = "Ann";
+    game.black = "Bob";
+    game.result = "0-1";
+    game.moves_uci = "f2f3 e7e5 g2g4 d8h4";
+    game.clock_enabled = true;
+    game.clock_initial_ms = 300000;
+    game.clock_increment_ms = 2000;
+    game.think_time_ms = think;
+    game.think_time_count = 4;
+    game.evals = evals;
+    game.eval_count = 4;
+    bool ok1 = pgn_writer_write_game(writer, &game);
+    
+    // Black to move from a FEN, no clock; the bad move cuts the game short
+    PgnGameRecord cut = {0};
+    cut.result = "*";
+    cut.start_fen = "4k3/8/8/8/8/8/4P3/4K3 b - - 0 12";
+    cut.moves_uci = "e8d7 e2e4 e2e4";
+    bool ok2 = pgn_writer_write_game(writer, &cut);
+    check(ok1 && !ok2 && pgn_writer_close(writer), "Export: games written");
+    
+    char text[2048];
+    rewind(f);
+    size_t n = fread(text, 1, sizeof(text) - 1, f);
+    text[n] = '\0';
+    fclose(f);
+    
+    check(strstr(text, "[Event \"Club \\\"Open\\\"\"]") != NULL && strstr(text, "[TimeControl \"300+2\"]") != NULL,
+          "Export: tags escaped, time control");
+    // Movetext wraps before column 80
+    check(strstr(text, "\n1. f3 {[%eval 0.31] [%clk 0:05:00]} e5 {[%eval -0.05] [%clk 0:04:58]} 2. g4\n"
+                       "{[%clk 0:04:01]} Qh4# {[%eval #-2] [%clk 0:05:00]} 0-1\n") != NULL,
+          "Export: SAN with eval and clock comments");
+    check(strstr(text, "[SetUp \"1\"]\n[FEN \"4k3/8/8/8/8/8/4P3/4K3 b - - 0 12\"]") != NULL &&
+          strstr(text, "12... Kd7 13. e4 *") != NULL, "Export: FEN start, black first, cut at bad move");
+    
+    // The importer reads its own output back
+    GameLogic* logic = gamelogic_create();
+    GameImportResult res = game_import_from_string(logic, text);
+    check(res.success && strcmp(res.loaded_uci, "f2f3 e7e5 g2g4 d8h4") == 0 && strcmp(res.white, "Ann") == 0,
+          "Export: round trip through import");
+    game_import_result_free(&res);
+    gamelogic_free(logic);
+}
+
+// Checks that indices arrive in order and counts moves
+typedef struct {
+    int calls;
+    int out_of_order;
+    int moves;
+    int stop_after;
+} ParallelLog;
+
+static bool record_parallel(const GameImportResult* game, int index, void* user_data) {
+    ParallelLog* log = (ParallelLog*)user_data;
+    if (index != log->calls) log->out_of_order++;
+    log->calls++;
+    if (game->success) log->moves += game->moves_count;
+    return log->stop_after == 0 || log->calls < log->stop_after;
+}
+
+void test_parallel_import() {
+    const char* path = "test_parallel_import.pgn";
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        check(false, "Parallel: create file");
+        return;
+    }
+    // Enough games for several batches; every tenth one is illegal
+    const int total = 250;
+    for (int i = 0; i < total; i++) {
+        fprintf(f, "[Event \"Game %d\"]\n\n", i);
+        if (i % 10 == 9) fputs("1. e4 Ke7 2. Qh5 Kxh5 0-1\n\n", f);
+        else fputs("1. e4 e5 2. Nf3 {[%clk 0:05:00]} Nc6 3. Bb5 1-0\n\n", f);
+    }
+    fclose(f);
+    
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        ParallelLog log = {0};
+        GameImportParallelStats stats;
+        int games = game_import_pgn_file_parallel(path, threads, record_parallel, &log, &stats);
+        
+        int worker_games = 0, worker_failed = 0;
+        for (int w = 0; w < stats.workers; w++) {
+            worker_games += stats.worker[w].games;
+            worker_failed += stats.worker[w].failed;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "Parallel (%d threads): all games in order", threads);
+        check(games == total && log.calls == total && log.out_of_order == 0, name);
+        snprintf(name, sizeof(name), "Parallel (%d threads): stats", threads);
+        check(stats.total.imported == 225 && stats.total.failed == 25 && log.moves == 225 * 5 &&
+              stats.workers == threads && worker_games == total && worker_failed == 25, name);
+    }
+    
+    ParallelLog stop = {0};
+    stop.stop_after = 40;
+    int games = game_import_pgn_file_parallel(path, 2, record_parallel, &stop, NULL);
+    check(games == 40 && stop.calls == 40 && stop.out_of_order == 0, "Parallel: callback stops import");
+    check(game_import_pgn_file_parallel("no_such_file.pgn", 2, record_parallel, &stop, NULL) == -1,
+          "Parallel: missing file");
+    
+    remove(path);
+}
+
 int main() {
     printf("=== PGN/SAN/UCI Parser Test Suite ===\n");
     
@@ -146,6 +444,23 @@ int main() {
     test_san_ambiguity();
     test_uci_input();
     
+    printf("\n--- SAN Decoder ---\n");
+    test_san_capture_and_en_passant();
+    test_san_promotion_capture();
+    test_san_pinned_candidate();
+    test_san_annotations();
+    test_san_rejects();
+    
+    printf("\n--- Variations and Comments ---\n");
+    test_variation_tree();
+    
+    printf("\n--- PGN Export ---\n");
+    test_pgn_export();
+    
+    printf("\n--- Streaming Reader ---\n");
+    test_stream_multi_game();
+    test_parallel_import();
+    
     printf("\n=== Tests Complete ===\n");
-    return 0;
+    return failures ? 1 : 0;
 }
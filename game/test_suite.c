@@ -1,6 +1,9 @@
 #include "gamelogic.h"
 #include "move.h"
-#include "piece.h"
+#include "position_check.h"
+#include "epd_pool.h"
+#include "match_record.h"
+#include "puzzles.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -48,9 +51,9 @@ static void assert_condition(bool condition, const char* message) {
 static void test_initial_setup(void) {
     GameLogic* logic = gamelogic_create();
     assert_condition(logic != NULL, "GameLogic creation");
-    assert_condition(logic->board[6][4] != NULL && logic->board[6][4]->type == PIECE_PAWN, 
+    assert_condition(gamelogic_get_piece(logic, 6, 4) != NULL && gamelogic_get_piece(logic, 6, 4)->type == PIECE_PAWN, 
                     "White pawn should be at e2");
-    assert_condition(logic->board[6][4]->owner == PLAYER_WHITE, "Pawn should be white");
+    assert_condition(gamelogic_get_piece(logic, 6, 4)->owner == PLAYER_WHITE, "Pawn should be white");
     gamelogic_free(logic);
     printf("✅ Test Initial Setup: Passed\n");
 }
@@ -62,12 +65,12 @@ static void test_movement_and_undo(void) {
     gamelogic_perform_move(logic, m);
     move_free(m);
     
-    assert_condition(logic->board[6][4] == NULL, "Pawn should have moved from e2");
-    assert_condition(logic->board[4][4] != NULL && logic->board[4][4]->type == PIECE_PAWN, 
+    assert_condition(gamelogic_get_piece(logic, 6, 4) == NULL, "Pawn should have moved from e2");
+    assert_condition(gamelogic_get_piece(logic, 4, 4) != NULL && gamelogic_get_piece(logic, 4, 4)->type == PIECE_PAWN, 
                     "Pawn should be at e4");
     
     gamelogic_undo_move(logic);
-    assert_condition(logic->board[6][4] != NULL && logic->board[6][4]->type == PIECE_PAWN, 
+    assert_condition(gamelogic_get_piece(logic, 6, 4) != NULL && gamelogic_get_piece(logic, 6, 4)->type == PIECE_PAWN, 
                     "Pawn should be back at e2");
     
     gamelogic_free(logic);
@@ -103,8 +106,8 @@ static void test_en_passant_capture(void) {
     gamelogic_perform_move(logic, m5);
     move_free(m5);
     
-    assert_condition(logic->board[3][3] == NULL, "Pawn should be captured via EP");
-    assert_condition(logic->board[2][3] != NULL && logic->board[2][3]->type == PIECE_PAWN, 
+    assert_condition(gamelogic_get_piece(logic, 3, 3) == NULL, "Pawn should be captured via EP");
+    assert_condition(gamelogic_get_piece(logic, 2, 3) != NULL && gamelogic_get_piece(logic, 2, 3)->type == PIECE_PAWN, 
                     "Pawn should be at d6");
     
     gamelogic_free(logic);
@@ -116,19 +119,12 @@ static void test_promotion(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board and setup
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
-    logic->board[1][0] = piece_create(PIECE_PAWN, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 1, 0, PIECE_PAWN, PLAYER_WHITE);
     // Add Kings
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 0, 4, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     
     Move* m = move_create(1 * 8 + 0, 0 * 8 + 0);
@@ -136,14 +132,15 @@ static void test_promotion(void) {
     gamelogic_perform_move(logic, m);
     move_free(m);
     
-    assert_condition(logic->board[0][0] != NULL && logic->board[0][0]->type == PIECE_QUEEN, 
+    assert_condition(gamelogic_get_piece(logic, 0, 0) != NULL && gamelogic_get_piece(logic, 0, 0)->type == PIECE_QUEEN, 
                     "Pawn should promote to Queen");
     
     gamelogic_undo_move(logic);
-    assert_condition(logic->board[1][0] != NULL && logic->board[1][0]->type == PIECE_PAWN, 
+    assert_condition(gamelogic_get_piece(logic, 1, 0) != NULL && gamelogic_get_piece(logic, 1, 0)->type == PIECE_PAWN, 
                     "Should revert to pawn");
-    assert_condition(logic->board[1][0]->hasMoved == false, 
-                    "Pawn should have hasMoved=false after undoing promotion");
+    assert_condition(gamelogic_get_piece(logic, 1, 0)->owner == PLAYER_WHITE, 
+                    "Restored pawn should keep its color");
+    assert_condition(gamelogic_get_piece(logic, 0, 0) == NULL, "Promotion square should be empty after undo");
     
     gamelogic_free(logic);
     printf("✅ Test Promotion: Passed\n");
@@ -154,21 +151,14 @@ static void test_castling_illegal_through_check(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
     // Setup: White King on e1, Rook on h1, Black Rook on f8 attacking f1
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[7][7] = piece_create(PIECE_ROOK, PLAYER_WHITE);
-    logic->board[0][5] = piece_create(PIECE_ROOK, PLAYER_BLACK); // Attacks f1
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 7, 7, PIECE_ROOK, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 0, 5, PIECE_ROOK, PLAYER_BLACK); // Attacks f1
     // Add Black King to avoid segfault
-    logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 0, 4, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     
     MoveList* moves = movelist_create();
@@ -196,21 +186,14 @@ static void test_castling_illegal_while_in_check(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
     // Setup: White King on e1, Rook on h1, Black Queen checking the King
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[7][7] = piece_create(PIECE_ROOK, PLAYER_WHITE);
-    logic->board[0][4] = piece_create(PIECE_QUEEN, PLAYER_BLACK); // Checking the King
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 7, 7, PIECE_ROOK, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 0, 4, PIECE_QUEEN, PLAYER_BLACK); // Checking the King
     // Add Black King to avoid segfault (place it elsewhere)
-    logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 0, 0, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     
     MoveList* moves = movelist_create();
@@ -236,21 +219,14 @@ static void test_piece_pin_logic(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
     // Setup: White King on e1, White Rook on e3, Black Rook on e8 (pinning the White Rook)
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[5][4] = piece_create(PIECE_ROOK, PLAYER_WHITE); // The pinned piece
-    logic->board[0][4] = piece_create(PIECE_ROOK, PLAYER_BLACK); // The pinner
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 5, 4, PIECE_ROOK, PLAYER_WHITE); // The pinned piece
+    gamelogic_place_piece(logic, 0, 4, PIECE_ROOK, PLAYER_BLACK); // The pinner
     // Add Black King to avoid segfault (place it elsewhere)
-    logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 0, 0, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     
     MoveList* moves = movelist_create();
@@ -283,24 +259,17 @@ static void test_stalemate(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
     // Setup stalemate position: Black King on a1, White Queen on c2, White King on b2
-    logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK);
-    logic->board[1][2] = piece_create(PIECE_QUEEN, PLAYER_WHITE);  // c2
-    logic->board[2][1] = piece_create(PIECE_KING, PLAYER_WHITE);   // b2
+    gamelogic_place_piece(logic, 0, 0, PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 1, 2, PIECE_QUEEN, PLAYER_WHITE);  // c2
+    gamelogic_place_piece(logic, 2, 1, PIECE_KING, PLAYER_WHITE);   // b2
     logic->turn = PLAYER_BLACK;
     
     // Ensure Kings are present for game state update
-    if (!logic->board[0][0]) logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK);
-    if (!logic->board[2][1]) logic->board[2][1] = piece_create(PIECE_KING, PLAYER_WHITE);
+    if (!gamelogic_get_piece(logic, 0, 0)) gamelogic_place_piece(logic, 0, 0, PIECE_KING, PLAYER_BLACK);
+    if (!gamelogic_get_piece(logic, 2, 1)) gamelogic_place_piece(logic, 2, 1, PIECE_KING, PLAYER_WHITE);
     
     gamelogic_update_game_state(logic);
     
@@ -318,22 +287,15 @@ static void test_en_passant_illegal_pin(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            if (logic->board[i][j]) {
-                piece_free(logic->board[i][j]);
-                logic->board[i][j] = NULL;
-            }
-        }
-    }
+    gamelogic_clear_board(logic);
     
     // Setup: King on e1, White Pawn on e5, Black Pawn on d5, Black Rook on e8
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[3][4] = piece_create(PIECE_PAWN, PLAYER_WHITE); // e5
-    logic->board[3][3] = piece_create(PIECE_PAWN, PLAYER_BLACK); // d5
-    logic->board[0][4] = piece_create(PIECE_ROOK, PLAYER_BLACK); // e8 attacking e-file
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 3, 4, PIECE_PAWN, PLAYER_WHITE); // e5
+    gamelogic_place_piece(logic, 3, 3, PIECE_PAWN, PLAYER_BLACK); // d5
+    gamelogic_place_piece(logic, 0, 4, PIECE_ROOK, PLAYER_BLACK); // e8 attacking e-file
     // Add Black King to avoid segfault
-    logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 0, 0, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     logic->enPassantCol = 3; // column d (for en passant)
     
@@ -362,12 +324,10 @@ static void test_promotion_memory_safety(void) {
     GameLogic* logic = gamelogic_create();
     
     // Setup for promotion
-    for (int i = 0; i < 8; i++) for (int j = 0; j < 8; j++) {
-        if (logic->board[i][j]) { piece_free(logic->board[i][j]); logic->board[i][j] = NULL; }
-    }
+    gamelogic_clear_board(logic);
     
     // Pawn at rank 7, about to promote
-    logic->board[1][4] = piece_create(PIECE_PAWN, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 1, 4, PIECE_PAWN, PLAYER_WHITE);
     logic->turn = PLAYER_WHITE;
     
     Move* m = move_create(1 * 8 + 4, 0 * 8 + 4);
@@ -376,9 +336,9 @@ static void test_promotion_memory_safety(void) {
     // Before fix, this might crash or use freed memory if running with sanitizers
     gamelogic_perform_move(logic, m);
     
-    assert_condition(logic->board[0][4] != NULL, "Promoted piece should exist");
-    assert_condition(logic->board[0][4]->type == PIECE_QUEEN, "Should be a Queen");
-    assert_condition(logic->board[0][4]->hasMoved == true, "Promoted piece should have hasMoved=true");
+    assert_condition(gamelogic_get_piece(logic, 0, 4) != NULL, "Promoted piece should exist");
+    assert_condition(gamelogic_get_piece(logic, 0, 4)->type == PIECE_QUEEN, "Should be a Queen");
+    assert_condition(gamelogic_get_piece(logic, 1, 4) == NULL, "Pawn should be gone from e7");
     
     move_free(m);
     gamelogic_free(logic);
@@ -418,14 +378,12 @@ static void test_castling_rook_state_undo(void) {
     GameLogic* logic = gamelogic_create();
     
     // Clear board and setup castling
-    for (int i = 0; i < 8; i++) for (int j = 0; j < 8; j++) {
-        if (logic->board[i][j]) { piece_free(logic->board[i][j]); logic->board[i][j] = NULL; }
-    }
+    gamelogic_clear_board(logic);
     
-    logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE);
-    logic->board[7][7] = piece_create(PIECE_ROOK, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 7, 4, PIECE_KING, PLAYER_WHITE);
+    gamelogic_place_piece(logic, 7, 7, PIECE_ROOK, PLAYER_WHITE);
     // Add Black King to avoid segfault in checkmate logic
-    logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(logic, 0, 4, PIECE_KING, PLAYER_BLACK);
     logic->turn = PLAYER_WHITE;
     
     // 1. Move rook e.g. h1-h2 then back h2-h1 (it has moved now)
@@ -443,21 +401,23 @@ static void test_castling_rook_state_undo(void) {
     Move* filler2 = move_create(0 * 8 + 3, 0 * 8 + 4);
     gamelogic_perform_move(logic, filler2);
     
-    assert_condition(logic->board[7][7]->hasMoved == true, "Rook should have hasMoved=true after moving");
+    assert_condition((logic->castlingRights & 1) == 0, "Kingside right should be gone after the rook moved");
+    assert_condition(!gamelogic_is_move_valid(logic, 7, 4, 7, 6), "Castling should not be generated without the right");
     
     // 2. Try to castle
     Move* castle = move_create(7 * 8 + 4, 7 * 8 + 6);
     castle->isCastling = true;
     gamelogic_perform_move(logic, castle);
     
-    Piece* rookAfterCastle = logic->board[7][5];
+    const Piece* rookAfterCastle = gamelogic_get_piece(logic, 7, 5);
     assert_condition(rookAfterCastle != NULL && rookAfterCastle->type == PIECE_ROOK, "Rook should be at f1");
-    assert_condition(rookAfterCastle->hasMoved == true, "Rook should have moved=true");
+    assert_condition((logic->castlingRights & 3) == 0, "King move should clear both white rights");
     
     // 3. Undo castle
     gamelogic_undo_move(logic);
-    Piece* rookRestored = logic->board[7][7];
-    assert_condition(rookRestored != NULL && rookRestored->hasMoved == true, "Rook should STILL have hasMoved=true after undoing castle");
+    const Piece* rookRestored = gamelogic_get_piece(logic, 7, 7);
+    assert_condition(rookRestored != NULL && rookRestored->type == PIECE_ROOK, "Rook should be back on h1");
+    assert_condition((logic->castlingRights & 1) == 0, "Kingside right should STILL be gone after undoing castle");
     
     move_free(m1);
     move_free(m2);
@@ -476,24 +436,513 @@ static void test_fen_loading_castling_rights(void) {
     const char* fen = "r3k2r/8/8/8/8/8/8/R3K2R w K - 0 1";
     gamelogic_load_fen(logic, fen);
     
-    // White King e1
-    Piece* wk = logic->board[7][4];
-    assert_condition(wk != NULL && wk->hasMoved == false, "White King should not have moved (K in FEN)");
+    assert_condition(logic->castlingRights == 1, "Only white kingside right should be set (K in FEN)");
+    assert_condition(gamelogic_is_move_valid(logic, 7, 4, 7, 6), "White should be able to castle kingside");
+    assert_condition(!gamelogic_is_move_valid(logic, 7, 4, 7, 2), "White should not castle queenside (no Q in FEN)");
+    
+    // Rights whose rook or king is not at home are dropped on load
+    gamelogic_load_fen(logic, "4k2r/8/8/8/8/8/8/4K2R w KQkq - 0 1");
+    assert_condition(logic->castlingRights == (1 | 4), "Rights without a rook at home should be dropped");
+    
+    gamelogic_free(logic);
+    printf("✅ Test FEN Loading Castling Rights: Passed\n");
+}
+
+// Test 14: Fixed Buffer Move Generation
+static void test_move_buffer_generation(void) {
+    GameLogic* logic = gamelogic_create();
+    
+    MoveBuffer buf;
+    int count = gamelogic_generate_moves(logic, PLAYER_WHITE, &buf);
+    assert_condition(count == 20 && buf.count == 20, "Start position should have 20 legal moves in buffer");
+    
+    // Kiwipete: both castles available plus many captures
+    gamelogic_load_fen(logic, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    count = gamelogic_generate_moves(logic, PLAYER_WHITE, &buf);
+    assert_condition(count == 48, "Kiwipete should have 48 legal moves");
+    
+    // Compatibility wrapper must agree move-for-move
+    int legacyCount = 0;
+    Move** legacy = gamelogic_get_all_legal_moves(logic, PLAYER_WHITE, &legacyCount);
+    bool same = (legacyCount == count);
+    for (int i = 0; same && i < count; i++) {
+        char a[8], b[8];
+        packed_move_to_uci(buf.moves[i], a);
+        move_to_uci(legacy[i], b);
+        if (strcmp(a, b) != 0 || legacy[i]->isCastling != (PACKED_TYPE(buf.moves[i]) == MOVE_TYPE_CASTLING)) same = false;
+    }
+    assert_condition(same, "Move** wrapper should match buffer contents");
+    gamelogic_free_moves_array(legacy, legacyCount);
+    
+    // Promotions expand to four entries
+    gamelogic_load_fen(logic, "8/P7/8/8/8/8/8/k6K w - - 0 1");
+    MoveBuffer pawnMoves;
+    gamelogic_generate_piece_moves(logic, 1, 0, &pawnMoves);
+    assert_condition(pawnMoves.count == 4, "Pawn on a7 should have 4 promotion moves");
     
-    // White Rook h1
-    Piece* wrh = logic->board[7][7];
-    assert_condition(wrh != NULL && wrh->hasMoved == false, "White Rook h1 should not have moved (K in FEN)");
+    gamelogic_free(logic);
+    printf("✅ Test Fixed Buffer Move Generation: Passed\n");
+}
+
+// Test 15: Incremental Zobrist Hash
+static void test_incremental_zobrist(void) {
+    GameLogic* logic = gamelogic_create();
+    // Kiwipete after a2a4: castles, captures, en passant (b4xa3) and promotions all reachable
+    gamelogic_load_fen(logic, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/Pp2P3/2N2Q1p/1PPBBPPP/R3K2R b KQkq a3 0 1");
+    uint64_t rootHash = logic->currentHash;
+    assert_condition(rootHash == gamelogic_compute_hash(logic), "Loaded position hash should match full recompute");
+    
+    MoveBuffer buf;
+    int count = gamelogic_generate_moves(logic, logic->turn, &buf);
+    bool consistent = true;
+    bool restored = true;
+    for (int i = 0; i < count; i++) {
+        Move m;
+        move_unpack(&m, buf.moves[i], logic->turn);
+        gamelogic_perform_move(logic, &m);
+        if (logic->currentHash != gamelogic_compute_hash(logic)) consistent = false;
+        
+        // One reply deep so castling rights and ep squares change twice
+        MoveBuffer replies;
+        int replyCount = gamelogic_generate_moves(logic, logic->turn, &replies);
+        for (int j = 0; j < replyCount; j++) {
+            Move r;
+            move_unpack(&r, replies.moves[j], logic->turn);
+            uint64_t before = logic->currentHash;
+            gamelogic_perform_move(logic, &r);
+            if (logic->currentHash != gamelogic_compute_hash(logic)) consistent = false;
+            gamelogic_undo_move(logic);
+            if (logic->currentHash != before) restored = false;
+        }
+        
+        gamelogic_undo_move(logic);
+        if (logic->currentHash != rootHash) restored = false;
+    }
+    assert_condition(consistent, "Incremental hash should equal full recompute after every move");
+    assert_condition(restored, "Undo should restore the previous hash exactly");
     
-    // White Rook a1
-    Piece* wra = logic->board[7][0];
-    assert_condition(wra != NULL && wra->hasMoved == true, "White Rook a1 SHOULD have moved (no Q in FEN)");
+    gamelogic_free(logic);
+    printf("✅ Test Incremental Zobrist Hash: Passed\n");
+}
+
+// Test 16: Automatic Draws (repetition, fifty-move rule, material)
+static void play_uci(GameLogic* logic, const char* uci) {
+    Move* m = move_create((uint8_t)(('8' - uci[1]) * 8 + (uci[0] - 'a')),
+                          (uint8_t)(('8' - uci[3]) * 8 + (uci[2] - 'a')));
+    gamelogic_perform_move(logic, m);
+    move_free(m);
+}
+
+static void test_automatic_draws(void) {
+    GameLogic* logic = gamelogic_create();
     
-    // Black King e8
-    Piece* bk = logic->board[0][4];
-    assert_condition(bk != NULL && bk->hasMoved == true, "Black King SHOULD have moved (no kq in FEN)");
+    // Knights out and back twice: the start position occurs for the third time
+    const char* shuffle[] = {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"};
+    for (int i = 0; i < 7; i++) play_uci(logic, shuffle[i]);
+    assert_condition(!logic->isGameOver, "Second occurrence should not end the game");
+    play_uci(logic, "f6g8");
+    assert_condition(logic->isGameOver && strstr(logic->statusMessage, "repetition") != NULL,
+                     "Third occurrence should be a threefold repetition draw");
+    gamelogic_undo_move(logic);
+    assert_condition(!logic->isGameOver, "Undo should lift the repetition draw");
+    
+    // A pawn move is irreversible: earlier positions no longer count
+    gamelogic_reset(logic);
+    const char* withPawn[] = {"g1f3", "g8f6", "f3g1", "f6g8", "e2e3", "g8f6", "g1f3", "f6g8", "f3g1"};
+    for (int i = 0; i < 9; i++) play_uci(logic, withPawn[i]);
+    assert_condition(logic->halfmoveClock == 4, "Pawn move should reset the halfmove clock");
+    assert_condition(!gamelogic_is_threefold_repetition(logic), "Repetition scan should stop at the pawn move");
+    
+    // Fifty-move rule triggers on the 100th quiet halfmove
+    gamelogic_load_fen(logic, "4k3/8/8/8/8/8/4P3/R3K3 w - - 99 80");
+    play_uci(logic, "a1a2");
+    assert_condition(logic->isGameOver && strstr(logic->statusMessage, "Fifty-move") != NULL,
+                     "100 halfmoves without capture or pawn move should be a draw");
+    
+    // Insufficient material
+    gamelogic_load_fen(logic, "4k3/8/8/8/8/8/8/4KB2 w - - 0 1");
+    assert_condition(gamelogic_is_insufficient_material(logic), "K+B vs K is insufficient");
+    gamelogic_load_fen(logic, "2b1k3/8/8/8/8/8/8/4KB2 w - - 0 1");
+    assert_condition(gamelogic_is_insufficient_material(logic), "Same-colored bishops are insufficient");
+    gamelogic_load_fen(logic, "3bk3/8/8/8/8/8/8/4KB2 w - - 0 1");
+    assert_condition(!gamelogic_is_insufficient_material(logic), "Opposite-colored bishops can still mate");
+    gamelogic_load_fen(logic, "4k3/8/8/8/8/8/8/3NKN2 w - - 0 1");
+    assert_condition(!gamelogic_is_insufficient_material(logic), "Two knights are not an automatic draw");
+    
+    gamelogic_load_fen(logic, "4k3/8/8/8/8/8/3p4/4KB2 w - - 0 1");
+    play_uci(logic, "e1d2");
+    assert_condition(logic->isGameOver && strstr(logic->statusMessage, "Insufficient") != NULL,
+                     "Capturing the last pawn should end the game as a draw");
     
     gamelogic_free(logic);
-    printf("✅ Test FEN Loading Castling Rights: Passed\n");
+    printf("✅ Test Automatic Draws: Passed\n");
+}
+
+// Test 17: Contiguous Move History
+static void test_history_array(void) {
+    GameLogic* logic = gamelogic_create();
+    logic->isSimulation = true; // Repetitions would otherwise end the game
+    uint64_t startHash = logic->currentHash;
+    
+    // Knights out and back 75 times: 300 plies, forcing the array to grow
+    const char* cycle[] = {"g1f3", "g8f6", "f3g1", "f6g8"};
+    for (int i = 0; i < 300; i++) play_uci(logic, cycle[i % 4]);
+    assert_condition(gamelogic_get_move_count(logic) == 300, "History should hold all 300 plies");
+    
+    Move m = gamelogic_get_move_at(logic, 201);
+    assert_condition(m.from_sq == 6 && m.to_sq == 21 && m.mover == PLAYER_BLACK, "Ply 201 should be Black's g8f6");
+    assert_condition(logic->history[202].hash == logic->history[2].hash, "Repeated positions should share a hash");
+    
+    while (gamelogic_get_move_count(logic) > 0) gamelogic_undo_move(logic);
+    assert_condition(logic->currentHash == startHash, "Undoing every ply should restore the start position");
+    
+    gamelogic_free(logic);
+    printf("✅ Test Contiguous Move History: Passed\n");
+}
+
+// Test 18: Batch Position Validation
+static void test_position_check(void) {
+    static const struct { const char* fen; int error; int flags; } cases[] = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", POSITION_OK, 0},
+        {"rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq -", POSITION_OK,
+         POSITION_FLAG_CHECK | POSITION_FLAG_CHECKMATE},
+        {"7k/5Q2/6K1/8/8/8/8/8 b - -", POSITION_OK, POSITION_FLAG_STALEMATE},
+        {"8/8/8/2k5/2pP4/8/B7/4K3 b - d3 0 3", POSITION_OK, POSITION_FLAG_CHECK},
+        {"8/8/8/8/8/8/8/K6k w - - 0 1 extra", POSITION_OK, 0},
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN w KQkq - 0 1", POSITION_ERR_SYNTAX, 0},
+        {"8/8/8/8/8/8/8/K6k x - -", POSITION_ERR_SYNTAX, 0},
+        {"8/8/8/8/8/8/8/K7 w - -", POSITION_ERR_KING_COUNT, 0},
+        {"P6k/8/8/8/8/8/8/K7 w - -", POSITION_ERR_PAWN_RANK, 0},
+        {"4k3/8/8/8/8/8/8/4K3 w K -", POSITION_ERR_CASTLING, 0},
+        {"bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w HFhf - 2 9", POSITION_OK, 0},
+        {"4k3/8/8/8/8/8/8/R3K3 w B -", POSITION_ERR_CASTLING, 0},
+        {"4k3/8/8/8/8/8/8/4K3 w - e6", POSITION_ERR_EN_PASSANT, 0},
+        {"4k3/4R3/8/8/8/8/8/4K3 w - -", POSITION_ERR_OPPONENT_IN_CHECK, 0},
+    };
+    int n = (int)(sizeof(cases) / sizeof(cases[0]));
+    
+    int expectedValid = 0;
+    for (int i = 0; i < n; i++) {
+        PositionCheckResult r = position_check_fen(cases[i].fen, strlen(cases[i].fen));
+        char msg[160];
+        snprintf(msg, sizeof(msg), "Position %d: expected %s, got %s", i,
+                 position_check_error_string((PositionError)cases[i].error),
+                 position_check_error_string((PositionError)r.error));
+        assert_condition(r.error == cases[i].error && r.flags == cases[i].flags, msg);
+        if (cases[i].error == POSITION_OK) expectedValid++;
+    }
+    
+    // Enough copies to split across threads; results must match the single calls
+    int total = n * 200;
+    const char** fens = (const char**)malloc(sizeof(char*) * total);
+    PositionCheckResult* results = (PositionCheckResult*)malloc(sizeof(PositionCheckResult) * total);
+    for (int i = 0; i < total; i++) fens[i] = cases[i % n].fen;
+    int valid = position_check_batch(fens, total, results, 4);
+    assert_condition(valid == expectedValid * 200, "Batch should count every valid position");
+    bool same = true;
+    for (int i = 0; i < total; i++) {
+        if (results[i].error != cases[i % n].error || results[i].flags != cases[i % n].flags) same = false;
+    }
+    assert_condition(same, "Threaded batch should match single-position results");
+    free(fens);
+    free(results);
+    
+    // EPD file: CRLF endings and blank lines
+    const char* path = "test_position_check.epd";
+    FILE* f = fopen(path, "wb");
+    if (f) {
+        fputs("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - id \"start\";\r\n\r\n", f);
+        fputs("8/8/8/8/8/8/8/K7 w - -\n", f);
+        fclose(f);
+        PositionCheckResult* fileResults = NULL;
+        int count = position_check_epd_file(path, &fileResults, 0);
+        assert_condition(count == 2, "EPD file should yield one result per non-empty line");
+        assert_condition(fileResults && fileResults[0].error == POSITION_OK &&
+                         fileResults[1].error == POSITION_ERR_KING_COUNT, "EPD results should follow file order");
+        free(fileResults);
+        remove(path);
+    }
+    assert_condition(position_check_epd_file("does_not_exist.epd", &results, 0) == -1, "Missing file should fail");
+    
+    printf("✅ Test Batch Position Validation: Passed\n");
+}
+
+// Test 19: EPD Position Pool
+static void test_epd_pool(void) {
+    const char* text =
+        "# Opening suite\n"
+        "r1bqkbnr/pppp1ppp/2n5/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - bm Qxf7#; id \"scholar\"; c0 \"Mate; at once\";\r\n"
+        "\n"
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 hmvc 0; fmvn 1; am f6 g5;\n"
+        "8/8/8/8/8/8/8/K7 w - - id \"no black king\";\n"
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - bm Ke2;\n";
+    EpdPool* pool = epd_pool_load_string(text, strlen(text));
+    assert_condition(pool != NULL, "EPD pool should load");
+    if (!pool) return;
+    assert_condition(epd_pool_count(pool) == 3 && epd_pool_skipped(pool) == 1,
+                     "Invalid positions should be skipped, comments and blank lines ignored");
+
+    const EpdEntry* e = epd_pool_entry(pool, 0);
+    assert_condition(strcmp(epd_pool_string(pool, e->fen),
+                            "r1bqkbnr/pppp1ppp/2n5/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 0 1") == 0,
+                     "EPD FEN should gain default clocks");
+    assert_condition(strcmp(epd_pool_string(pool, e->id), "scholar") == 0, "id should lose its quotes");
+    assert_condition(strcmp(epd_pool_string(pool, e->c0), "Mate; at once") == 0, "Quoted ';' should not end an operand");
+    assert_condition(strcmp(epd_pool_string(pool, e->bm), "Qxf7#") == 0 &&
+                     strcmp(epd_pool_string(pool, e->bestUci), "h5f7") == 0, "bm should resolve to UCI");
+
+    e = epd_pool_entry(pool, 1);
+    assert_condition(strcmp(epd_pool_string(pool, e->am), "f6 g5") == 0 && e->bm == 0 && e->bestUci == 0,
+                     "am should be kept and a missing bm read as empty");
+    assert_condition(e->turn == PLAYER_BLACK, "Side to move should be recorded");
+
+    // Hashes match a GameLogic that reached the same position by playing
+    GameLogic* logic = gamelogic_create();
+    gamelogic_reset(logic);
+    Move* m = move_create(52, 36); // e2e4
+    gamelogic_perform_move(logic, m);
+    move_free(m);
+    assert_condition(epd_pool_find(pool, logic->currentHash) == 1, "Lookup by hash should find the played position");
+    assert_condition(epd_pool_find(pool, 12345) == -1, "Unknown hash should not be found");
+    gamelogic_free(logic);
+
+    e = epd_pool_entry(pool, 2);
+    assert_condition(e->bestMove == PACKED_MOVE_NONE && e->bestUci == 0, "Illegal bm should not resolve");
+
+    // Puzzles borrow the pool's strings and keep it alive
+    int before = puzzles_get_count();
+    assert_condition(puzzles_add_from_epd(pool) == 1, "Only entries with a legal bm become puzzles");
+    epd_pool_release(pool);
+    const Puzzle* p = puzzles_get_at(before);
+    assert_condition(p && strcmp(p->title, "scholar") == 0 && strcmp(p->solution_moves[0], "h5f7") == 0 &&
+                     p->solution_length == 1, "EPD puzzle should point into the pool");
+    puzzles_cleanup();
+
+    printf("✅ Test EPD Position Pool: Passed\n");
+}
+
+// Test 20: Chess960 Castling and X-FEN
+static void test_chess960(void) {
+    GameLogic* logic = gamelogic_create();
+    char fen[128];
+    
+    gamelogic_setup_chess960(logic, 0);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(strcmp(fen, "bbqnnrkr/pppppppp/8/8/8/8/PPPPPPPP/BBQNNRKR w KQkq - 0 1") == 0,
+                     "Start position 0 should be BBQNNRKR");
+    gamelogic_setup_chess960(logic, 518);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(strcmp(fen, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == 0 && logic->chess960,
+                     "Start position 518 should be the standard setup, played as Chess960");
+    
+    // Shredder-FEN in, X-FEN out
+    gamelogic_load_fen(logic, "bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w HFhf - 2 9");
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(logic->chess960 && strcmp(fen, "bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w KQkq - 2 9") == 0,
+                     "Shredder rights should come back as KQkq when unambiguous");
+    assert_condition(gamelogic_perft(logic, 3) == 12189, "Chess960 perft(3) should match the reference");
+    
+    // An inner rook needs its file: king b1 castles with g1 although h1 also holds a rook
+    const char* start = "4k3/8/8/8/8/8/8/RK4RR w G - 0 1";
+    gamelogic_load_fen(logic, start);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(strcmp(fen, start) == 0, "Inner castling rook should be written by file");
+    uint64_t hashBefore = logic->currentHash;
+    
+    int count = 0;
+    Move** moves = gamelogic_get_all_legal_moves(logic, PLAYER_WHITE, &count);
+    int castles = 0;
+    for (int i = 0; i < count; i++) {
+        if (moves[i]->isCastling && moves[i]->from_sq == 57 && moves[i]->to_sq == 62) castles++;
+    }
+    gamelogic_free_moves_array(moves, count);
+    assert_condition(castles == 1, "Castling should be generated as king takes rook (b1g1)");
+    
+    gamelogic_load_from_uci_moves(logic, "b1g1", start);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(strcmp(fen, "4k3/8/8/8/8/8/8/R4RKR b - - 1 1") == 0, "King should land on g1 and rook on f1");
+    const char* san = gamelogic_get_san_at(logic, 0);
+    assert_condition(san && strcmp(san, "O-O") == 0, "Chess960 castling SAN should be O-O");
+    gamelogic_undo_move(logic);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(strcmp(fen, start) == 0 && logic->currentHash == hashBefore, "Undo should put king and rook back");
+    
+    gamelogic_free(logic);
+    printf("✅ Test Chess960 Castling and X-FEN: Passed\n");
+}
+
+// Test 21: Undo/Redo and History Navigation
+static void test_history_navigation(void) {
+    const char* line = "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6 b5a4 g8f6 e1g1 f8e7 f1e1 b7b5 a4b3 d7d6 c2c3 e8g8 "
+                       "h2h3 c6a5 b3c2 c7c5 d2d4 d8c7 b1d2 c5d4 c3d4 a5c6 d2b3 a6a5 c1e3 a5a4 b3d2 c8d7 "
+                       "a1c1 c7b7 d2f1 f8c8 f1g3 b5b4 d1d2 a8a5";
+    enum { PLIES = 40 };
+    
+    // Reference positions, ply by ply
+    GameLogic* ref = gamelogic_create();
+    char fens[PLIES + 1][128];
+    uint64_t hashes[PLIES + 1];
+    gamelogic_load_from_uci_moves(ref, line, NULL);
+    assert_condition(gamelogic_get_move_count(ref) == PLIES, "Reference line should load completely");
+    for (int i = PLIES; i >= 0; i--) {
+        gamelogic_generate_fen(ref, fens[i], sizeof(fens[i]));
+        hashes[i] = ref->currentHash;
+        if (i > 0) gamelogic_undo_move(ref);
+    }
+    assert_condition(gamelogic_get_redo_count(ref) == PLIES, "Undone plies should stay on the redo stack");
+    
+    GameLogic* logic = gamelogic_create();
+    gamelogic_load_from_uci_moves(logic, line, NULL);
+    bool ok = true;
+    char fen[128];
+    for (int i = 0; i <= PLIES; i++) {
+        int ply = (i * 17) % (PLIES + 1); // Jump around in both directions
+        gamelogic_jump_to_ply(logic, ply);
+        gamelogic_generate_fen(logic, fen, sizeof(fen));
+        if (logic->historyCount != ply || logic->redoCount != PLIES - ply ||
+            strcmp(fen, fens[ply]) != 0 || logic->currentHash != hashes[ply]) {
+            ok = false;
+        }
+    }
+    assert_condition(ok, "Jumping to any ply should give that ply's position");
+    
+    // Replay stepping: next redoes, seek jumps, prev steps back along the line
+    gamelogic_jump_to_ply(logic, 0);
+    assert_condition(strcmp(logic->history[10].san, "Re1") == 0, "Undone plies should keep their SAN");
+    for (int i = 1; i <= 3; i++) {
+        gamelogic_redo_move(logic);
+        gamelogic_generate_fen(logic, fen, sizeof(fen));
+        ok = ok && logic->historyCount == i && strcmp(fen, fens[i]) == 0 && logic->currentHash == hashes[i];
+    }
+    gamelogic_jump_to_ply(logic, 20);
+    for (int ply = 20; ply >= 8; ply--) {
+        if (ply < 20) gamelogic_jump_to_ply(logic, ply);
+        gamelogic_generate_fen(logic, fen, sizeof(fen));
+        ok = ok && logic->historyCount == ply && logic->redoCount == PLIES - ply &&
+             strcmp(fen, fens[ply]) == 0 && logic->currentHash == hashes[ply];
+    }
+    gamelogic_redo_move(logic);
+    gamelogic_jump_to_ply(logic, PLIES);
+    gamelogic_jump_to_ply(logic, PLIES - 1);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    ok = ok && strcmp(fen, fens[PLIES - 1]) == 0 && logic->currentHash == hashes[PLIES - 1];
+    assert_condition(ok, "Stepping, seeking and stepping back should follow the reference line");
+    
+    gamelogic_jump_to_ply(logic, PLIES);
+    gamelogic_undo_moves(logic, 25);
+    assert_condition(logic->historyCount == PLIES - 25, "Undo N should take back N plies");
+    assert_condition(gamelogic_redo_move(logic), "Redo should be available after undo");
+    gamelogic_redo_moves(logic, 100);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(logic->historyCount == PLIES && strcmp(fen, fens[PLIES]) == 0 && !gamelogic_redo_move(logic),
+                     "Redo N should stop at the end of the line");
+    
+    // Playing the recorded move keeps the line; anything else drops it
+    gamelogic_jump_to_ply(logic, 10);
+    Move next;
+    move_unpack(&next, logic->history[10].move, logic->turn);
+    gamelogic_perform_move(logic, &next);
+    const char* san = gamelogic_get_san_at(logic, 10);
+    assert_condition(logic->redoCount == PLIES - 11 && san && strcmp(san, "Re1") == 0,
+                     "Replaying the next move should keep the redo stack");
+    gamelogic_undo_move(logic);
+    Move* other = move_create(6 * 8 + 3, 5 * 8 + 3); // d2-d3
+    gamelogic_perform_move(logic, other);
+    move_free(other);
+    gamelogic_jump_to_ply(logic, PLIES);
+    assert_condition(logic->redoCount == 0 && logic->historyCount == 11 && !gamelogic_redo_move(logic),
+                     "A different move should drop the redo stack");
+    gamelogic_jump_to_ply(logic, 0);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    assert_condition(strcmp(fen, fens[0]) == 0 && logic->redoCount == 11, "Start position should survive the new line");
+    
+    // Diverging onto a snapshot ply must not leave the old line's position there
+    const char* branch = "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6 b5a4 g8f6 e1g1 f8e7 f1e1 b7b5 a4b3 d7d6 c2c3 c8g4 h2h3";
+    char branch_fens[2][128];
+    gamelogic_load_from_uci_moves(ref, branch, NULL);
+    gamelogic_generate_fen(ref, branch_fens[1], sizeof(branch_fens[1]));
+    gamelogic_undo_move(ref);
+    gamelogic_generate_fen(ref, branch_fens[0], sizeof(branch_fens[0]));
+    gamelogic_load_from_uci_moves(logic, line, NULL);
+    gamelogic_jump_to_ply(logic, 0);
+    gamelogic_jump_to_ply(logic, 16); // Snapshot of ply 16 on the old line
+    gamelogic_undo_move(logic);
+    Move* diverge = move_create(0 * 8 + 2, 4 * 8 + 6); // c8-g4 instead of O-O
+    gamelogic_perform_move(logic, diverge);
+    move_free(diverge);
+    Move* reply = move_create(6 * 8 + 7, 5 * 8 + 7); // h2-h3
+    gamelogic_perform_move(logic, reply);
+    move_free(reply);
+    gamelogic_jump_to_ply(logic, 0);
+    gamelogic_jump_to_ply(logic, 16);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    ok = strcmp(fen, branch_fens[0]) == 0;
+    gamelogic_jump_to_ply(logic, 0);
+    gamelogic_jump_to_ply(logic, 17);
+    gamelogic_generate_fen(logic, fen, sizeof(fen));
+    ok = ok && strcmp(fen, branch_fens[1]) == 0;
+    assert_condition(ok, "A new line diverging at a snapshot ply should not restore the old position");
+    
+    gamelogic_free(logic);
+    gamelogic_free(ref);
+    printf("✅ Test Undo/Redo and History Navigation: Passed\n");
+}
+
+// Test 22: Binary Match Records
+static void test_match_record(void) {
+    MatchHistoryEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.created_at_ms = 1760000000123LL;
+    entry.ended_at_ms = 1760000900456LL;
+    entry.game_mode = 2;
+    entry.clock.enabled = true;
+    entry.clock.initial_ms = 300000;
+    entry.clock.increment_ms = 2000;
+    entry.white.is_ai = true;
+    entry.white.elo = 1850;
+    entry.white.depth = 12;
+    snprintf(entry.black.player_name, sizeof(entry.black.player_name), "Guest");
+    snprintf(entry.result, sizeof(entry.result), "0-1");
+    snprintf(entry.result_reason, sizeof(entry.result_reason), "Checkmate");
+    char moves[] = "f2f3 e7e5 g2g4 d8h4";
+    entry.moves_uci = moves;
+    entry.move_count = 4;
+    int times[] = { 1200, 800, 15034, 650 };
+    entry.think_time_ms = times;
+    entry.think_time_count = 4;
+    
+    size_t size = 0;
+    uint8_t* data = match_record_encode(&entry, &size);
+    assert_condition(data != NULL && size < 100, "Record should encode into a few dozen bytes");
+    
+    MatchHistoryEntry decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    snprintf(decoded.id, sizeof(decoded.id), "m_1");
+    bool ok = data && match_record_decode(data, size, &decoded);
+    assert_condition(ok && strcmp(decoded.id, "m_1") == 0, "Record should decode and keep the id");
+    assert_condition(ok && strcmp(decoded.moves_uci, moves) == 0 && decoded.move_count == 4,
+                     "Moves should come back from their legal-move indices");
+    assert_condition(ok && decoded.think_time_count == 4 && memcmp(decoded.think_time_ms, times, sizeof(times)) == 0,
+                     "Think times should survive delta encoding");
+    assert_condition(ok && decoded.created_at_ms == entry.created_at_ms && decoded.clock.increment_ms == 2000 &&
+                     decoded.white.is_ai && decoded.white.elo == 1850 && !decoded.black.is_ai &&
+                     strcmp(decoded.black.player_name, "Guest") == 0 && strcmp(decoded.result, "0-1") == 0 &&
+                     strcmp(decoded.result_reason, "Checkmate") == 0,
+                     "Header fields should round-trip");
+    assert_condition(ok && strcmp(decoded.final_fen, "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3") == 0,
+                     "Final FEN should be rebuilt by replaying");
+    free(decoded.moves_uci);
+    free(decoded.think_time_ms);
+    
+    memset(&decoded, 0, sizeof(decoded));
+    assert_condition(data && !match_record_decode(data, size - 3, &decoded) && !decoded.moves_uci,
+                     "A truncated record should be rejected");
+    free(data);
+    
+    char bad[] = "e2e4 e2e4";
+    entry.moves_uci = bad;
+    assert_condition(match_record_encode(&entry, &size) == NULL, "A move that does not replay should not encode");
+    printf("✅ Test Binary Match Records: Passed\n");
 }
 
 int main(void) {
@@ -514,6 +963,15 @@ int main(void) {
     test_en_passant_undo_state();
     test_castling_rook_state_undo();
     test_fen_loading_castling_rights();
+    test_move_buffer_generation();
+    test_incremental_zobrist();
+    test_automatic_draws();
+    test_history_array();
+    test_position_check();
+    test_epd_pool();
+    test_chess960();
+    test_history_navigation();
+    test_match_record();
     
     printf("\n--- TEST SUMMARY ---\n");
     printf("✅ Tests Passed: %d\n", tests_passed);
@@ -28,42 +28,62 @@ typedef enum {
     GAME_MODE_TUTORIAL = 4
 } GameMode;
 
-// Piece structure
+// Piece value as read back from a board square (see gamelogic_get_piece).
+// The board itself stores one SQUARE_ENCODE byte per square; whether a king
+// or rook may still castle is tracked by castlingRights, not per piece.
 typedef struct {
     PieceType type;
     Player owner;
-    int hasMoved;
 } Piece;
 
 // Sentinel value for "no piece/promotion"
 #define NO_PIECE ((PieceType)7)
 #define NO_PROMOTION ((PieceType)6)
 
-// Move structure
+// Move structure (8 bytes): the expanded view handed to callers.
+// Undo state lives in the per-ply history record, not here.
 typedef struct {
-    uint8_t from_sq; // 0-63
-    uint8_t to_sq;   // 0-63
-    PieceType movedPieceType;    // The piece that is moving
-    PieceType promotionPiece;
-    PieceType capturedPieceType; // PIECE_KING..PIECE_PAWN or NO_PIECE
-    int isEnPassant;
-    int isCastling;
-    int firstMove;       // To restore hasMoved
-    int rookFirstMove;   // To restore hasMoved for rook
-    Player mover;
-
-    // Undo state
-    uint8_t prevCastlingRights;
-    int8_t prevEnPassantCol;
-    int prevHalfmoveClock;
-    int64_t prevWhiteTimeMs;
-    int64_t prevBlackTimeMs;
+    uint8_t from_sq;           // 0-63
+    uint8_t to_sq;             // 0-63
+    uint8_t movedPieceType;    // PieceType of the piece that is moving
+    uint8_t promotionPiece;    // PieceType or NO_PROMOTION
+    uint8_t capturedPieceType; // PIECE_KING..PIECE_PAWN or NO_PIECE
+    uint8_t isEnPassant;
+    uint8_t isCastling;
+    uint8_t mover;             // Player
 } Move;
 
+// Packed 16-bit move, laid out like Stockfish's Move (src/types.h):
+// bits 0-5 destination, 6-11 origin, 12-13 promotion piece (Q, R, B, N),
+// 14-15 move type. Used by move lists, the game record and analysis PVs.
+typedef uint16_t PackedMove;
+
+#define PACKED_MOVE_NONE ((PackedMove)0)
+
+#define MOVE_TYPE_NORMAL     (0 << 14)
+#define MOVE_TYPE_PROMOTION  (1 << 14)
+#define MOVE_TYPE_EN_PASSANT (2 << 14)
+#define MOVE_TYPE_CASTLING   (3 << 14)
+
+#define PACKED_MOVE(from, to, type) ((PackedMove)((type) | ((from) << 6) | (to)))
+#define PACKED_PROMOTION(from, to, promo) \
+    ((PackedMove)(MOVE_TYPE_PROMOTION | (((promo) - PIECE_QUEEN) << 12) | ((from) << 6) | (to)))
+#define PACKED_FROM(m) (((m) >> 6) & 0x3F)
+#define PACKED_TO(m) ((m) & 0x3F)
+#define PACKED_TYPE(m) ((m) & (3 << 14))
+#define PACKED_PROMOTION_PIECE(m) \
+    (PACKED_TYPE(m) == MOVE_TYPE_PROMOTION ? (PieceType)((((m) >> 12) & 3) + PIECE_QUEEN) : NO_PROMOTION)
+
+// Square encoding shared by the GameLogic mailbox and PositionSnapshot.board
+// (PieceType + 1) << 1 | Player, 0 if empty
+#define SQUARE_EMPTY 0
+#define SQUARE_ENCODE(type, owner) ((uint8_t)((((type) + 1) << 1) | (owner)))
+#define SQUARE_TYPE(val) ((PieceType)(((val) >> 1) - 1))
+#define SQUARE_OWNER(val) ((Player)((val) & 1))
+
 // Position Snapshot
 typedef struct {
-    uint8_t board[64];      // (PieceType + 1) << 1 | Player, 0 if empty
-    uint64_t hasMovedMask;  // Bitmask: bit i is set if square i's piece hasMoved
+    uint8_t board[64];      // SQUARE_ENCODE(type, owner), SQUARE_EMPTY if empty
     Player turn;
     uint8_t castlingRights; // Bits: 1=WK, 2=WQ, 4=BK, 8=BQ
     int8_t enPassantCol;    // -1 if none
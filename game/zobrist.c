@@ -48,14 +48,11 @@ uint64_t zobrist_compute(GameLogic* logic) {
     uint64_t hash = 0;
     
     // Board
-    for (int r = 0; r < 8; r++) {
-        for (int c = 0; c < 8; c++) {
-            Piece* p = logic->board[r][c];
-            if (p) {
-                int sq = r * 8 + c;
-                int piece_idx = p->type * 2 + p->owner;
-                hash ^= piece_keys[sq][piece_idx];
-            }
+    for (int sq = 0; sq < 64; sq++) {
+        uint8_t val = logic->mailbox[sq];
+        if (val != SQUARE_EMPTY) {
+            int piece_idx = SQUARE_TYPE(val) * 2 + SQUARE_OWNER(val);
+            hash ^= piece_keys[sq][piece_idx];
         }
     }
     
@@ -68,28 +65,37 @@ uint64_t zobrist_compute(GameLogic* logic) {
     hash ^= castling_keys[logic->castlingRights & 0xF];
     
     // En Passant
-    // Only include if a pawn can actually capture (as requested for tenfold/threefold repetition)
-    // For now we'll implement the simple version and refine later if needed, 
-    // or just check for presence of opponent pawns.
-    if (logic->enPassantCol != -1) {
-        // Strict check: can ANY pawn of the side to move capture it?
-        bool can_capture = false;
-        int pawnRow = (logic->turn == PLAYER_WHITE) ? 3 : 4;   // e4 or e5
-        
-        // Check neighbors
-        if (logic->enPassantCol > 0) {
-            Piece* p = logic->board[pawnRow][logic->enPassantCol - 1];
-            if (p && p->type == PIECE_PAWN && p->owner == logic->turn) can_capture = true;
-        }
-        if (!can_capture && logic->enPassantCol < 7) {
-            Piece* p = logic->board[pawnRow][logic->enPassantCol + 1];
-            if (p && p->type == PIECE_PAWN && p->owner == logic->turn) can_capture = true;
-        }
-        
-        if (can_capture) {
-            hash ^= ep_keys[logic->enPassantCol];
-        }
-    }
+    hash ^= zobrist_ep_key(logic);
     
     return hash;
 }
+
+uint64_t zobrist_piece_key(PieceType type, Player color, int square) {
+    if (!initialized) zobrist_init();
+    return piece_keys[square][type * 2 + color];
+}
+
+uint64_t zobrist_castling_key(uint8_t castlingRights) {
+    if (!initialized) zobrist_init();
+    return castling_keys[castlingRights & 0xF];
+}
+
+uint64_t zobrist_side_key(void) {
+    if (!initialized) zobrist_init();
+    return side_key;
+}
+
+uint64_t zobrist_ep_key(GameLogic* logic) {
+    if (!initialized) zobrist_init();
+    if (!logic || logic->enPassantCol == -1) return 0;
+    
+    // Only include if a pawn of the side to move can actually capture,
+    // so positions that differ only by a dead ep square repeat correctly
+    int pawnRow = (logic->turn == PLAYER_WHITE) ? 3 : 4;   // e5 for White, e4 for Black
+    uint8_t ownPawn = SQUARE_ENCODE(PIECE_PAWN, logic->turn);
+    int col = logic->enPassantCol;
+    
+    if (col > 0 && logic->mailbox[pawnRow * 8 + col - 1] == ownPawn) return ep_keys[col];
+    if (col < 7 && logic->mailbox[pawnRow * 8 + col + 1] == ownPawn) return ep_keys[col];
+    return 0;
+}
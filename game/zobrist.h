@@ -10,7 +10,22 @@ void zobrist_init(void);
 // Compute hash from scratch for a GameLogic instance
 uint64_t zobrist_compute(GameLogic* logic);
 
-// Update hash incrementally (not strictly needed for snapshots but good for performance)
-// uint64_t zobrist_update_piece(uint64_t current, PieceType type, Player color, int square);
+// Keys for incremental updates (make/undo XOR these in and out)
+uint64_t zobrist_piece_key(PieceType type, Player color, int square);
+uint64_t zobrist_castling_key(uint8_t castlingRights);
+uint64_t zobrist_side_key(void);
+
+// En passant key for the current position, or 0 if the side to move
+// has no pawn that could capture (same rule as zobrist_compute)
+uint64_t zobrist_ep_key(GameLogic* logic);
+
+// Build with -DZOBRIST_DEBUG to verify the incremental hash against a
+// full recompute after every make/undo
+#ifdef ZOBRIST_DEBUG
+#include <assert.h>
+#define ZOBRIST_ASSERT(logic) assert((logic)->currentHash == zobrist_compute(logic))
+#else
+#define ZOBRIST_ASSERT(logic) ((void)0)
+#endif
 
 #endif // ZOBRIST_H
@@ -1,14 +1,12 @@
 #include "ai_analysis.h"
+#include "../game/ai_engine.h"
+#include "../game/move.h"
+#include "../game/gamelogic.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <glib.h>
 
-#ifdef _WIN32
-#include <io.h>
-#include <fcntl.h>
-#endif
-
 /* Standard UCI strings */
 #define UCI_CMD "uci\n"
 #define ISREADY_CMD "isready\n"
@@ -20,6 +18,7 @@ struct _AiAnalysisJob {
     /* Configuration */
     AnalysisConfig config;
     char* start_fen;
+    bool chess960;    /* start_fen needs UCI_Chess960 */
     char** uci_moves; /* Copy of moves */
     int num_moves;
     
@@ -34,10 +33,13 @@ struct _AiAnalysisJob {
     bool cancel_requested;
     bool finished;
     
-    /* Engine Process */
-    GPid engine_pid;
-    gint param_stdin;
-    gint param_stdout;
+    /* Engine: in-process Stockfish, or an external binary */
+    EngineHandle* engine;
+    
+    /* The worker sleeps on its own context: engine output arrives through a
+       watch on it, and ai_analysis_cancel wakes it */
+    GMainContext* context;
+    GQueue lines; /* Engine lines not yet read; worker thread only */
     
     /* Output */
     GameAnalysisResult* result;
@@ -65,77 +67,67 @@ static char* strtok_r_portable(char *str, const char *delim, char **saveptr) {
     return token;
 }
 
-static MoveCompact parse_move_compact(const char* uci_str) {
-    MoveCompact m = {0};
-    if (!uci_str || strlen(uci_str) < 4) return m;
+/* Castling and en passant come through as plain from-to moves: without a
+   board they can't be told apart, and PV comparison only needs the squares */
+static PackedMove parse_move_compact(const char* uci_str) {
+    if (!uci_str || strlen(uci_str) < 4) return PACKED_MOVE_NONE;
     
     int c1 = uci_str[0] - 'a';
     int r1 = 8 - (uci_str[1] - '0');
     int c2 = uci_str[2] - 'a';
     int r2 = 8 - (uci_str[3] - '0');
     
-    m.from_sq = (uint8_t)(r1 * 8 + c1);
-    m.to_sq = (uint8_t)(r2 * 8 + c2);
+    int from = r1 * 8 + c1;
+    int to = r2 * 8 + c2;
     
     if (strlen(uci_str) > 4) {
         char p = uci_str[4];
-        if (p == 'q') m.promo = 1;
-        else if (p == 'r') m.promo = 2;
-        else if (p == 'b') m.promo = 3;
-        else if (p == 'n') m.promo = 4;
+        if (p == 'q') return PACKED_PROMOTION(from, to, PIECE_QUEEN);
+        if (p == 'r') return PACKED_PROMOTION(from, to, PIECE_ROOK);
+        if (p == 'b') return PACKED_PROMOTION(from, to, PIECE_BISHOP);
+        if (p == 'n') return PACKED_PROMOTION(from, to, PIECE_KNIGHT);
     }
-    return m;
+    return PACKED_MOVE(from, to, MOVE_TYPE_NORMAL);
 }
 
 /* --- Engine Communication --- */
 
 static bool spawn_engine(AiAnalysisJob* job) {
-    gchar* argv[] = {(gchar*)job->config.engine_path, NULL};
-    GError* err = NULL;
-    
-    if (!g_spawn_async_with_pipes(NULL, argv, NULL, 
-                                  G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_SEARCH_PATH,
-                                  NULL, NULL, 
-                                  &job->engine_pid, 
-                                  &job->param_stdin, 
-                                  &job->param_stdout, 
-                                  NULL, &err)) {
-        printf("Failed to spawn engine: %s\n", err->message);
-        g_error_free(err);
+    /* The internal engine has its own threads and hash, so a review can run
+       alongside the play engine */
+    if (job->config.engine_path) {
+        job->engine = ai_engine_init_external(job->config.engine_path);
+    } else {
+        job->engine = ai_engine_init_internal();
+    }
+    if (!job->engine) {
+        printf("Failed to start engine: %s\n", job->config.engine_path ? job->config.engine_path : "internal");
         return false;
     }
     return true;
 }
 
 static void send_command(AiAnalysisJob* job, const char* cmd) {
-    if (!job || job->param_stdin == -1) return;
-    char buf[1024];
-    int len = snprintf(buf, sizeof(buf), "%s\n", cmd);
-    
-#ifdef _WIN32
-    _write(job->param_stdin, buf, len);
-#else
-    write(job->param_stdin, buf, len);
-#endif
+    if (!job || !job->engine) return;
+    ai_engine_send_command(job->engine, cmd);
 }
 
-/* Zero-copy style read - reads into a fixed buffer until newline */
-static int read_line_fixed(int fd, char* buffer, int max_len) {
-    int pos = 0;
-    while (pos < max_len - 1) {
-        char c;
-#ifdef _WIN32
-        int n = _read(fd, &c, 1);
-#else
-        int n = read(fd, &c, 1);
-#endif
-        if (n <= 0) return pos; /* EOF or Error */
-        
-        if (c == '\n') break;
-        if (c != '\r') buffer[pos++] = c;
+static void on_engine_line(const char* line, void* user_data) {
+    AiAnalysisJob* job = (AiAnalysisJob*)user_data;
+    g_queue_push_tail(&job->lines, g_strdup(line));
+}
+
+/* Copies the next engine line into buffer. Sleeps until the engine writes
+   one; returns false if the job was cancelled first. */
+static bool read_line(AiAnalysisJob* job, char* buffer, size_t max_len) {
+    while (g_queue_is_empty(&job->lines) && !job->cancel_requested) {
+        g_main_context_iteration(job->context, TRUE);
     }
-    buffer[pos] = '\0';
-    return pos;
+    char* line = (char*)g_queue_pop_head(&job->lines);
+    if (!line) return false;
+    snprintf(buffer, max_len, "%s", line);
+    g_free(line);
+    return true;
 }
 
 /* --- Parser --- */
@@ -233,33 +225,13 @@ static void parse_info_line(char* line, PlyAnalysisRecord* record, int max_multi
 
 /* --- Metrics & Post-Processing --- */
 
-static bool str_equals_move(const char* uci_str, MoveCompact* m) {
-    if (!uci_str || !m) return false;
-    // Reconstruction uci string from compact
-    char buf[6];
-    // int c1 = m->from_sq % 8;
-    // int r1 = 7 - (m->from_sq / 8); 
-    
-    // Inverse:
-    // rank char = '8' - row_idx
-    
-    buf[0] = 'a' + (m->from_sq % 8);
-    buf[1] = '8' - (m->from_sq / 8);
-    buf[2] = 'a' + (m->to_sq % 8);
-    buf[3] = '8' - (m->to_sq / 8);
-    int len = 4;
-    
-    if (m->promo > 0) {
-        char p = 'q';
-        if (m->promo == 2) p = 'r';
-        else if (m->promo == 3) p = 'b';
-        else if (m->promo == 4) p = 'n';
-        buf[4] = p;
-        len = 5;
-    }
-    buf[len] = '\0';
+static bool str_equals_move(const char* uci_str, PackedMove m) {
+    if (!uci_str || m == PACKED_MOVE_NONE) return false;
+    // Reconstruct uci string from the packed move
+    char buf[8];
+    packed_move_to_uci(m, buf);
     
-    return (strncmp(uci_str, buf, len) == 0);
+    return (strncmp(uci_str, buf, strlen(buf)) == 0);
 }
 
 static int score_to_cp(int score, int type) {
@@ -304,8 +276,7 @@ static void calculate_metrics(PlyAnalysisRecord* rec, const char* played_move_uc
         // PV moves stored in compact.
         // We need to compare specific moves.
         if (rec->lines[i].pv_len > 0) {
-            MoveCompact* pv_m = &rec->lines[i].pv_moves[0];
-            if (str_equals_move(played_move_uci, pv_m)) {
+            if (str_equals_move(played_move_uci, rec->lines[i].pv_moves[0])) {
                 played_score = score_to_cp(rec->lines[i].score_value, rec->lines[i].score_type);
                 rank = i + 1;
                 break;
@@ -419,6 +390,7 @@ static void* worker_func(void* data) {
     }
     
     /* Setup Engine */
+    ai_engine_add_watch(job->engine, job->context, on_engine_line, job);
     send_command(job, "uci");
     
     char buffer[4096];
@@ -426,7 +398,7 @@ static void* worker_func(void* data) {
     
     /* Wait for uciok/readyok loop */
     while (!ready && !job->cancel_requested) {
-        if (read_line_fixed(job->param_stdout, buffer, sizeof(buffer)) > 0) {
+        if (read_line(job, buffer, sizeof(buffer))) {
             if (strstr(buffer, "uciok")) {
                 char opt[128];
                 snprintf(opt, sizeof(opt), "setoption name MultiPV value %d", job->config.multipv);
@@ -435,6 +407,7 @@ static void* worker_func(void* data) {
                 send_command(job, opt);
                 snprintf(opt, sizeof(opt), "setoption name Threads value %d", job->config.threads);
                 send_command(job, opt);
+                if (job->chess960) send_command(job, "setoption name UCI_Chess960 value true");
                 send_command(job, "isready");
             }
             if (strstr(buffer, "readyok")) ready = true;
@@ -463,17 +436,18 @@ static void* worker_func(void* data) {
         
         /* Send Position */
         char cmd[8250];
-        if (job->start_fen) {
-             /* Handle non-standard start if needed */
-        } 
-        /* Use startpos assumption for now or fen */
         if (i == 0) move_list_str[0] = '\0'; 
         
         /* NOTE: We must send entire history */
         /* Re-building move_list_str buffer logic carefully: */
         /* Currently strict apppend. */
         
-        snprintf(cmd, sizeof(cmd), "position startpos moves %s", move_list_str);
+        if (job->start_fen) {
+            /* Non-standard start (set-up or Chess960 game) */
+            snprintf(cmd, sizeof(cmd), "position fen %s moves %s", job->start_fen, move_list_str);
+        } else {
+            snprintf(cmd, sizeof(cmd), "position startpos moves %s", move_list_str);
+        }
         send_command(job, cmd);
         
         /* Go */
@@ -487,7 +461,7 @@ static void* worker_func(void* data) {
         rec->side_to_move = (i % 2); /* 0=White, 1=Black */
         
         while (!move_done && !job->cancel_requested) {
-            if (read_line_fixed(job->param_stdout, buffer, sizeof(buffer)) > 0) {
+            if (read_line(job, buffer, sizeof(buffer))) {
                 if (strncmp(buffer, "bestmove", 8) == 0) {
                     move_done = true;
                 } else {
@@ -521,17 +495,10 @@ static void* worker_func(void* data) {
         }
     }
     
-    /* Cleanup Engine */
-    send_command(job, "quit");
-    
-#ifdef _WIN32
-    _close(job->param_stdin);
-    _close(job->param_stdout);
-    g_spawn_close_pid(job->engine_pid);
-#else
-    close(job->param_stdin);
-    close(job->param_stdout);
-#endif
+    /* Cleanup Engine (sends quit, removes the watch) */
+    ai_engine_cleanup(job->engine);
+    job->engine = NULL;
+    g_queue_clear_full(&job->lines, g_free);
     
     job->finished = true;
     if (job->complete_cb && !job->cancel_requested) {
@@ -554,7 +521,16 @@ AiAnalysisJob* ai_analysis_start(const char* start_fen,
 {
     AiAnalysisJob* job = g_new0(AiAnalysisJob, 1);
     job->config = config;
-    if (start_fen) job->start_fen = g_strdup(start_fen);
+    if (start_fen) {
+        job->start_fen = g_strdup(start_fen);
+        /* Let the rules code decide whether the setup is Chess960 */
+        GameLogic* probe = gamelogic_create();
+        if (probe) {
+            gamelogic_load_fen(probe, start_fen);
+            job->chess960 = probe->chess960;
+            gamelogic_free(probe);
+        }
+    }
     
     job->uci_moves = g_new0(char*, num_moves);
     for (int i=0; i<num_moves; i++) job->uci_moves[i] = g_strdup(uci_moves[i]);
@@ -565,6 +541,8 @@ AiAnalysisJob* ai_analysis_start(const char* start_fen,
     job->user_data = user_data;
     
     g_mutex_init(&job->mutex);
+    job->context = g_main_context_new();
+    g_queue_init(&job->lines);
     
     job->worker_thread = g_thread_new("AnalysisWorker", worker_func, job);
     
@@ -576,6 +554,7 @@ void ai_analysis_cancel(AiAnalysisJob* job) {
     g_mutex_lock(&job->mutex);
     job->cancel_requested = true;
     g_mutex_unlock(&job->mutex);
+    g_main_context_wakeup(job->context);
 }
 
 void ai_analysis_free(AiAnalysisJob* job) {
@@ -585,6 +564,7 @@ void ai_analysis_free(AiAnalysisJob* job) {
     
     if (job->worker_thread) g_thread_unref(job->worker_thread);
     g_mutex_clear(&job->mutex);
+    g_main_context_unref(job->context);
     
     g_free(job->start_fen);
     for (int i=0; i<job->num_moves; i++) g_free(job->uci_moves[i]);
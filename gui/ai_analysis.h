@@ -4,15 +4,11 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <glib.h>
+#include "../game/types.h"
 
 /* --- Compact Data Structures (Memory-Light) --- */
 
-/* 3-byte move representation */
-typedef struct MoveCompact {
-    uint8_t from_sq;   /* 0-63 */
-    uint8_t to_sq;     /* 0-63 */
-    uint8_t promo;     /* 0=None, 1=Q, 2=R, 3=B, 4=N */
-} MoveCompact;
+/* PV moves use the engine-wide 16-bit PackedMove (game/types.h) */
 
 /* Single MultiPV Line */
 typedef struct PVLineCompact {
@@ -26,7 +22,7 @@ typedef struct PVLineCompact {
     uint8_t bound;         /* 0=exact, 1=lower, 2=upper */
     
     uint8_t pv_len;
-    MoveCompact pv_moves[16]; /* Fixed limit for PV length to avoid heap churn */
+    PackedMove pv_moves[16]; /* Fixed limit for PV length to avoid heap churn */
 } PVLineCompact;
 
 /* Move Classification Labels */
@@ -103,7 +99,7 @@ typedef struct {
     int move_time_pass2;  /* ms per move, critical positions */
     bool do_pass2;        /* Enable refinement pass */
     
-    const char* engine_path; /* Path to stockfish executable */
+    const char* engine_path; /* External engine binary; NULL for the built-in Stockfish */
 } AnalysisConfig;
 
 /* Callbacks */
@@ -8,13 +8,14 @@
 static bool debug_mode = false;
 static const int64_t overhead_ms = 5000;
 static const int64_t DEFAULT_TIMEOUT_US = 5000000; // 5s baseline
+static const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 
 struct _AiController {
     GameLogic* logic;
     AiDialog* ai_dialog;
 
-    EngineHandle* internal_engine;
-    EngineHandle* custom_engine;
+    // Warm engines, one per (engine, side to move), kept across moves and games
+    EnginePool* engines;
 
     bool ai_thinking;
 
@@ -29,6 +30,10 @@ struct _AiController {
 typedef struct {
     AiController* controller;
     char* fen;
+    // The game line that leads to fen: its start (NULL for the standard
+    // start position) and the moves since, so the engine sees the history
+    char* root_fen;
+    char* moves_uci;
     AiDifficultyParams params;
     
     // NEW: Clock State for UCI
@@ -41,6 +46,7 @@ typedef struct {
     EngineHandle* engine;
     char* nnue_path;
     bool nnue_enabled;
+    bool chess960;   // Position needs UCI_Chess960 (castling sent as king takes rook)
     int target_elo;  // NEW: For non-advanced skill mapping
     AiMoveReadyCallback callback;
     gpointer user_data;
@@ -111,18 +117,23 @@ cleanup:
     return FALSE;
 }
 
+static void ai_task_data_free(AiTaskData* data) {
+    g_free(data->root_fen);
+    g_free(data->moves_uci);
+    if (data->nnue_path) g_free(data->nnue_path);
+    g_free(data);
+}
+
 static gpointer ai_think_thread(gpointer user_data) {
     AiTaskData* data = (AiTaskData*)user_data;
     AiController* controller = data->controller;
 
-    char pos_cmd[512];
-    snprintf(pos_cmd, sizeof(pos_cmd), "position fen %s", data->fen);
-
     if (debug_mode) printf("[AI Thread] Engine Setup: FEN=%s\n", data->fen);
 
     // NEW: Determine mode based on params (target_elo is 0 only in advanced mode)
     bool is_advanced_mode = (data->target_elo == 0);
 
+    // Options go through the engine's cache: unchanged values are not resent
     if (data->nnue_enabled && data->nnue_path) {
         ai_engine_set_option(data->engine, "Use NNUE", "true");
         ai_engine_set_option(data->engine, "EvalFile", data->nnue_path);
@@ -156,7 +167,10 @@ static gpointer ai_think_thread(gpointer user_data) {
         ai_engine_set_skill_level(data->engine, 20);
     }
 
-    ai_engine_send_command(data->engine, pos_cmd);
+    // Set per request: the same engine plays standard and Chess960 games
+    ai_engine_set_option(data->engine, "UCI_Chess960", data->chess960 ? "true" : "false");
+    ai_engine_sync_options(data->engine, 1000);
+    ai_engine_set_position(data->engine, data->root_fen, data->moves_uci);
 
     // NEW: Go command based on mode and clock
     // PRIORITY: Advanced mode > Clock > Non-advanced
@@ -207,26 +221,14 @@ static gpointer ai_think_thread(gpointer user_data) {
                            (long long)current_timeout_us, data->target_elo);
     
     while (true) {
-        // Check if we've been cancelled
+        // Check if we've been cancelled (ai_controller_stop also sends stop,
+        // so the engine's bestmove wakes us)
         if (!controller || controller->destroyed || data->gen != controller->think_gen) {
             ai_engine_send_command(data->engine, "stop");
             if (debug_mode) printf("[AI Thread] Cancelled during timeout wait, sent stop\n");
             break;
         }
         
-        char* response = ai_engine_try_get_response(data->engine);
-        if (response) {
-            if (strstr(response, "bestmove")) {
-                bestmove_str = response;
-                int64_t elapsed_ms = (g_get_monotonic_time() - start_time) / 1000;
-                if (debug_mode) printf("[AI Thread] Received bestmove after %lld ms\n", (long long)elapsed_ms);
-                break;
-            } else {
-                // Not bestmove, discard
-                ai_engine_free_response(response);
-            }
-        }
-        
         // Check timeout
         int64_t elapsed_us = g_get_monotonic_time() - start_time;
         if (elapsed_us > current_timeout_us) {
@@ -238,8 +240,20 @@ static gpointer ai_think_thread(gpointer user_data) {
             break;
         }
         
-        // Sleep for 10ms before next poll
-        g_usleep(10000);
+        // Sleep until the engine writes a line or the timeout is due
+        int wait_ms = (int)((current_timeout_us - elapsed_us) / 1000) + 1;
+        char* response = ai_engine_get_response_timeout(data->engine, wait_ms);
+        if (response) {
+            if (strstr(response, "bestmove")) {
+                bestmove_str = response;
+                int64_t elapsed_ms = (g_get_monotonic_time() - start_time) / 1000;
+                if (debug_mode) printf("[AI Thread] Received bestmove after %lld ms\n", (long long)elapsed_ms);
+                break;
+            } else {
+                // Not bestmove, discard
+                ai_engine_free_response(response);
+            }
+        }
     }
 
     // Stale gen check
@@ -252,8 +266,7 @@ static gpointer ai_think_thread(gpointer user_data) {
         }
         if (bestmove_str) ai_engine_free_response(bestmove_str);
         g_free(data->fen);
-        if (data->nnue_path) g_free(data->nnue_path);
-        g_free(data);
+        ai_task_data_free(data);
         return NULL;
     }
 
@@ -269,8 +282,7 @@ static gpointer ai_think_thread(gpointer user_data) {
         result->gen = data->gen;
 
         ai_engine_free_response(bestmove_str);
-        if (data->nnue_path) g_free(data->nnue_path);
-        g_free(data);
+        ai_task_data_free(data);
 
         g_timeout_add(g_ai_move_delay_ms, apply_ai_move_idle, result);
     } else {
@@ -279,8 +291,7 @@ static gpointer ai_think_thread(gpointer user_data) {
         }
         if (bestmove_str) ai_engine_free_response(bestmove_str);
         g_free(data->fen);
-        if (data->nnue_path) g_free(data->nnue_path);
-        g_free(data);
+        ai_task_data_free(data);
     }
 
     return NULL;
@@ -292,6 +303,7 @@ AiController* ai_controller_new(GameLogic* logic, AiDialog* ai_dialog) {
     AiController* controller = g_new0(AiController, 1);
     controller->logic = logic;
     controller->ai_dialog = ai_dialog;
+    controller->engines = ai_engine_pool_new();
 
     return controller;
 }
@@ -303,12 +315,27 @@ void ai_controller_free(AiController* controller) {
 
     ai_controller_stop(controller);
 
-    if (controller->internal_engine) ai_engine_cleanup(controller->internal_engine);
-    if (controller->custom_engine) ai_engine_cleanup(controller->custom_engine);
+    ai_engine_pool_free(controller->engines);
 
     g_free(controller);
 }
 
+// Moves of the current line as UCI text, or NULL if there are none
+static char* game_moves_uci(GameLogic* logic) {
+    if (logic->historyCount <= 0) return NULL;
+
+    // At most 5 characters and a space per move
+    size_t size = (size_t)logic->historyCount * 6 + 1;
+    char* moves = g_malloc(size);
+    size_t len = 0;
+    for (int i = 0; i < logic->historyCount && len < size; i++) {
+        char uci[8];
+        packed_move_to_uci(logic->history[i].move, uci);
+        len += (size_t)snprintf(moves + len, size - len, "%s%s", i ? " " : "", uci);
+    }
+    return moves;
+}
+
 void ai_controller_request_move(AiController* controller,
                                 bool use_custom,
                                 AiDifficultyParams params,
@@ -323,17 +350,14 @@ void ai_controller_request_move(AiController* controller,
     char* fen = g_malloc(256);
     gamelogic_generate_fen(controller->logic, fen, 256);
 
+    // Each side gets its own engine, so in CvC neither overwrites the other's
+    // strength options or hash between moves
     EngineHandle* engine = NULL;
+    int slot = (int)gamelogic_get_turn(controller->logic);
     if (use_custom) {
-        if (!controller->custom_engine && custom_path) {
-            controller->custom_engine = ai_engine_init_external(custom_path);
-        }
-        engine = controller->custom_engine;
+        if (custom_path) engine = ai_engine_pool_get(controller->engines, custom_path, slot);
     } else {
-        if (!controller->internal_engine) {
-            controller->internal_engine = ai_engine_init_internal();
-        }
-        engine = controller->internal_engine;
+        engine = ai_engine_pool_get(controller->engines, NULL, slot);
     }
 
     if (debug_mode) {
@@ -352,9 +376,19 @@ void ai_controller_request_move(AiController* controller,
     AiTaskData* data = g_new0(AiTaskData, 1);
     data->controller = controller;
     data->fen = fen;
+    data->moves_uci = game_moves_uci(controller->logic);
+    if (data->moves_uci) {
+        // The engine's own start position goes as "startpos"
+        if (strcmp(controller->logic->start_fen, START_FEN) != 0) {
+            data->root_fen = g_strdup(controller->logic->start_fen);
+        }
+    } else {
+        data->root_fen = g_strdup(fen);
+    }
     data->params = params;
     data->engine = engine;
     data->target_elo = params.target_elo; // Copy target ELO
+    data->chess960 = controller->logic && controller->logic->chess960;
     data->callback = callback;
     data->user_data = user_data;
     data->gen = controller->think_gen;
@@ -380,8 +414,7 @@ void ai_controller_stop(AiController* controller) {
 
     controller->think_gen++;
 
-    if (controller->internal_engine) ai_engine_send_command(controller->internal_engine, "stop");
-    if (controller->custom_engine) ai_engine_send_command(controller->custom_engine, "stop");
+    ai_engine_pool_stop_all(controller->engines);
 
     controller->ai_thinking = false;
 }
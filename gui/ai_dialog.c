@@ -98,6 +98,27 @@ static void on_custom_elo_changed(GtkAdjustment* adj, gpointer data) {
     if (dialog->change_cb) dialog->change_cb(dialog->change_cb_data);
 }
 
+// Outcome of loading an EvalFile, set from the engine's thread
+typedef struct {
+    GMutex mutex;
+    GCond cond;
+    int state; // 0: no answer yet, 1: readyok, -1: load error
+} NnueProbe;
+
+static void on_nnue_probe_line(const char* line, void* user_data) {
+    NnueProbe* probe = (NnueProbe*)user_data;
+    int state = 0;
+    // Many SF builds print "failed to open" or similar if eval file is bad
+    if (strstr(line, "error") || strstr(line, "failed") || strstr(line, "No such file")) state = -1;
+    else if (strstr(line, "readyok")) state = 1;
+    if (state == 0) return;
+
+    g_mutex_lock(&probe->mutex);
+    if (probe->state == 0) probe->state = state;
+    g_cond_signal(&probe->cond);
+    g_mutex_unlock(&probe->mutex);
+}
+
 static bool validate_nnue_file(const char* path) {
     if (!path || strlen(path) == 0) return false;
     
@@ -110,35 +131,33 @@ static bool validate_nnue_file(const char* path) {
     EngineHandle* test = ai_engine_init_internal();
     if (!test) return false;
 
+    // The engine's lines come straight to the probe; this thread sleeps
+    // until one of them settles it
+    NnueProbe probe;
+    g_mutex_init(&probe.mutex);
+    g_cond_init(&probe.cond);
+    probe.state = 0;
+    ai_engine_set_line_callback(test, on_nnue_probe_line, &probe);
+
     // SF 17.1 doesn't always report "error" on setoption, but let's try
     ai_engine_send_command(test, "uci");
     ai_engine_set_option(test, "EvalFile", path);
     ai_engine_send_command(test, "isready");
     
-    // Wait a bit for it to load
-    g_usleep(200000); // 200ms
-
-    // Check if it's still alive or if it gave an error
-    char* resp;
-    bool found_ready = false;
-    int tries = 5;
-    while (tries-- > 0) {
-        resp = ai_engine_try_get_response(test);
-        if (resp) {
-            if (strstr(resp, "readyok")) found_ready = true;
-            // Many SF builds print "failed to open" or similar if eval file is bad
-            if (strstr(resp, "error") || strstr(resp, "failed") || strstr(resp, "No such file")) {
-                ai_engine_free_response(resp);
-                ai_engine_cleanup(test);
-                return false;
-            }
-            ai_engine_free_response(resp);
-        }
-        if (found_ready) break;
-        g_usleep(100000);
+    // Check if it's still alive or if it gave an error (up to 700ms)
+    int64_t deadline = g_get_monotonic_time() + 700000;
+    g_mutex_lock(&probe.mutex);
+    while (probe.state == 0) {
+        if (!g_cond_wait_until(&probe.cond, &probe.mutex, deadline)) break;
     }
+    bool found_ready = (probe.state == 1);
+    g_mutex_unlock(&probe.mutex);
 
+    // No callback runs once this returns, so the probe can go
+    ai_engine_set_line_callback(test, NULL, NULL);
     ai_engine_cleanup(test);
+    g_cond_clear(&probe.cond);
+    g_mutex_clear(&probe.mutex);
     return found_ready;
 }
 
@@ -60,6 +60,7 @@ typedef struct {
     bool isAnimating;
     Move* animatingMove;
     Move* animCastlingRookMove; // For castling: secondary move for the rook
+    int animKingTo;       // Square the animated piece lands on (differs from to_sq for Chess960 castling)
     double animProgress;  // 0.0 to 1.0
     guint animTickId;    // Frame tick callback ID
     gint64 animStartTime; // Start time for current animation (microseconds)
@@ -224,7 +225,7 @@ static void logical_to_visual(BoardWidget* board, int logicalR, int logicalC, in
 
 // Check if square is in check
 static bool is_square_in_check(BoardWidget* board, int r, int c) {
-    Piece* piece = board->logic->board[r][c];
+    const Piece* piece = gamelogic_get_piece(board->logic, r, c);
     if (!piece || piece->type != PIECE_KING) return false;
     extern bool gamelogic_is_in_check(GameLogic* logic, Player player);
     return gamelogic_is_in_check(board->logic, piece->owner);
@@ -282,7 +283,7 @@ static void execute_move_with_updates(BoardWidget* board, Move* move) {
         // to ensure the final frame (with piece visible) is drawn.
         int r = move->to_sq / 8;
         int c = move->to_sq % 8;
-        Piece* p = board->logic->board[r][c];
+        const Piece* p = gamelogic_get_piece(board->logic, r, c);
         if (p && p->owner == move->mover) {
              refresh_board(board);
         }
@@ -438,8 +439,8 @@ static void draw_animated_piece(GtkDrawingArea* overlay, cairo_t* cr, int width,
         Move* move = board->animatingMove;
         // Look up piece FRESH from board at start position (before move executes)
         int startRow = move->from_sq / 8, startCol = move->from_sq % 8;
-        int endRow = move->to_sq / 8, endCol = move->to_sq % 8;
-        Piece* piece = board->logic->board[startRow][startCol];
+        int endRow = board->animKingTo / 8, endCol = board->animKingTo % 8;
+        const Piece* piece = gamelogic_get_piece(board->logic, startRow, startCol);
         
         if (piece) {
             int visualStartR, visualStartC, visualEndR, visualEndC;
@@ -462,7 +463,7 @@ static void draw_animated_piece(GtkDrawingArea* overlay, cairo_t* cr, int width,
             draw_piece_graphic(cr, board, piece->type, piece->owner, x, y, pieceSize * 0.85, 1.0);
         } else {
              // Fallback: Check destination if start is empty (Logic Updated case)
-             piece = board->logic->board[endRow][endCol];
+             piece = gamelogic_get_piece(board->logic, endRow, endCol);
              if (piece) {
                 int visualStartR, visualStartC, visualEndR, visualEndC;
                 logical_to_visual(board, startRow, startCol, &visualStartR, &visualStartC);
@@ -490,8 +491,8 @@ static void draw_animated_piece(GtkDrawingArea* overlay, cairo_t* cr, int width,
             Move* rookMove = board->animCastlingRookMove;
             int rRook = rookMove->from_sq / 8, cRook = rookMove->from_sq % 8;
             int rRookEnd = rookMove->to_sq / 8, cRookEnd = rookMove->to_sq % 8;
-            Piece* piece = board->logic->board[rRook][cRook];
-            if (!piece) piece = board->logic->board[rRookEnd][cRookEnd]; // Fallback
+            const Piece* piece = gamelogic_get_piece(board->logic, rRook, cRook);
+            if (!piece) piece = gamelogic_get_piece(board->logic, rRookEnd, cRookEnd); // Fallback
             
             if (piece) {
                 int visualStartR, visualStartC, visualEndR, visualEndC;
@@ -519,7 +520,7 @@ static void draw_animated_piece(GtkDrawingArea* overlay, cairo_t* cr, int width,
     // Draw dragged piece
     if (board->isDragging && board->dragSourceRow >= 0 && board->dragSourceCol >= 0) {
         // Look up piece FRESH from drag source
-        Piece* piece = board->logic->board[board->dragSourceRow][board->dragSourceCol];
+        const Piece* piece = gamelogic_get_piece(board->logic, board->dragSourceRow, board->dragSourceCol);
         if (piece) {
             double x = board->dragX;
             double y = board->dragY;
@@ -549,7 +550,7 @@ static void draw_square(GtkDrawingArea* area, cairo_t* cr, int width, int height
     int r, c;
     visual_to_logical(board, visualR, visualC, &r, &c);
     
-    Piece* piece = board->logic->board[r][c];
+    const Piece* piece = gamelogic_get_piece(board->logic, r, c);
     // For isLight, use visual coordinates (what user sees)
     bool isLight = ((visualR + visualC) % 2 == 0);
     
@@ -560,8 +561,8 @@ static void draw_square(GtkDrawingArea* area, cairo_t* cr, int width, int height
         
         int startR = (int)(move->from_sq / 8);
         int startC = (int)(move->from_sq % 8);
-        int endR = (int)(move->to_sq / 8);
-        int endC = (int)(move->to_sq % 8);
+        int endR = board->animKingTo / 8;
+        int endC = board->animKingTo % 8;
         
         // Hide Piece at START (Standard Mode / Before Logic Update)
         if (r == startR && c == startC) {
@@ -571,7 +572,7 @@ static void draw_square(GtkDrawingArea* area, cairo_t* cr, int width, int height
         // Hide Piece at DESTINATION (Replay Mode / After Logic Update)
         // If legic is updated early, dest has the piece. We must hide it until animation ends.
         if (r == endR && c == endC) {
-             Piece* p = board->logic->board[r][c];
+             const Piece* p = gamelogic_get_piece(board->logic, r, c);
              if (p && p->owner == move->mover) {
                  hidePiece = true;
              }
@@ -590,7 +591,7 @@ static void draw_square(GtkDrawingArea* area, cairo_t* cr, int width, int height
             int rDest = board->animCastlingRookMove->to_sq / 8;
             int cDest = board->animCastlingRookMove->to_sq % 8;
             if (r == rDest && c == cDest) {
-                 Piece* p = board->logic->board[r][c];
+                 const Piece* p = gamelogic_get_piece(board->logic, r, c);
                  if (p && p->type == PIECE_ROOK && p->owner == move->mover) {
                      hidePiece = true;
                  }
@@ -891,7 +892,7 @@ static void on_drag_press(GtkGestureClick* gesture, int n_press, double x, doubl
         int visualC = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), "col"));
         visual_to_logical(board, visualR, visualC, &r, &c);
         
-        Piece* p = board->logic->board[r][c];
+        const Piece* p = gamelogic_get_piece(board->logic, r, c);
         if (p && p->owner != board->logic->turn) {
             return; // Silently ignore clicks on opponent pieces
         }
@@ -915,7 +916,7 @@ static void on_drag_press(GtkGestureClick* gesture, int n_press, double x, doubl
     int r, c;
     visual_to_logical(board, visualR, visualC, &r, &c);
     
-    Piece* piece = board->logic->board[r][c];
+    const Piece* piece = gamelogic_get_piece(board->logic, r, c);
     
     // Prepare drag if piece belongs to current player
     if (piece && piece->owner == board->logic->turn) {
@@ -1120,7 +1121,7 @@ static void on_release(GtkGestureClick* gesture, int n_press, double x, double y
                 // Check if this is a promotion move (pawn reaching last rank)
                 int r1 = moveToMake->from_sq / 8, c1 = moveToMake->from_sq % 8;
                 int r2 = moveToMake->to_sq / 8;
-                Piece* movingPiece = board->logic->board[r1][c1];
+                const Piece* movingPiece = gamelogic_get_piece(board->logic, r1, c1);
                 if (movingPiece && movingPiece->type == PIECE_PAWN && 
                     (r2 == 0 || r2 == 7)) {
                     // Show promotion dialog
@@ -1245,7 +1246,7 @@ static void on_square_clicked(GtkGestureClick* gesture, int n_press, double x, d
         
         if (!isValid) {
             // Check if user clicked on another friendly piece (Switch Selection)
-            Piece* clickedPiece = board->logic->board[logicalR][logicalC];
+            const Piece* clickedPiece = gamelogic_get_piece(board->logic, logicalR, logicalC);
             if (clickedPiece && clickedPiece->owner == board->logic->turn) {
                 // Switch selection!
                 board->selectedRow = logicalR;
@@ -1386,7 +1387,7 @@ static void animate_move(BoardWidget* board, Move* move, void (*on_finished)(voi
     // Check if this is a promotion move (pawn reaching last rank)
     int startRow = move->from_sq / 8, startCol = move->from_sq % 8;
     int endRow = move->to_sq / 8;
-    Piece* movingPiece = board->logic->board[startRow][startCol];
+    const Piece* movingPiece = gamelogic_get_piece(board->logic, startRow, startCol);
     // CRITICAL: Store now - animation will look up piece AFTER it's moved!
     if (movingPiece) move->mover = movingPiece->owner;
     
@@ -1429,32 +1430,16 @@ static void animate_move(BoardWidget* board, Move* move, void (*on_finished)(voi
     board->animatingFromDrag = false; // Regular move animation from square
 
     // Detect Castling and setup Rook animation
-    if (move->isCastling) {
-        // Determine Rook's move based on King's move
-        int r = move->from_sq / 8;
-        int c = move->from_sq % 8; // King start col (e-file, index 4)
-        int destC = move->to_sq % 8;
-        
-        // Ensure we handle both 0-7 and 7-0 row indexing consistently
-        // (Move coords satisfy logic directly)
-        
-        int rRook = r;
-        int cRookStart, cRookEnd;
-        
-        // Determine side based on target column
-        if (destC > c) {
-            // Kingside
-            cRookStart = 7; // h-file
-            cRookEnd = 5;   // f-file
-        } else {
-            // Queenside
-            cRookStart = 0; // a-file
-            cRookEnd = 3;   // d-file
-        }
-        
-        board->animCastlingRookMove = move_create((uint8_t)(rRook * 8 + cRookStart), (uint8_t)(rRook * 8 + cRookEnd));
+    int kingTo, rookFrom, rookTo;
+    if (move->isCastling &&
+        gamelogic_castling_squares(board->logic, move->from_sq, move->to_sq, &kingTo, &rookFrom, &rookTo)) {
+        // Chess960 castling is given as king-takes-rook: animate the king to
+        // where it really lands
+        board->animKingTo = kingTo;
+        board->animCastlingRookMove = move_create((uint8_t)rookFrom, (uint8_t)rookTo);
         board->animCastlingRookMove->mover = move->mover;
     } else {
+        board->animKingTo = move->to_sq;
         board->animCastlingRookMove = NULL;
     }
 
@@ -1562,6 +1547,7 @@ GtkWidget* board_widget_new(GameLogic* logic) {
     board->isAnimating = false;
     board->animatingMove = NULL;
     board->animCastlingRookMove = NULL;
+    board->animKingTo = -1;
     board->animProgress = 0.0;
     board->animTickId = 0;
     board->animStartTime = 0;
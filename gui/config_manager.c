@@ -717,7 +717,48 @@ static bool load_match_by_id(const char* id, MatchHistoryEntry* entry);
 // Forward declaration for pagination cache invalidation
 static void invalidate_cache(void);
 
+// Path of a match file: imported matches live in their own subdirectory
+static void match_file_path(const char* id, const char* ext, char* path, size_t path_size) {
+    determine_base_dir();
+    if (strncmp(id, "import_", 7) == 0) {
+        snprintf(path, path_size, "%.2048s/matches/imported/%.256s%s", g_base_dir, id, ext);
+    } else {
+        snprintf(path, path_size, "%.2048s/matches/%.256s%s", g_base_dir, id, ext);
+    }
+}
+
+static bool file_exists(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f) fclose(f);
+    return f != NULL;
+}
+
+// ID of a saved match file, false if name is not one. A JSON file that
+// already has a binary record beside it is skipped so the match is listed once.
+static bool match_file_id(const char* dir_path, const char* name, char* id, size_t id_size) {
+    const char* ext = strrchr(name, '.');
+    if (!ext) return false;
+    bool is_record = strcmp(ext, MATCH_RECORD_EXT) == 0;
+    if (!is_record && strcmp(ext, MATCH_JSON_EXT) != 0) return false;
+    snprintf(id, id_size, "%.*s", (int)(ext - name), name);
+    if (!is_record) {
+        char record_path[4096];
+        snprintf(record_path, sizeof(record_path), "%.2048s/%.256s%s", dir_path, id, MATCH_RECORD_EXT);
+        if (file_exists(record_path)) return false;
+    }
+    return true;
+}
+
+// Load a match file of either format. The entry's id is kept.
+static bool load_match_file(const char* path, MatchHistoryEntry* entry) {
+    const char* ext = strrchr(path, '.');
+    if (ext && strcmp(ext, MATCH_RECORD_EXT) == 0) return match_record_load(path, entry);
+    return match_record_load_json(path, entry);
+}
+
 static void save_single_match(MatchHistoryEntry* m) {
+    char record_path[4096];
+    match_file_path(m->id, MATCH_RECORD_EXT, record_path, sizeof(record_path));
     determine_base_dir();
     char matches_dir[4096]; 
     
@@ -731,6 +772,15 @@ static void save_single_match(MatchHistoryEntry* m) {
 
     char match_path[4096]; 
     snprintf(match_path, sizeof(match_path), "%.2048s/%.256s.json", matches_dir, m->id);
+
+    // Binary record first; the JSON copy (if any) is then stale
+    if (match_record_save(record_path, m)) {
+        remove(match_path);
+        if (debug_mode) printf("[ConfigManager] Match record saved to: %s\n", record_path);
+        return;
+    }
+    // Moves that do not replay cannot be encoded: keep the game as JSON
+    remove(record_path);
     
     FILE* f = fopen(match_path, "w");
     if (!f) {
@@ -851,13 +901,16 @@ static int compare_metadata(const void* a, const void* b) {
 // Helper to scan a directory and add to index
 static void scan_directory(const char* dir_path) {
     char search_path[4096];
+    char id[64];
     
 #ifdef _WIN32
-    snprintf(search_path, sizeof(search_path), "%.2048s/*.json", dir_path);
+    snprintf(search_path, sizeof(search_path), "%.2048s/*", dir_path);
     WIN32_FIND_DATAA fd;
     HANDLE hFind = FindFirstFileA(search_path, &fd);
     if (hFind != INVALID_HANDLE_VALUE) {
         do {
+            if (!match_file_id(dir_path, fd.cFileName, id, sizeof(id))) continue;
+            
             // Expand capacity if needed
             if (g_match_index.count >= g_match_index.capacity) {
                 g_match_index.capacity *= 2;
@@ -866,11 +919,7 @@ static void scan_directory(const char* dir_path) {
             }
             
             MatchMetadata* meta = &g_match_index.items[g_match_index.count++];
-            
-            // Extract ID
-            snprintf(meta->id, sizeof(meta->id), "%.63s", fd.cFileName);
-            char* ext = strstr(meta->id, ".json");
-            if (ext) *ext = '\0';
+            snprintf(meta->id, sizeof(meta->id), "%s", id);
             
             // Use file modification time as timestamp
             FILETIME ft = fd.ftLastWriteTime;
@@ -887,7 +936,7 @@ static void scan_directory(const char* dir_path) {
     if (d) {
         struct dirent* dir;
         while ((dir = readdir(d)) != NULL) {
-            if (strstr(dir->d_name, ".json")) {
+            if (match_file_id(dir_path, dir->d_name, id, sizeof(id))) {
                 if (g_match_index.count >= g_match_index.capacity) {
                     g_match_index.capacity *= 2;
                     g_match_index.items = realloc(g_match_index.items, 
@@ -895,9 +944,7 @@ static void scan_directory(const char* dir_path) {
                 }
                 
                 MatchMetadata* meta = &g_match_index.items[g_match_index.count++];
-                snprintf(meta->id, sizeof(meta->id), "%s", dir->d_name);
-                char* ext = strstr(meta->id, ".json");
-                if (ext) *ext = '\0';
+                snprintf(meta->id, sizeof(meta->id), "%s", id);
                 
                 // Get timestamp
                 char full_path[4096];
@@ -959,42 +1006,17 @@ void match_history_init(void) {
 }
 
 
-/* Portable strtok_r implementation for Windows/MinGW */
-static char* strtok_r_portable(char *str, const char *delim, char **saveptr) {
-    char *token;
-    if (str == NULL) str = *saveptr;
-    str += strspn(str, delim);
-    if (*str == '\0') {
-        *saveptr = str;
-        return NULL;
-    }
-    token = str;
-    str = str + strcspn(str, delim);
-    if (*str == '\0') {
-        *saveptr = str;
-    } else {
-        *str = '\0';
-        *saveptr = str + 1;
-    }
-    return token;
-}
-
 static void parse_match_file(const char* path) {
-    FILE* f = fopen(path, "r");
-    if (!f) return;
-
     if (g_history_count >= g_history_capacity) {
         g_history_capacity *= 2;
         g_history_list = realloc(g_history_list, g_history_capacity * sizeof(MatchHistoryEntry));
     }
 
-    MatchHistoryEntry* m = &g_history_list[g_history_count++];
+    MatchHistoryEntry* m = &g_history_list[g_history_count];
     memset(m, 0, sizeof(MatchHistoryEntry));
-    // Defaults for back-compat
-    m->clock.enabled = false;
 
     // Force ID from filename to ensure sync (Fix deletion bug)
-    // Extract basename: "C:/.../matches/m_123.json" -> "m_123"
+    // Extract basename: "C:/.../matches/m_123.mrec" -> "m_123"
     const char* base = strrchr(path, '/');
 #ifdef _WIN32
     const char* base_win = strrchr(path, '\\');
@@ -1006,126 +1028,12 @@ static void parse_match_file(const char* path) {
     
     snprintf(m->id, sizeof(m->id), "%.63s", base);
     
-    // Remove .json extension if present
-    char* ext = strstr(m->id, ".json");
+    // Remove the extension
+    char* ext = strrchr(m->id, '.');
     if (ext) *ext = '\0';
 
-    int context = 0; // 0: Root, 1: White, 2: Black, 3: Clock
-    char line[4096];
-    while (fgets(line, sizeof(line), f)) {
-        // Context switching
-        if (strstr(line, "\"white\": {")) context = 1;
-        else if (strstr(line, "\"black\": {")) context = 2;
-        else if (strstr(line, "\"clock\": {")) context = 3;
-        else if (strchr(line, '}') && context != 0) context = 0;
-
-        if (strstr(line, "\"timestamp\"")) {
-            char* p = strchr(line, ':');
-            if (p) m->timestamp = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (strstr(line, "\"created_at_ms\"")) {
-            char* p = strchr(line, ':');
-            if (p) m->created_at_ms = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (strstr(line, "\"started_at_ms\"")) {
-            char* p = strchr(line, ':');
-            if (p) m->started_at_ms = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (strstr(line, "\"ended_at_ms\"")) {
-            char* p = strchr(line, ':');
-            if (p) m->ended_at_ms = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (context == 3) { // Clock context
-            if (strstr(line, "\"initial_ms\"")) {
-                 char* p = strchr(line, ':'); if(p) m->clock.initial_ms = atoi(p+1);
-            }
-            else if (strstr(line, "\"increment_ms\"")) {
-                 char* p = strchr(line, ':'); if(p) m->clock.increment_ms = atoi(p+1);
-            }
-            else if (strstr(line, "\"enabled\"")) {
-                 if (strstr(line, "true")) m->clock.enabled = true;
-                 else if (strstr(line, "false")) m->clock.enabled = false;
-            }
-        }
-        else if (context == 1 || context == 2) { // Player context (White/Black)
-            MatchPlayerConfig* p_cfg = (context == 1) ? &m->white : &m->black;
-            
-            if (strstr(line, "\"is_ai\"")) {
-                if (strstr(line, "true")) p_cfg->is_ai = true;
-                else if (strstr(line, "false")) p_cfg->is_ai = false;
-            }
-            
-            if (strstr(line, "\"elo\"")) {
-                char* p = strstr(line, "\"elo\"");
-                p = strchr(p, ':'); if(p) p_cfg->elo = atoi(p+1);
-            }
-            
-            if (strstr(line, "\"depth\"")) {
-                char* p = strstr(line, "\"depth\"");
-                p = strchr(p, ':'); if(p) p_cfg->depth = atoi(p+1);
-            }
-            
-            if (strstr(line, "\"engine_type\"")) {
-                char* p = strstr(line, "\"engine_type\"");
-                p = strchr(p, ':'); if(p) p_cfg->engine_type = atoi(p+1);
-            }
-            
-            if (strstr(line, "\"engine_path\"")) {
-                extract_json_str(line, "engine_path", p_cfg->engine_path, sizeof(p_cfg->engine_path));
-            }
-            if (strstr(line, "\"player_name\"")) {
-                extract_json_str(line, "player_name", p_cfg->player_name, sizeof(p_cfg->player_name));
-            }
-
-        }
-        // Think time array parsing
-        else if (strstr(line, "\"think_time_ms\"")) {
-            char* start = strchr(line, '[');
-            if (start) {
-                start++;
-                int count = 0;
-                char* walk = start;
-                while (*walk && *walk != ']') {
-                    if (*walk == ',') count++;
-                    walk++;
-                }
-                count += 1;
-                
-                m->think_time_ms = malloc(count * 2 * sizeof(int));
-                m->think_time_count = 0;
-                
-                char* saved_ptr = NULL;
-                char* token = strtok_r_portable(start, ", ]\r\n\"", &saved_ptr);
-                while (token) {
-                     m->think_time_ms[m->think_time_count++] = atoi(token);
-                     token = strtok_r_portable(NULL, ", ]\r\n\"", &saved_ptr);
-                }
-            }
-        }
-        else if (strstr(line, "\"game_mode\"")) {
-            char* p = strchr(line, ':');
-            if (p) m->game_mode = atoi(p + 1);
-        }
-        else if (strstr(line, "\"result_reason\"")) {
-            extract_json_str(line, "result_reason", m->result_reason, sizeof(m->result_reason));
-        }
-        else if (strstr(line, "\"result\"")) {
-            extract_json_str(line, "result", m->result, sizeof(m->result));
-        }
-        else if (strstr(line, "\"move_count\"")) {
-            char* p = strchr(line, ':');
-            if (p) m->move_count = atoi(p + 1);
-        }
-        else if (strstr(line, "\"moves_uci\"")) {
-            char val[4096];
-            extract_json_str(line, "moves_uci", val, sizeof(val));
-            if (m->moves_uci) free(m->moves_uci);
-            m->moves_uci = _strdup(val);
-        }
-        else if (strstr(line, "\"start_fen\"")) extract_json_str(line, "start_fen", m->start_fen, sizeof(m->start_fen));
-        else if (strstr(line, "\"final_fen\"")) extract_json_str(line, "final_fen", m->final_fen, sizeof(m->final_fen));
-    }
-    fclose(f);
+    if (!load_match_file(path, m)) return;
+    g_history_count++;
     // Check this
     if (debug_mode){
         printf("[ConfigManager] Match History loaded from: %s\n", path); 
@@ -1181,13 +1089,15 @@ void match_history_load_all(void) {
     for (int i = 0; i < g_history_count; i++) match_history_free_entry(&g_history_list[i]);
     g_history_count = 0;
 
+    char id[64];
 #ifdef _WIN32
     char search_path[4096];
-    snprintf(search_path, sizeof(search_path), "%.2048s/*.json", matches_dir);
+    snprintf(search_path, sizeof(search_path), "%.2048s/*", matches_dir);
     WIN32_FIND_DATAA fd;
     HANDLE hFind = FindFirstFileA(search_path, &fd);
     if (hFind != INVALID_HANDLE_VALUE) {
         do {
+            if (!match_file_id(matches_dir, fd.cFileName, id, sizeof(id))) continue;
             char full_path[4096];
             snprintf(full_path, sizeof(full_path), "%.2048s/%.1024s", matches_dir, fd.cFileName);
             parse_match_file(full_path);
@@ -1199,7 +1109,7 @@ void match_history_load_all(void) {
     if (d) {
         struct dirent* dir;
         while ((dir = readdir(d)) != NULL) {
-            if (strstr(dir->d_name, ".json")) {
+            if (match_file_id(matches_dir, dir->d_name, id, sizeof(id))) {
                 char full_path[4096];
                 snprintf(full_path, sizeof(full_path), "%s/%s", matches_dir, dir->d_name);
                 parse_match_file(full_path);
@@ -1213,16 +1123,16 @@ void match_history_load_all(void) {
 
 void match_history_delete(const char* id) {
     if (!id) return;
-    determine_base_dir();
     char path[4096];
     
-    // Check if imported
-    if (strncmp(id, "import_", 7) == 0) {
-        snprintf(path, sizeof(path), "%s/matches/imported/%s.json", g_base_dir, id);
-    } else {
-        snprintf(path, sizeof(path), "%s/matches/%s.json", g_base_dir, id);
-    }
-    
+    // Either format may be on disk
+    match_file_path(id, MATCH_JSON_EXT, path, sizeof(path));
+#ifdef _WIN32
+    DeleteFileA(path);
+#else
+    remove(path);
+#endif
+    match_file_path(id, MATCH_RECORD_EXT, path, sizeof(path));
 #ifdef _WIN32
     DeleteFileA(path);
 #else
@@ -1376,113 +1286,13 @@ static void free_cache_page(CachePage* page) {
 
 // Load a single match by ID into an entry
 static bool load_match_by_id(const char* id, MatchHistoryEntry* entry) {
-    determine_base_dir();
     char path[4096];
-    
-    // Check if imported
-    if (strncmp(id, "import_", 7) == 0) {
-        snprintf(path, sizeof(path), "%s/matches/imported/%s.json", g_base_dir, id);
-    } else {
-        snprintf(path, sizeof(path), "%s/matches/%s.json", g_base_dir, id);
-    }
-    
-    FILE* f = fopen(path, "r");
-    if (!f) return false;
+    match_file_path(id, MATCH_RECORD_EXT, path, sizeof(path));
+    if (!file_exists(path)) match_file_path(id, MATCH_JSON_EXT, path, sizeof(path));
     
     memset(entry, 0, sizeof(MatchHistoryEntry));
     snprintf(entry->id, sizeof(entry->id), "%s", id);
-    entry->clock.enabled = false;
-    
-    // Parse the file (reuse existing parse_match_file logic)
-    int context = 0;
-    char line[4096];
-    while (fgets(line, sizeof(line), f)) {
-        if (strstr(line, "\"white\": {")) context = 1;
-        else if (strstr(line, "\"black\": {")) context = 2;
-        else if (strstr(line, "\"clock\": {")) context = 3;
-        else if (strchr(line, '}') && context != 0) context = 0;
-        
-        if (strstr(line, "\"timestamp\"")) {
-            char* p = strchr(line, ':');
-            if (p) entry->timestamp = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (strstr(line, "\"created_at_ms\"")) {
-            char* p = strchr(line, ':');
-            if (p) entry->created_at_ms = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (strstr(line, "\"started_at_ms\"")) {
-            char* p = strchr(line, ':');
-            if (p) entry->started_at_ms = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (strstr(line, "\"ended_at_ms\"")) {
-            char* p = strchr(line, ':');
-            if (p) entry->ended_at_ms = (int64_t)strtoll(p + 1, NULL, 10);
-        }
-        else if (context == 3) {
-            if (strstr(line, "\"initial_ms\"")) {
-                char* p = strchr(line, ':'); if(p) entry->clock.initial_ms = atoi(p+1);
-            }
-            else if (strstr(line, "\"increment_ms\"")) {
-                char* p = strchr(line, ':'); if(p) entry->clock.increment_ms = atoi(p+1);
-            }
-            else if (strstr(line, "\"enabled\"")) {
-                if (strstr(line, "true")) entry->clock.enabled = true;
-                else if (strstr(line, "false")) entry->clock.enabled = false;
-            }
-        }
-        else if (context == 1 || context == 2) {
-            MatchPlayerConfig* p_cfg = (context == 1) ? &entry->white : &entry->black;
-            
-            if (strstr(line, "\"is_ai\"")) {
-                if (strstr(line, "true")) p_cfg->is_ai = true;
-                else if (strstr(line, "false")) p_cfg->is_ai = false;
-            }
-            if (strstr(line, "\"elo\"")) {
-                char* p = strstr(line, "\"elo\"");
-                p = strchr(p, ':'); if(p) p_cfg->elo = atoi(p+1);
-            }
-            if (strstr(line, "\"depth\"")) {
-                char* p = strstr(line, "\"depth\"");
-                p = strchr(p, ':'); if(p) p_cfg->depth = atoi(p+1);
-            }
-            if (strstr(line, "\"engine_type\"")) {
-                char* p = strstr(line, "\"engine_type\"");
-                p = strchr(p, ':'); if(p) p_cfg->engine_type = atoi(p+1);
-            }
-            if (strstr(line, "\"engine_path\"")) {
-                extract_json_str(line, "engine_path", p_cfg->engine_path, sizeof(p_cfg->engine_path));
-            }
-            if (strstr(line, "\"player_name\"")) {
-                extract_json_str(line, "player_name", p_cfg->player_name, sizeof(p_cfg->player_name));
-            }
-
-        }
-        else if (strstr(line, "\"game_mode\"")) {
-            char* p = strchr(line, ':');
-            if (p) entry->game_mode = atoi(p + 1);
-        }
-        else if (strstr(line, "\"result_reason\"")) {
-            extract_json_str(line, "result_reason", entry->result_reason, sizeof(entry->result_reason));
-        }
-        else if (strstr(line, "\"result\"")) {
-            extract_json_str(line, "result", entry->result, sizeof(entry->result));
-        }
-        else if (strstr(line, "\"move_count\"")) {
-            char* p = strchr(line, ':');
-            if (p) entry->move_count = atoi(p + 1);
-        }
-        else if (strstr(line, "\"moves_uci\"")) {
-            char val[4096];
-            extract_json_str(line, "moves_uci", val, sizeof(val));
-            if (entry->moves_uci) free(entry->moves_uci);
-            entry->moves_uci = _strdup(val);
-        }
-        else if (strstr(line, "\"start_fen\"")) extract_json_str(line, "start_fen", entry->start_fen, sizeof(entry->start_fen));
-        else if (strstr(line, "\"final_fen\"")) extract_json_str(line, "final_fen", entry->final_fen, sizeof(entry->final_fen));
-    }
-    
-    fclose(f);
-    return true;
+    return load_match_file(path, entry);
 }
 
 MatchHistoryEntry* match_history_get_page(int page_num, int* out_count) {
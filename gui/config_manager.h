@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "../game/match_record.h" // MatchHistoryEntry
 
 // Define defaults
 #define DEFAULT_THEME "theme_b_emerald"
@@ -108,47 +109,7 @@ void app_themes_delete_theme(const char* id);
 // Save all themes to disk
 void app_themes_save_all(void);
 
-// --- Match History (match_history.json) ---
-
-typedef struct {
-    bool is_ai;
-    int elo;
-    int depth;
-    int engine_type; // 0: Internal, 1: Custom
-    char engine_path[512];
-    char player_name[64]; // NEW: Dedicated player name field
-} MatchPlayerConfig;
-
-typedef struct {
-    char id[64];
-    int64_t timestamp;      // Legacy (keep for now)
-    int64_t created_at_ms;  // Creation time
-    int64_t started_at_ms;  // Actual start time
-    int64_t ended_at_ms;    // Game end time
-
-    int game_mode;
-    
-    // Clock Snapshot used for this match
-    struct {
-        bool enabled;
-        int initial_ms;
-        int increment_ms;
-    } clock;
-
-    MatchPlayerConfig white;
-    MatchPlayerConfig black;
-    char result[16];        // "1-0", "0-1", "1/2-1/2", "*"
-    char result_reason[64]; // "Checkmate", "Stalemate", "Reset", "Incomplete", "Timeout"
-    int move_count;
-    char* moves_uci;        // Allocated string of moves "e2e4 e7e5 g1f3 ..."
-    
-    // Think times per ply (optional)
-    int* think_time_ms;
-    int think_time_count;
-
-    char start_fen[256];
-    char final_fen[256];
-} MatchHistoryEntry;
+// --- Match History (matches/<id>.mrec, older matches <id>.json) ---
 
 // Initialize the match history system
 void match_history_init(void);
@@ -3,6 +3,9 @@
 #include "gui_utils.h"
 #include "import_dialog.h" // NEW
 #include "app_state.h"     // Need AppState to pass to import
+#include "gui_file_dialog.h"
+#include "ai_analysis.h"
+#include "../game/pgn_export.h"
 #include <time.h>
 
 extern AppState* g_app_state; // Access global state for import dialog
@@ -25,6 +28,7 @@ static void on_replay_clicked(GtkButton* btn, gpointer user_data);
 static void on_delete_clicked(GtkButton* btn, gpointer user_data);
 static void on_edit_clicked(GtkButton* btn, gpointer user_data); // NEW
 static void import_btn_clicked(GtkButton* btn, gpointer user_data); // Forward decl
+static void export_btn_clicked(GtkButton* btn, gpointer user_data);
 static void load_next_page(HistoryDialog* dialog);  // NEW: Load next page
 static void on_scroll_edge_reached(GtkScrolledWindow* sw, GtkPositionType pos, gpointer user_data);  // NEW: Scroll handler
 
@@ -376,6 +380,10 @@ HistoryDialog* history_dialog_new(GtkWindow* parent) {
     g_signal_connect(btn_import, "clicked", G_CALLBACK(import_btn_clicked), dialog);
     gtk_box_append(GTK_BOX(header_box), btn_import);
 
+    GtkWidget* btn_export = gtk_button_new_with_label("Export PGN");
+    g_signal_connect(btn_export, "clicked", G_CALLBACK(export_btn_clicked), dialog);
+    gtk_box_append(GTK_BOX(header_box), btn_export);
+
     GtkWidget* scrolled = gtk_scrolled_window_new();
     gtk_widget_set_vexpand(scrolled, TRUE);
     
@@ -446,3 +454,100 @@ static void import_btn_clicked(GtkButton* btn, gpointer user_data) {
         // Note: history_dialog doesn't close here, we let import dialog handle success actions
     }
 }
+
+// --- PGN export ---
+
+static const char* pgn_player_name(const MatchPlayerConfig* p, char* buf, size_t size) {
+    if (p->player_name[0]) return p->player_name;
+    if (!p->is_ai) return "Player";
+    snprintf(buf, size, "AI (Elo %d)", p->elo);
+    return buf;
+}
+
+// Evaluations after each ply, taken from the analysis of the game being replayed.
+// Record i holds the position before ply i, so ply i's eval is record i + 1.
+static PgnEval* pgn_evals_from_analysis(const GameAnalysisResult* analysis, int* count) {
+    *count = 0;
+    if (!analysis || analysis->total_plies < 2) return NULL;
+    PgnEval* evals = calloc((size_t)analysis->total_plies, sizeof(PgnEval));
+    if (!evals) return NULL;
+    for (int i = 0; i + 1 < analysis->total_plies; i++) {
+        const PlyAnalysisRecord* rec = &analysis->plies[i + 1];
+        if (rec->depth_main == 0) continue; // Not analyzed
+        evals[i].valid = true;
+        evals[i].is_mate = rec->is_mate;
+        evals[i].value = rec->is_mate ? rec->mate_dist_white : rec->eval_white;
+    }
+    *count = analysis->total_plies - 1;
+    return evals;
+}
+
+static void on_export_file_selected(const char* path, gpointer user_data) {
+    (void)user_data;
+    if (!path) return;
+
+    PgnWriter* writer = pgn_writer_open(path);
+    if (!writer) {
+        if (debug_mode) printf("[History] Cannot write %s\n", path);
+        return;
+    }
+
+    // Only the match open in the replay can have an analysis result
+    const char* analyzed_id = NULL;
+    PgnEval* evals = NULL;
+    int eval_count = 0;
+    if (g_app_state && g_app_state->replay_match_id && g_app_state->replay_controller) {
+        const GameAnalysisResult* analysis = replay_controller_get_analysis_result(g_app_state->replay_controller);
+        evals = pgn_evals_from_analysis(analysis, &eval_count);
+        if (evals) analyzed_id = g_app_state->replay_match_id;
+    }
+
+    int count = 0;
+    MatchHistoryEntry* list = match_history_get_list(&count);
+    int bad = 0;
+    for (int i = 0; i < count; i++) {
+        const MatchHistoryEntry* m = &list[i];
+        char white[80], black[80], date[16] = "????.??.??";
+        struct tm tm_info;
+        if (m->timestamp > 0 && localtime_s(&tm_info, (const time_t*)&m->timestamp) == 0) {
+            strftime(date, sizeof(date), "%Y.%m.%d", &tm_info);
+        }
+
+        PgnGameRecord game = {0};
+        game.event = m->game_mode == GAME_MODE_PVP ? "Casual Game" : "Engine Game";
+        game.site = "HAL :) Chess";
+        game.date = date;
+        game.white = pgn_player_name(&m->white, white, sizeof(white));
+        game.black = pgn_player_name(&m->black, black, sizeof(black));
+        game.result = m->result;
+        game.start_fen = m->start_fen;
+        game.moves_uci = m->moves_uci;
+        game.clock_enabled = m->clock.enabled;
+        game.clock_initial_ms = m->clock.initial_ms;
+        game.clock_increment_ms = m->clock.increment_ms;
+        game.think_time_ms = m->think_time_ms;
+        game.think_time_count = m->think_time_count;
+        if (analyzed_id && strcmp(analyzed_id, m->id) == 0) {
+            game.evals = evals;
+            game.eval_count = eval_count;
+        }
+        if (!pgn_writer_write_game(writer, &game)) bad++;
+    }
+
+    bool ok = pgn_writer_close(writer);
+    free(evals);
+    if (debug_mode) printf("[History] Exported %d games to %s (%d cut short)%s\n", count, path, bad, ok ? "" : " - write failed");
+}
+
+static void export_btn_clicked(GtkButton* btn, gpointer user_data) {
+    (void)btn;
+    HistoryDialog* dialog = (HistoryDialog*)user_data;
+    const char* patterns[] = { "*.pgn", NULL };
+    gui_file_dialog_save(dialog ? dialog->window : NULL,
+                         "Export Match History",
+                         "match_history.pgn",
+                         "PGN Files",
+                         patterns,
+                         on_export_file_selected,
+                         dialog);
+}
@@ -7,6 +7,8 @@
 #include "types.h"
 #include <time.h>
 
+static bool debug_mode = false;
+
 static GtkWidget* s_dialog = NULL;
 static GtkWidget* s_text_view = NULL;
 static GtkWidget* s_status_label = NULL;
@@ -38,6 +40,54 @@ static void set_status(const char* msg, bool error) {
     }
 }
 
+// Fill a history entry from an imported game (moves_uci aliases the result;
+// match_history_add copies it)
+static void fill_import_entry(MatchHistoryEntry* entry, const GameImportResult* res, const char* id) {
+    memset(entry, 0, sizeof(*entry));
+    snprintf(entry->id, sizeof(entry->id), "%s", id);
+    entry->timestamp = (int64_t)time(NULL);
+    entry->created_at_ms = entry->timestamp * 1000;
+    entry->started_at_ms = entry->created_at_ms;
+    entry->ended_at_ms = entry->created_at_ms;
+    
+    entry->game_mode = GAME_MODE_PVP; // Default assumption for imported human games
+    entry->clock.enabled = false;
+    
+    // Use Parsed Metadata or Defaults
+    snprintf(entry->white.player_name, sizeof(entry->white.player_name), "%s", res->white[0] ? res->white : "White");
+    snprintf(entry->black.player_name, sizeof(entry->black.player_name), "%s", res->black[0] ? res->black : "Black");
+    entry->white.is_ai = false;
+    entry->black.is_ai = false;
+    
+    snprintf(entry->result, sizeof(entry->result), "%s", res->result[0] ? res->result : "*");
+    snprintf(entry->result_reason, sizeof(entry->result_reason), "Imported Game");
+    
+    entry->move_count = res->moves_count;
+    entry->moves_uci = res->loaded_uci;
+    snprintf(entry->start_fen, sizeof(entry->start_fen), "%s", res->start_fen);
+}
+
+// Open the replay for an imported game and close the dialogs in the way
+static void start_imported_replay(const char* id) {
+    // Start Replay via App Action (Handles Controller Init)
+    GVariant* param = g_variant_new_string(id);
+    
+    // Use the global application to activate the action
+    GApplication* app = g_application_get_default();
+    if (app) {
+        g_action_group_activate_action(G_ACTION_GROUP(app), "start-replay", param);
+    }
+    
+    // Close the import dialog
+    if (s_dialog) gtk_window_close(GTK_WINDOW(s_dialog));
+
+    // Close History Dialog if open (so user sees the replay)
+    if (s_state && s_state->gui.history_dialog) {
+         GtkWindow* win = history_dialog_get_window(s_state->gui.history_dialog);
+         if (win) gtk_window_close(win);
+    }
+}
+
 static void do_import(const char* content) {
     if (!content || strlen(content) == 0) {
         set_status("Please enter games text or load a file.", true);
@@ -65,29 +115,14 @@ static void do_import(const char* content) {
     
     GameImportResult res = game_import_from_string(temp_logic, content);
     
-    gamelogic_free(temp_logic);
-    
     if (res.success && res.moves_count > 0) {
         set_status("Game Imported Successfully!", false);
         
         // 1. Construct temporary History Entry
-        MatchHistoryEntry entry = {0};
-        snprintf(entry.id, sizeof(entry.id), "import_%ld", (long)time(NULL));
-        entry.timestamp = (int64_t)time(NULL);
-        entry.created_at_ms = entry.timestamp * 1000;
-        entry.started_at_ms = entry.created_at_ms;
-        entry.ended_at_ms = entry.created_at_ms;
-        
-        entry.game_mode = GAME_MODE_PVP; // Default assumption for imported human games
-        entry.clock.enabled = false;
-        
-        // Use Parsed Metadata or Defaults
-        snprintf(entry.white.player_name, sizeof(entry.white.player_name), "%s", res.white[0] ? res.white : "White");
-        snprintf(entry.black.player_name, sizeof(entry.black.player_name), "%s", res.black[0] ? res.black : "Black");
-        entry.white.is_ai = false;
-        entry.black.is_ai = false;
-        
-        snprintf(entry.result, sizeof(entry.result), "%s", res.result[0] ? res.result : "*");
+        MatchHistoryEntry entry;
+        char id[64];
+        snprintf(id, sizeof(id), "import_%ld", (long)time(NULL));
+        fill_import_entry(&entry, &res, id);
         
         // Auto-detect Result from final position
         if (gamelogic_is_checkmate(temp_logic, temp_logic->turn)) {
@@ -100,38 +135,20 @@ static void do_import(const char* content) {
             snprintf(entry.result, sizeof(entry.result), "1/2-1/2");
         }
         
-        snprintf(entry.result_reason, sizeof(entry.result_reason), "Imported Game");
-        
-        entry.move_count = res.moves_count;
-        entry.moves_uci = res.loaded_uci; // Pointer alias to stack buffer, will be copied by add()
-        snprintf(entry.start_fen, sizeof(entry.start_fen), "%s", res.start_fen);
-        
         // SAVE to History
         match_history_add(&entry);
         
-        // 2. Start Replay via App Action (Handles Controller Init)
-        GVariant* param = g_variant_new_string(entry.id);
-        
-        // Use the global application to activate the action
-        GApplication* app = g_application_get_default();
-        if (app) {
-            g_action_group_activate_action(G_ACTION_GROUP(app), "start-replay", param);
-        }
-        
-        // Close the import dialog
-        if (s_dialog) gtk_window_close(GTK_WINDOW(s_dialog));
-
-        // Close History Dialog if open (so user sees the replay)
-        if (s_state && s_state->gui.history_dialog) {
-             GtkWindow* win = history_dialog_get_window(s_state->gui.history_dialog);
-             if (win) gtk_window_close(win);
-        }
+        // 2. Start Replay
+        start_imported_replay(entry.id);
     } else {
         char err[300];
         snprintf(err, sizeof(err), "Import Failed: %s", res.error_message);
         set_status(res.error_message[0] ? res.error_message : "No valid moves found.", true);
     }
     
+    game_import_result_free(&res);
+    gamelogic_free(temp_logic);
+    
     // Hide Loading Overlay
     if (s_spinner) gtk_spinner_stop(GTK_SPINNER(s_spinner));
     if (s_loading_overlay) gtk_widget_set_visible(s_loading_overlay, FALSE);
@@ -152,22 +169,66 @@ static void on_import_clicked(GtkWidget* btn, gpointer user_data) {
 
 #include "gui_file_dialog.h"
 
+typedef struct {
+    long stamp;
+    char first_id[64];
+} ArchiveImport;
+
+static bool add_archive_game(const GameImportResult* game, int index, void* user_data) {
+    ArchiveImport* ctx = (ArchiveImport*)user_data;
+    if (!game->success || game->moves_count == 0) return true;
+    
+    char id[64];
+    snprintf(id, sizeof(id), "import_%ld_%d", ctx->stamp, index);
+    MatchHistoryEntry entry;
+    fill_import_entry(&entry, game, id);
+    match_history_add(&entry);
+    
+    if (!ctx->first_id[0]) snprintf(ctx->first_id, sizeof(ctx->first_id), "%s", id);
+    return true;
+}
+
+// Files may hold a whole archive: stream every game into match history
+// instead of pasting the text into the editor
 static void on_file_selected(const char* path, gpointer user_data) {
     (void)user_data;
-    if (path) {
-        char* content = NULL;
-        gsize len = 0;
-        if (g_file_get_contents(path, &content, &len, NULL)) {
-            if (s_text_view) {
-                GtkTextBuffer *buf = gtk_text_view_get_buffer(GTK_TEXT_VIEW(s_text_view));
-                gtk_text_buffer_set_text(buf, content, -1);
-                set_status("File loaded. Click Import to process.", false);
-            }
-            g_free(content);
-        } else {
-            set_status("Failed to read file.", true);
+    if (!path) return;
+    
+    set_status("Importing...", false);
+    if (s_loading_overlay) gtk_widget_set_visible(s_loading_overlay, TRUE);
+    if (s_spinner) gtk_spinner_start(GTK_SPINNER(s_spinner));
+    while (g_main_context_iteration(NULL, FALSE));
+    
+    // Games are parsed on every core; add_archive_game still runs here, in file order
+    ArchiveImport ctx = { (long)time(NULL), "" };
+    GameImportParallelStats pstats;
+    int games = game_import_pgn_file_parallel(path, 0, add_archive_game, &ctx, &pstats);
+    const GameImportStats stats = pstats.total;
+    
+    if (debug_mode && games >= 0) {
+        printf("[Import] %d games in %lld ms (%.0f games/s)\n", stats.games, (long long)pstats.elapsed_ms,
+               pstats.games_per_second);
+        for (int w = 0; w < pstats.workers; w++) {
+            const GameImportWorkerStats* ws = &pstats.worker[w];
+            printf("[Import]   worker %d: %d games, %d failed, %.0f games/s\n", w, ws->games, ws->failed,
+                   ws->games_per_second);
         }
     }
+    
+    if (s_spinner) gtk_spinner_stop(GTK_SPINNER(s_spinner));
+    if (s_loading_overlay) gtk_widget_set_visible(s_loading_overlay, FALSE);
+    
+    if (games < 0) {
+        set_status("Failed to read file.", true);
+    } else if (stats.games == 1 && ctx.first_id[0]) {
+        // A single game opens straight into the replay, as a pasted one does
+        start_imported_replay(ctx.first_id);
+    } else {
+        char msg[160];
+        snprintf(msg, sizeof(msg), "Imported %d of %d games into match history.%s", stats.imported, stats.games,
+                 stats.io_error ? " (Stopped early: out of memory)" : "");
+        set_status(msg, stats.imported == 0);
+    }
 }
 
 static void on_load_file_clicked(GtkWidget* btn, gpointer user_data) {
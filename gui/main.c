@@ -313,7 +313,9 @@ static void record_match_history(AppState* state, const char* reason) {
     int plies = gamelogic_get_move_count(state->logic);
     // User requested: games that ended with some result OR matches that went over 5 pairs (10 plies)
     if (state->is_replaying) return;
-    bool is_result = (strcmp(reason, "Checkmate") == 0 || strcmp(reason, "Stalemate") == 0 || strcmp(reason, "Timeout") == 0);
+    bool is_draw = (strcmp(reason, "Stalemate") == 0 || strcmp(reason, "Repetition") == 0 ||
+                    strcmp(reason, "Fifty-move rule") == 0 || strcmp(reason, "Insufficient material") == 0);
+    bool is_result = (strcmp(reason, "Checkmate") == 0 || is_draw || strcmp(reason, "Timeout") == 0);
     // Generalize 10-ply (5 pairs) rule for ALL non-result saves (Reset, Shutdown, etc.)
     if (!is_result && plies < 10) return;
 
@@ -365,7 +367,7 @@ static void record_match_history(AppState* state, const char* reason) {
     } else if (strcmp(reason, "Timeout") == 0) {
         // Flagged player is the loser
         snprintf(entry.result, sizeof(entry.result), "%s", (state->logic->clock.flagged_player == PLAYER_BLACK) ? "1-0" : "0-1");
-    } else if (strcmp(reason, "Stalemate") == 0) {
+    } else if (is_draw) {
         snprintf(entry.result, sizeof(entry.result), "%s", "1/2-1/2");
     } else {
         snprintf(entry.result, sizeof(entry.result), "%s", "*");
@@ -430,6 +432,12 @@ static void update_ui_callback(void) {
                 record_match_history(state, "Checkmate");
             } else if (strstr(status, "Stalemate")) {
                 record_match_history(state, "Stalemate");
+            } else if (strstr(status, "repetition")) {
+                record_match_history(state, "Repetition");
+            } else if (strstr(status, "Fifty-move")) {
+                record_match_history(state, "Fifty-move rule");
+            } else if (strstr(status, "Insufficient")) {
+                record_match_history(state, "Insufficient material");
             } else if (strstr(status, "on time")) {
                 record_match_history(state, "Timeout");
             } else {
@@ -61,13 +61,11 @@ static void sync_board_highlights(ReplayController* self) {
 static void replay_ui_update(ReplayController* self) {
     if (!self || !self->app_state || !self->app_state->gui.info_panel) return;
     
-    // 1. Sync Logic History for correct graveyard calc
-    gamelogic_rebuild_history(self->logic, self->moves, self->current_ply);
-    
-    // 2. Refresh Status Checkmate/Stalemate
+    // 1. Refresh Status Checkmate/Stalemate. GameLogic's history is the
+    // replayed line itself, so the graveyard reads it as it stands.
     gamelogic_update_game_state(self->logic);
     
-    // 3. Update UI
+    // 2. Update UI
     info_panel_update_replay_status(self->app_state->gui.info_panel, self->current_ply, self->total_moves);
     info_panel_refresh_graveyard(self->app_state->gui.info_panel);
     info_panel_refresh_graveyard(self->app_state->gui.info_panel);
@@ -121,8 +119,8 @@ static void refresh_clock_display(ReplayController* self) {
             
             // Active state
             Player turn_now = (Player)-1;
-            if (self->current_ply < self->total_moves && self->snapshots) {
-                turn_now = self->snapshots[self->current_ply].turn;
+            if (self->current_ply < self->total_moves && self->moves) {
+                turn_now = (Player)self->moves[self->current_ply]->mover;
             }
             
             bool playing = self->is_playing && (turn_now != (Player)-1);
@@ -164,8 +162,8 @@ static gboolean replay_tick_callback(gpointer user_data) {
 
     // Determine whose turn it is
     Player turn_now = (Player)-1;
-    if (self->current_ply < self->total_moves && self->snapshots) {
-        turn_now = self->snapshots[self->current_ply].turn;
+    if (self->current_ply < self->total_moves && self->moves) {
+        turn_now = (Player)self->moves[self->current_ply]->mover;
     }
     
     if (turn_now == (Player)-1) return G_SOURCE_CONTINUE;
@@ -221,11 +219,6 @@ void replay_controller_free(ReplayController* self) {
         }
         g_free(self->moves);
     }
-    // Free snapshots
-    if (self->snapshots) {
-        g_free(self->snapshots);
-    }
-    
     g_free(self->full_uci_history);
     
     if (self->think_times) {
@@ -295,14 +288,6 @@ void replay_controller_load_match(ReplayController* self, const char* moves_uci,
     self->clock_initial_ms = initial_ms;
     self->clock_increment_ms = increment_ms;
     
-    // Clear existing snapshots
-    if (self->snapshots) {
-        g_free(self->snapshots);
-        self->snapshots = NULL;
-        self->snapshot_count = 0;
-        self->snapshot_capacity = 0;
-    }
-
     // We no longer store full SAN history as a string from source
     g_free(self->full_uci_history);
     self->full_uci_history = NULL;
@@ -335,6 +320,8 @@ void replay_controller_load_match(ReplayController* self, const char* moves_uci,
     } else {
         // No moves to load
         if (debug_mode) printf("[ReplayController] No UCI moves provided, match loaded empty.\n");
+        if (start_fen && start_fen[0] != '\0') gamelogic_load_fen(self->logic, start_fen);
+        else gamelogic_reset(self->logic);
     }
     
     // 2. Extract Moves & Snapshots
@@ -407,29 +394,15 @@ void replay_controller_load_match(ReplayController* self, const char* moves_uci,
         }
     }
 
-    // Allocate snapshots (ply 0 to ply N)
-    self->snapshot_count = self->total_moves + 1;
-    self->snapshot_capacity = self->snapshot_count;
-    self->snapshots = g_new0(PositionSnapshot, self->snapshot_count);
-
-    // Re-run to capture snapshots
-    if (start_fen && start_fen[0] != '\0') gamelogic_load_fen(self->logic, start_fen);
-    else gamelogic_reset(self->logic);
-
-    gamelogic_create_snapshot(self->logic, &self->snapshots[0]);
-    for (int i = 0; i < self->total_moves; i++) {
-        gamelogic_perform_move(self->logic, self->moves[i]);
-        gamelogic_create_snapshot(self->logic, &self->snapshots[i+1]);
-    }
-    
-    // Reset board to start position for Replay
-    gamelogic_restore_snapshot(self->logic, &self->snapshots[0]);
+    // Rewind to the start. The whole line stays on GameLogic's redo stack:
+    // stepping and seeking redo, undo or jump along it and never replace it.
+    gamelogic_jump_to_ply(self->logic, 0);
     self->current_ply = 0;
 
     if (debug_mode) {
         printf("[ReplayController] Match Loaded:\n");
         printf("  Total Moves: %d\n", self->total_moves);
-        printf("  Snapshots: %d\n", self->snapshot_count);
+        printf("  Redo Stack: %d\n", gamelogic_get_redo_count(self->logic));
         printf("  Move 0 (Start) FEN: %s\n", self->logic->start_fen);
         // Debug stack pointer indirectly via move count or internal inspection
         int current_count = gamelogic_get_move_count(self->logic);
@@ -472,56 +445,36 @@ void replay_controller_load_match(ReplayController* self, const char* moves_uci,
         if (self->app_state->gui.right_side_panel) {
              right_side_panel_clear_history(self->app_state->gui.right_side_panel);
              
-             // Use a temp logic to replay and generate accurate SAN context (checks/mates/disambiguation)
-             GameLogic* temp_logic = gamelogic_create();
-             if (temp_logic) {
-                 if (start_fen && start_fen[0] != '\0') gamelogic_load_fen(temp_logic, start_fen);
-                 else gamelogic_reset(temp_logic);
-                 
-                 temp_logic->isSimulation = true; // fast mode
+             // Loading the line rendered every ply's SAN, and the undone plies
+             // keep theirs in place on the redo stack, so the list is only copied here
+             Player p = self->logic->turn;
+             int m_num = 1;
+
+             // Accumulate UCI string for export/debug if needed
+             GString* full_uci = g_string_new("");
+
+             for (int i = 0; i < self->total_moves; i++) {
+                 Move* m = self->moves[i];
+
+                 char uci[16];
+                 move_to_uci(m, uci); // Keep UCI for the full_uci_history string
+
+                 const char* san = self->logic->history[i].san;
+                 right_side_panel_add_move_notation(self->app_state->gui.right_side_panel, san[0] ? san : uci,
+                                                    (PieceType)m->movedPieceType, m_num, p);
                  
-                 Player p = temp_logic->turn;
-                 int m_num = 1;
-
-                 // Accumulate UCI string for export/debug if needed
-                 GString* full_uci = g_string_new("");
-
-                 for (int i = 0; i < self->total_moves; i++) {
-                     Move* m = self->moves[i];
-                     
-                     // Get piece type from current board state before move
-                     int r = m->from_sq / 8;
-                     int c = m->from_sq % 8;
-                     PieceType p_type = NO_PIECE;
-                     if (temp_logic->board[r][c] != NULL) {
-                         p_type = temp_logic->board[r][c]->type;
-                     }
-
-                     char uci[16];
-                     move_to_uci(m, uci); // Keep UCI for the full_uci_history string
-                     
-                     // Advance temp logic FIRST, then get SAN (which works on the updated state)
-                     gamelogic_perform_move(temp_logic, m);
-
-                     char san[16];
-                     gamelogic_get_move_san(temp_logic, m, san, sizeof(san));
-
-                     right_side_panel_add_move_notation(self->app_state->gui.right_side_panel, san, p_type, m_num, p);
-                     
-                     if (full_uci->len > 0) g_string_append_c(full_uci, ' ');
-                     g_string_append(full_uci, uci);
-                     
-                     if (p == PLAYER_BLACK) m_num++;
-                     p = (p == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
-                 }
-                 gamelogic_free(temp_logic);
+                 if (full_uci->len > 0) g_string_append_c(full_uci, ' ');
+                 g_string_append(full_uci, uci);
                  
-                 // Store reconstructed UCI history
-                 self->full_uci_history = g_string_free(full_uci, FALSE);
-
-                 // Ensure we scroll to top after bulk load as requested by user
-                 right_side_panel_scroll_to_top(self->app_state->gui.right_side_panel);
+                 if (p == PLAYER_BLACK) m_num++;
+                 p = (p == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
              }
+             
+             // Store reconstructed UCI history
+             self->full_uci_history = g_string_free(full_uci, FALSE);
+
+             // Ensure we scroll to top after bulk load as requested by user
+             right_side_panel_scroll_to_top(self->app_state->gui.right_side_panel);
         }
     }
     
@@ -558,7 +511,7 @@ void replay_controller_load_match(ReplayController* self, const char* moves_uci,
              // Clamp negative duration if corrupt?
              if (duration < 0) duration = 0;
              
-             Player mover = self->snapshots[i].turn; // Current turn at ply i
+             Player mover = (Player)self->moves[i]->mover; // Current turn at ply i
              
              if (mover == PLAYER_WHITE) {
                  if (self->clock_initial_ms <= 0) {
@@ -609,11 +562,7 @@ void replay_controller_set_result(ReplayController* self, const char* result, co
 void replay_controller_start(ReplayController* self) {
     if (!self) return;
     self->current_ply = 0;
-    if (self->snapshots) {
-        gamelogic_restore_snapshot(self->logic, &self->snapshots[0]);
-    } else {
-        gamelogic_reset(self->logic);
-    }
+    gamelogic_jump_to_ply(self->logic, 0);
     if (self->app_state) {
          board_widget_reset_selection(self->app_state->gui.board);
          board_widget_refresh(self->app_state->gui.board);
@@ -799,11 +748,11 @@ void replay_controller_next(ReplayController* self, bool from_timer) {
         board_widget_animate_move(self->app_state->gui.board, next_move);
     }
     
-    // Note: gamelogic_perform_move is NOW called to ensure logic state (turn, checkmate status) updates
-    // The animation system will call execute_move_with_updates when animation completes, 
-    // BUT we need immediate logic state update for the UI status to be correct.
+    // The logic is updated now, not when the animation completes, so the UI
+    // status is right at once. Redo plays the recorded ply with its undo
+    // information and keeps the rest of the line.
     // Double execution is prevented because Replay Controller manages the logic, not the Board Widget callbacks in this mode.
-    gamelogic_perform_move(self->logic, next_move);
+    gamelogic_redo_move(self->logic);
     
     self->current_ply++;
     
@@ -828,11 +777,7 @@ void replay_controller_prev(ReplayController* self, bool from_timer) {
     if (self->current_ply <= 0) return;
     
     self->current_ply--;
-    if (self->snapshots) {
-        gamelogic_restore_snapshot(self->logic, &self->snapshots[self->current_ply]);
-    } else {
-        gamelogic_undo_move(self->logic);
-    }
+    gamelogic_jump_to_ply(self->logic, self->current_ply);
 
     if (self->app_state) {
         board_widget_refresh(self->app_state->gui.board);
@@ -844,7 +789,7 @@ void replay_controller_prev(ReplayController* self, bool from_timer) {
 void replay_controller_seek(ReplayController* self, int ply) {
     if (!self) return;
     if (ply < 0) ply = 0;
-    if (ply >= self->snapshot_count) ply = self->snapshot_count - 1;
+    if (ply > self->total_moves) ply = self->total_moves;
     
     // Pause if jumping to Start or End boundaries
     if (ply == 0 || ply >= self->total_moves) {
@@ -860,24 +805,8 @@ void replay_controller_seek(ReplayController* self, int ply) {
         // Highlights synced in replay_ui_update
     }
 
-    if (self->snapshots) {
-        gamelogic_restore_snapshot(self->logic, &self->snapshots[ply]);
-        self->current_ply = ply;
-    } else {
-        // Fallback for missing snapshots (reset and walk)
-        if (ply < self->current_ply) {
-            while (self->current_ply > ply) {
-                gamelogic_undo_move(self->logic);
-                self->current_ply--;
-            }
-        } else {
-            while (self->current_ply < ply) {
-                Move* next_move = self->moves[self->current_ply];
-                gamelogic_perform_move(self->logic, next_move);
-                self->current_ply++;
-            }
-        }
-    }
+    gamelogic_jump_to_ply(self->logic, ply);
+    self->current_ply = ply;
     
     if (self->app_state) {
         board_widget_refresh(self->app_state->gui.board);
@@ -898,16 +827,10 @@ bool replay_controller_start_from_here(ReplayController* self, GameMode mode, Pl
     // 1. Stop Replay
     replay_controller_pause(self);
     
-    // 2. Truncate/Rebuild History
-    // The gamelogic currently holds the state at `current_ply`.
-    // We need to ensure the undo stack matches exactly moves[0..current_ply-1].
-    // `gamelogic_rebuild_history` does exactly this: clears stack and pushes the provided array.
-    if (self->moves && self->current_ply > 0) {
-        gamelogic_rebuild_history(self->logic, self->moves, self->current_ply);
-    } else {
-        // If at start (ply 0), clear history
-        gamelogic_rebuild_history(self->logic, NULL, 0);
-    }
+    // 2. Truncate History
+    // The gamelogic holds the state at `current_ply` with moves[0..current_ply-1]
+    // already played; only the rest of the replayed line has to go.
+    gamelogic_drop_redo(self->logic);
     
     // 3. Sync Clock
     if (self->clock_enabled && self->precalc_white_time && self->precalc_black_time) {
@@ -1047,31 +970,22 @@ bool replay_controller_start_from_here(ReplayController* self, GameMode mode, Pl
         // Truncate the visual history in the right panel to match current ply
         right_side_panel_clear_history(self->app_state->gui.right_side_panel);
         
-        // Re-populate from logic history
-        GameLogic* temp = gamelogic_create(); 
-        if (temp) {
-             if (self->logic->start_fen[0]) gamelogic_load_fen(temp, self->logic->start_fen);
-             else gamelogic_reset(temp);
-             
-             Player p = temp->turn;
-             int m_num = temp->fullmoveNumber;
-
-             for (int i = 0; i < self->current_ply; i++) {
-                 Move* m = self->moves[i];
-                 int r = m->from_sq/8; 
-                 int c = m->from_sq%8;
-                 PieceType pt = PIECE_PAWN;
-                 if (temp->board[r][c]) pt = temp->board[r][c]->type;
-                 
-                 char san[16];
-                 gamelogic_get_move_san(temp, m, san, sizeof(san));
-                 right_side_panel_add_move_notation(self->app_state->gui.right_side_panel, san, pt, m_num, p);
-                 gamelogic_perform_move(temp, m);
-                 
-                 if (p == PLAYER_BLACK) m_num++;
-                 p = (p == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
-             }
-             gamelogic_free(temp);
+        // Re-populate from logic history: its plies carry their SAN. Move
+        // numbers count back from the current one.
+        int m_num = self->logic->fullmoveNumber;
+        for (int i = 0; i < self->current_ply; i++) {
+            if (self->moves[i]->mover == PLAYER_BLACK) m_num--;
+        }
+        for (int i = 0; i < self->current_ply; i++) {
+            Move* m = self->moves[i];
+            char uci[16];
+            const char* san = gamelogic_get_san_at(self->logic, i);
+            if (!san) {
+                move_to_uci(m, uci);
+                san = uci;
+            }
+            right_side_panel_add_move_notation(self->app_state->gui.right_side_panel, san, (PieceType)m->movedPieceType, m_num, (Player)m->mover);
+            if (m->mover == PLAYER_BLACK) m_num++;
         }
         
         right_side_panel_scroll_to_bottom(self->app_state->gui.right_side_panel);
@@ -1304,16 +1218,12 @@ void replay_controller_analyze_match(ReplayController* self) {
     cfg.hash_size = 64; // Small default
     cfg.multipv = 3;
     
+    cfg.move_time_pass1 = 1000; // Default analysis time (ms)
     if (app_config->analysis_use_custom && strlen(app_config->custom_engine_path) > 0) {
         cfg.engine_path = app_config->custom_engine_path;
-        cfg.move_time_pass1 = 1000; // Default analysis time (ms)
     } else {
-        // Internal/Stockfish
-        // TODO: Is there a unified getter? For now assume standard path or config path
-        // Using "stockfish" or configured path for internal if available
-        // Ideally `ai_engine` knows the internal path.
-        // For now, let's try strict path or assume in path.
-        cfg.engine_path = "stockfish"; 
+        // In-process Stockfish, independent of the engine playing the game
+        cfg.engine_path = NULL;
     }
     
     // Override for high accuracy if requested, or just use config
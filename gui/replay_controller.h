@@ -51,11 +51,6 @@ typedef struct ReplayController {
     int64_t* precalc_white_time; // Array [total_moves+1]
     int64_t* precalc_black_time; // Array [total_moves+1]
 
-    // Snapshots for efficient replay navigation
-    PositionSnapshot* snapshots; // Contiguous array [0..total_moves]
-    int snapshot_count;
-    int snapshot_capacity;
-    
     // AI Analysis
     struct _AiAnalysisJob* analysis_job;
     struct GameAnalysisResult* analysis_result;
@@ -9,6 +9,8 @@
 #include "app_theme_dialog.h"
 #include "right_side_panel.h"
 #include "gui_utils.h"
+#include "gui_file_dialog.h"
+#include "epd_pool.h"
 
 struct _SettingsDialog {
     GtkWindow* window;
@@ -175,6 +177,27 @@ static void on_create_puzzle_clicked(GtkButton* btn, gpointer user_data) {
     }
 }
 
+static void on_epd_file_selected(const char* path, gpointer user_data) {
+    (void)user_data;
+    if (!path) return;
+    EpdPool* pool = epd_pool_load(path);
+    if (!pool) {
+        if (debug_mode) printf("[Settings] Could not read EPD file %s\n", path);
+        return;
+    }
+    int added = puzzles_add_from_epd(pool);
+    if (debug_mode) printf("[Settings] EPD %s: %d positions, %d skipped, %d puzzles added\n",
+                           path, epd_pool_count(pool), epd_pool_skipped(pool), added);
+    epd_pool_release(pool); // The puzzle list holds its own reference
+}
+
+static void on_load_epd_clicked(GtkButton* btn, gpointer user_data) {
+    (void)btn;
+    SettingsDialog* dialog = (SettingsDialog*)user_data;
+    const char* patterns[] = { "*.epd", "*.txt", NULL };
+    gui_file_dialog_open(dialog->window, "Load EPD Suite", "EPD Files", patterns, on_epd_file_selected, dialog);
+}
+
 static GtkWidget* create_puzzles_page(SettingsDialog* dialog); // Forward
 
 // Puzzle Page (Real Implementation)
@@ -224,6 +247,12 @@ static GtkWidget* create_puzzles_page(SettingsDialog* dialog) {
     gtk_widget_set_size_request(add_btn, -1, 36);
     g_signal_connect(add_btn, "clicked", G_CALLBACK(on_create_puzzle_clicked), dialog);
     gtk_box_append(GTK_BOX(add_box), add_btn);
+    
+    GtkWidget* epd_btn = gtk_button_new_with_label("Load EPD Suite");
+    gtk_widget_set_size_request(epd_btn, -1, 36);
+    gtk_widget_set_margin_start(epd_btn, 8);
+    g_signal_connect(epd_btn, "clicked", G_CALLBACK(on_load_epd_clicked), dialog);
+    gtk_box_append(GTK_BOX(add_box), epd_btn);
     gtk_box_append(GTK_BOX(vbox), add_box);
     
     gtk_box_append(GTK_BOX(vbox), gtk_separator_new(GTK_ORIENTATION_HORIZONTAL));
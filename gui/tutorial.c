@@ -2,7 +2,6 @@
 #include <stdio.h>
 #include "board_widget.h"
 #include "sound_engine.h"
-#include "piece.h"
 #include "gamelogic.h"
 #include "right_side_panel.h"
 #include "clock_widget.h"
@@ -154,14 +153,7 @@ static void tutorial_clear_board(AppState* state) {
     gamelogic_reset(state->logic);
     
     // Now perform full reset of board array (clear pieces placed by reset)
-    for (int r=0; r<8; r++) {
-        for (int c=0; c<8; c++) {
-            if (state->logic->board[r][c]) {
-                piece_free(state->logic->board[r][c]); // Free memory
-                state->logic->board[r][c] = NULL; 
-            }
-        }
-    }
+    gamelogic_clear_board(state->logic);
     // Clean reset of game logic state
     state->logic->turn = PLAYER_WHITE; 
     state->logic->isGameOver = FALSE;
@@ -198,9 +190,9 @@ void tutorial_reset_step(GtkButton* btn, gpointer user_data) {
 static void tutorial_setup_pawn(AppState* state) {
     tutorial_clear_board(state);
     state->tutorial.wait = FALSE; // Force clear
-    state->logic->board[6][3] = piece_create(PIECE_PAWN, PLAYER_WHITE);
+    gamelogic_place_piece(state->logic, 6, 3, PIECE_PAWN, PLAYER_WHITE);
     // Add Black King to prevent stalemate
-    state->logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(state->logic, 0, 0, PIECE_KING, PLAYER_BLACK);
     board_widget_set_nav_restricted(state->gui.board, true, 6, 3, 4, 3);
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state, 
@@ -210,8 +202,8 @@ static void tutorial_setup_pawn(AppState* state) {
 
 static void tutorial_setup_rook(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[4][4] = piece_create(PIECE_ROOK, PLAYER_WHITE); // e4
-    state->logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK); // a8
+    gamelogic_place_piece(state->logic, 4, 4, PIECE_ROOK, PLAYER_WHITE); // e4
+    gamelogic_place_piece(state->logic, 0, 0, PIECE_KING, PLAYER_BLACK); // a8
     board_widget_set_nav_restricted(state->gui.board, true, 4, 4, 0, 4); // e4 -> e8
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state,
@@ -221,8 +213,8 @@ static void tutorial_setup_rook(AppState* state) {
 
 static void tutorial_setup_bishop(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[7][2] = piece_create(PIECE_BISHOP, PLAYER_WHITE); // c1
-    state->logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK); // a8
+    gamelogic_place_piece(state->logic, 7, 2, PIECE_BISHOP, PLAYER_WHITE); // c1
+    gamelogic_place_piece(state->logic, 0, 0, PIECE_KING, PLAYER_BLACK); // a8
     board_widget_set_nav_restricted(state->gui.board, true, 7, 2, 2, 7); // c1 -> h6
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state,
@@ -232,8 +224,8 @@ static void tutorial_setup_bishop(AppState* state) {
 
 static void tutorial_setup_knight(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[7][1] = piece_create(PIECE_KNIGHT, PLAYER_WHITE); // b1
-    state->logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK); // a8
+    gamelogic_place_piece(state->logic, 7, 1, PIECE_KNIGHT, PLAYER_WHITE); // b1
+    gamelogic_place_piece(state->logic, 0, 0, PIECE_KING, PLAYER_BLACK); // a8
     board_widget_set_nav_restricted(state->gui.board, true, 7, 1, 5, 2); // b1 -> c3
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state,
@@ -243,8 +235,8 @@ static void tutorial_setup_knight(AppState* state) {
 
 static void tutorial_setup_queen(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[7][3] = piece_create(PIECE_QUEEN, PLAYER_WHITE); // d1
-    state->logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK); // a8
+    gamelogic_place_piece(state->logic, 7, 3, PIECE_QUEEN, PLAYER_WHITE); // d1
+    gamelogic_place_piece(state->logic, 0, 0, PIECE_KING, PLAYER_BLACK); // a8
     board_widget_set_nav_restricted(state->gui.board, true, 7, 3, 3, 7); // d1 -> h5
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state,
@@ -254,9 +246,9 @@ static void tutorial_setup_queen(AppState* state) {
 
 static void tutorial_setup_check(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[7][7] = piece_create(PIECE_ROOK, PLAYER_WHITE); // h1
-    state->logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK); // e8
-    state->logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE); // e1
+    gamelogic_place_piece(state->logic, 7, 7, PIECE_ROOK, PLAYER_WHITE); // h1
+    gamelogic_place_piece(state->logic, 0, 4, PIECE_KING, PLAYER_BLACK); // e8
+    gamelogic_place_piece(state->logic, 7, 4, PIECE_KING, PLAYER_WHITE); // e1
     board_widget_set_nav_restricted(state->gui.board, true, 7, 7, 0, 7); // h1 -> h8
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state,
@@ -266,8 +258,8 @@ static void tutorial_setup_check(AppState* state) {
 
 static void tutorial_setup_escape(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE); // e1
-    state->logic->board[0][4] = piece_create(PIECE_ROOK, PLAYER_BLACK); // e8
+    gamelogic_place_piece(state->logic, 7, 4, PIECE_KING, PLAYER_WHITE); // e1
+    gamelogic_place_piece(state->logic, 0, 4, PIECE_ROOK, PLAYER_BLACK); // e8
     state->logic->turn = PLAYER_WHITE; 
     board_widget_set_nav_restricted(state->gui.board, true, 7, 4, 7, 5); // e1 -> f1
     board_widget_set_nav_restricted(state->gui.board, true, 7, 4, 7, 5); // e1 -> f1
@@ -279,9 +271,9 @@ static void tutorial_setup_escape(AppState* state) {
 
 static void tutorial_setup_castling(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE); // e1
-    state->logic->board[7][7] = piece_create(PIECE_ROOK, PLAYER_WHITE); // h1
-    state->logic->board[0][4] = piece_create(PIECE_KING, PLAYER_BLACK);
+    gamelogic_place_piece(state->logic, 7, 4, PIECE_KING, PLAYER_WHITE); // e1
+    gamelogic_place_piece(state->logic, 7, 7, PIECE_ROOK, PLAYER_WHITE); // h1
+    gamelogic_place_piece(state->logic, 0, 4, PIECE_KING, PLAYER_BLACK);
     board_widget_set_nav_restricted(state->gui.board, true, 7, 4, 7, 6); // e1 -> g1
     board_widget_refresh(state->gui.board);
     tutorial_update_view(state,
@@ -291,12 +283,12 @@ static void tutorial_setup_castling(AppState* state) {
 
 static void tutorial_setup_mate(AppState* state) {
     tutorial_clear_board(state);
-    state->logic->board[0][0] = piece_create(PIECE_KING, PLAYER_BLACK); // a8
-    state->logic->board[1][0] = piece_create(PIECE_PAWN, PLAYER_BLACK); // a7
-    state->logic->board[1][1] = piece_create(PIECE_PAWN, PLAYER_BLACK); // b7
-    state->logic->board[2][0] = piece_create(PIECE_PAWN, PLAYER_BLACK); // a6
-    state->logic->board[7][3] = piece_create(PIECE_ROOK, PLAYER_WHITE); // d1
-    state->logic->board[7][4] = piece_create(PIECE_KING, PLAYER_WHITE); // e1
+    gamelogic_place_piece(state->logic, 0, 0, PIECE_KING, PLAYER_BLACK); // a8
+    gamelogic_place_piece(state->logic, 1, 0, PIECE_PAWN, PLAYER_BLACK); // a7
+    gamelogic_place_piece(state->logic, 1, 1, PIECE_PAWN, PLAYER_BLACK); // b7
+    gamelogic_place_piece(state->logic, 2, 0, PIECE_PAWN, PLAYER_BLACK); // a6
+    gamelogic_place_piece(state->logic, 7, 3, PIECE_ROOK, PLAYER_WHITE); // d1
+    gamelogic_place_piece(state->logic, 7, 4, PIECE_KING, PLAYER_WHITE); // e1
     state->logic->turn = PLAYER_WHITE;
     board_widget_set_nav_restricted(state->gui.board, true, 7, 3, 0, 3); // d1 -> d8
     board_widget_refresh(state->gui.board);
@@ -481,7 +473,7 @@ void tutorial_check_progress(AppState* state) {
 
     if (state->tutorial.step == TUT_PAWN) {
         // d2->d4 (6,3 -> 4,3)
-        Piece* p = state->logic->board[4][3];
+        const Piece* p = gamelogic_get_piece(state->logic, 4, 3);
         if (debug_mode) printf("[Tutorial] Checking PAWN success. Slot [4][3] = %p\n", (void*)p);
         if (p) if (debug_mode) printf("[Tutorial] Piece type=%d owner=%d\n", p->type, p->owner);
         
@@ -495,7 +487,7 @@ void tutorial_check_progress(AppState* state) {
         }
     } else if (state->tutorial.step == TUT_ROOK) {
         // e4->e8 (4,4 -> 0,4)
-        Piece* p = state->logic->board[0][4];
+        const Piece* p = gamelogic_get_piece(state->logic, 0, 4);
         if (p && p->type == PIECE_ROOK && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -504,7 +496,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_BISHOP) {
-        Piece* p = state->logic->board[2][7];
+        const Piece* p = gamelogic_get_piece(state->logic, 2, 7);
         if (p && p->type == PIECE_BISHOP && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -513,7 +505,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_KNIGHT) {
-        Piece* p = state->logic->board[5][2];
+        const Piece* p = gamelogic_get_piece(state->logic, 5, 2);
         if (p && p->type == PIECE_KNIGHT && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -522,7 +514,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_QUEEN) {
-        Piece* p = state->logic->board[3][7];
+        const Piece* p = gamelogic_get_piece(state->logic, 3, 7);
         if (p && p->type == PIECE_QUEEN && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -531,7 +523,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_CHECK) {
-        Piece* p = state->logic->board[0][7];
+        const Piece* p = gamelogic_get_piece(state->logic, 0, 7);
         if (p && p->type == PIECE_ROOK && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -540,7 +532,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_ESCAPE) {
-        Piece* p = state->logic->board[7][5];
+        const Piece* p = gamelogic_get_piece(state->logic, 7, 5);
         if (p && p->type == PIECE_KING && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -549,7 +541,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_CASTLING) {
-        Piece* p = state->logic->board[7][6];
+        const Piece* p = gamelogic_get_piece(state->logic, 7, 6);
         if (p && p->type == PIECE_KING && p->owner == PLAYER_WHITE) {
             state->tutorial.wait = TRUE;
             board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -558,7 +550,7 @@ void tutorial_check_progress(AppState* state) {
             g_timeout_add(delay, on_tutorial_delay_complete, state);
         }
     } else if (state->tutorial.step == TUT_MATE) {
-        Piece* p = state->logic->board[0][3]; 
+        const Piece* p = gamelogic_get_piece(state->logic, 0, 3); 
         if (p && p->type == PIECE_ROOK && p->owner == PLAYER_WHITE) {
              state->tutorial.wait = TRUE;
              board_widget_set_nav_restricted(state->gui.board, true, -1, -1, -1, -1);
@@ -191,19 +191,40 @@ void Engine::set_on_verify_networks(std::function<void(std::string_view)>&& f) {
 void Engine::wait_for_search_finished() { threads.main_thread()->wait_for_search_finished(); }
 
 void Engine::set_position(const std::string& fen, const std::vector<std::string>& moves) {
-    // Drop the old state and create a new one
-    states = StateListPtr(new std::deque<StateInfo>(1));
-    pos.set(fen, options["UCI_Chess960"], &states->back());
+    bool   chess960 = options["UCI_Chess960"];
+    size_t played   = positionMoves.size();
 
-    for (const auto& move : moves)
+    // Same game, further on: keep the states (the history the search sees)
+    // and play only the new moves
+    bool extends = fen == positionFen && chess960 == positionChess960 && moves.size() >= played
+                && std::equal(positionMoves.begin(), positionMoves.end(), moves.begin());
+
+    // go() handed the states to the thread pool
+    if (extends && !states)
+        states = threads.take_setup_states();
+
+    if (!extends || !states)
+    {
+        // Drop the old state and create a new one
+        states = StateListPtr(new std::deque<StateInfo>(1));
+        pos.set(fen, chess960, &states->back());
+
+        positionFen      = fen;
+        positionChess960 = chess960;
+        positionMoves.clear();
+        played = 0;
+    }
+
+    for (size_t i = played; i < moves.size(); ++i)
     {
-        auto m = UCIEngine::to_move(pos, move);
+        auto m = UCIEngine::to_move(pos, moves[i]);
 
         if (m == Move::none())
             break;
 
         states->emplace_back();
         pos.do_move(m, states->back());
+        positionMoves.push_back(moves[i]);
     }
 }
 
@@ -303,7 +324,10 @@ OptionsMap&       Engine::get_options() { return options; }
 
 std::string Engine::fen() const { return pos.fen(); }
 
-void Engine::flip() { pos.flip(); }
+void Engine::flip() {
+    pos.flip();
+    positionFen.clear();  // No longer the position of any move list
+}
 
 std::string Engine::visualize() const {
     std::stringstream ss;
@@ -64,7 +64,8 @@ class Engine {
 
     // blocking call to wait for search to finish
     void wait_for_search_finished();
-    // set a new position, moves are in UCI format
+    // set a new position, moves are in UCI format. When fen matches the last
+    // call and moves extend its list, only the new moves are played.
     void set_position(const std::string& fen, const std::vector<std::string>& moves);
 
     // modifiers
@@ -115,6 +116,11 @@ class Engine {
     Position     pos;
     StateListPtr states;
 
+    // The line pos was set up from, for incremental set_position()
+    std::string              positionFen;
+    bool                     positionChess960 = false;
+    std::vector<std::string> positionMoves;
+
     OptionsMap                               options;
     ThreadPool                               threads;
     TranspositionTable                       tt;
@@ -150,6 +150,9 @@ class ThreadPool {
 
     void ensure_network_replicated();
 
+    // Hands back the states start_thinking() took over, once no search runs
+    StateListPtr take_setup_states() { return std::move(setupStates); }
+
     std::atomic_bool stop, abortedSearch, increaseDepth;
 
     auto cbegin() const noexcept { return threads.cbegin(); }